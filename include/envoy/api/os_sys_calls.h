@@ -59,6 +59,17 @@ public:
    */
   virtual SysCallSizeResult recvmsg(int sockfd, struct msghdr* msg, int flags) PURE;
 
+  /**
+   * @see recvmmsg (man 2 recvmmsg)
+   */
+  virtual SysCallIntResult recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                    int flags, struct timespec* timeout) PURE;
+
+  /**
+   * return true if the OS supports recvmmsg().
+   */
+  virtual bool supportsMmsg() const PURE;
+
   /**
    * Release all resources allocated for fd.
    * @return zero on success, -1 returned otherwise.
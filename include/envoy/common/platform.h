@@ -18,3 +18,18 @@ using ssize_t = int64_t;
 #define PACKED_STRUCT(definition, ...) definition, ##__VA_ARGS__ __attribute__((packed))
 
 #endif
+
+#if !defined(_MSC_VER) && !defined(__linux__)
+#include <sys/socket.h>
+
+// recvmmsg() is only available on Linux. Other platforms get the message header definition so
+// that the batched receive code compiles; they report recvmmsg() as unsupported at runtime.
+struct mmsghdr {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+};
+
+#ifndef MSG_WAITFORONE
+#define MSG_WAITFORONE 0x10000
+#endif
+#endif
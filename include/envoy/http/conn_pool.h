@@ -104,6 +104,13 @@ public:
    */
   virtual bool hasActiveConnections() const PURE;
 
+  /**
+   * Determines whether a new request would use a connection that the pool already has open or is
+   * establishing, rather than a new connection.
+   * @return true if the connection pool has such a connection.
+   */
+  virtual bool hasUsableConnection() const PURE;
+
   /**
    * Create a new stream on the pool.
    * @param response_decoder supplies the decoder events to fire when the response is
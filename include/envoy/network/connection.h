@@ -196,6 +196,32 @@ public:
    */
   virtual absl::optional<UnixDomainSocketPeerCredentials> unixSocketPeerCredentials() const PURE;
 
+  /**
+   * @return the IoHandle of the socket backing the connection. It remains owned by the
+   *         connection and must not be closed, and must only be read from or written to after
+   *         takeOverSocketEvents().
+   */
+  virtual const IoHandle& ioHandle() const PURE;
+
+  /**
+   * Callback for the socket events of a connection. @see takeOverSocketEvents().
+   */
+  using SocketEventCb = std::function<void(uint32_t events)>;
+
+  /**
+   * Stop moving data through the connection's buffers and filter chain, and hand the socket
+   * events to a callback which reads from and writes to ioHandle() directly instead, e.g. to
+   * splice() between two sockets. The connection keeps owning the socket: close() still closes
+   * it, close events are still raised, and no read events are passed on while the connection is
+   * read disabled. write() must not be called afterwards. The callback is invoked once from the
+   * event loop even without socket activity, so that the data moved out can be sent.
+   * @param cb supplies the callback for socket events.
+   * @param read_data receives the data that has been read but not consumed by the read filters.
+   * @param write_data receives the data that has been written but not yet sent.
+   */
+  virtual void takeOverSocketEvents(SocketEventCb cb, Buffer::Instance& read_data,
+                                    Buffer::Instance& write_data) PURE;
+
   /**
    * @return the local address of the connection. For client connections, this is the origin
    * address. For server connections, this is the local destination address. For server connections
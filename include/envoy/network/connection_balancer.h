@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/pure.h"
+#include "envoy/network/listen_socket.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * A connection handler that is balanced. Typically implemented by individual listeners depending
+ * on their balancing configuration.
+ */
+class BalancedConnectionHandler {
+public:
+  virtual ~BalancedConnectionHandler() = default;
+
+  /**
+   * @return the number of active connections within the handler, including connections that have
+   *         been assigned to the handler by a balancer but have not been processed yet.
+   */
+  virtual uint64_t numConnections() const PURE;
+
+  /**
+   * Increment the number of connections within the handler. This must be called by a connection
+   * balancer implementation when a handler is picked via balanceConnection(). This makes sure that
+   * connection counts are accurate during connection transfer (i.e., that the target handler
+   * accounts for the incoming connection before it has been processed). This is done by the
+   * balancer vs. the connection handler to account for different locking needs inside the
+   * balancer.
+   */
+  virtual void incNumConnections() PURE;
+
+  /**
+   * Post a connected socket to this connection handler. This is used for cross-thread connection
+   * transfer during the balancing process. The socket is processed on the handler's own dispatcher
+   * as if it had been accepted there.
+   * @param socket supplies the accepted socket that is moved into the handler.
+   */
+  virtual void post(ConnectionSocketPtr&& socket) PURE;
+};
+
+/**
+ * An implementation of a connection balancer. This abstracts the underlying policy (e.g., exact,
+ * fuzzy, etc.). A balancer is shared by the handlers of a single listener on all workers.
+ */
+class ConnectionBalancer {
+public:
+  virtual ~ConnectionBalancer() = default;
+
+  /**
+   * Register a new handler with the balancer that is available for balancing.
+   * @param handler supplies the handler to register. The handler must outlive its registration.
+   */
+  virtual void registerHandler(BalancedConnectionHandler& handler) PURE;
+
+  /**
+   * Unregister a handler with the balancer that is no longer available for balancing.
+   * @param handler supplies the handler to unregister.
+   */
+  virtual void unregisterHandler(BalancedConnectionHandler& handler) PURE;
+
+  /**
+   * Pick a target handler for a newly accepted connection. If the picked handler is not the
+   * current one, the socket is transferred to it via BalancedConnectionHandler::post() while the
+   * handler is still known to be registered.
+   * @param current_handler supplies the currently executing connection handler.
+   * @param socket supplies the accepted socket. It is moved out of only if the connection was
+   *        transferred to a different handler.
+   * @return bool true if the connection was transferred to a different handler, false if it should
+   *         stay bound to the current handler.
+   *
+   * NOTE: It is the responsibility of the balancer to call incNumConnections() on the picked
+   *       handler. See the comments above for more explanation.
+   */
+  virtual bool balanceConnection(BalancedConnectionHandler& current_handler,
+                                 ConnectionSocketPtr& socket) PURE;
+};
+
+using ConnectionBalancerPtr = std::unique_ptr<ConnectionBalancer>;
+
+} // namespace Network
+} // namespace Envoy
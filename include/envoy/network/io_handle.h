@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "envoy/api/io_error.h"
 #include "envoy/common/pure.h"
 
@@ -95,7 +98,7 @@ public:
     uint32_t* dropped_packets_;
     // The destination address from transport header.
     std::shared_ptr<const Address::Instance> local_address_;
-    // The the source address from transport header.
+    // The source address from transport header.
     std::shared_ptr<const Address::Instance> peer_address_;
   };
 
@@ -112,6 +115,49 @@ public:
    */
   virtual Api::IoCallUint64Result recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
                                           uint32_t self_port, RecvMsgOutput& output) PURE;
+
+  struct RecvMmsgOutput {
+    /*
+     * @param num_packets the maximum number of packets a single recvmmsg() may receive.
+     * @param dropped_packets has the same meaning as in RecvMsgOutput.
+     */
+    RecvMmsgOutput(uint64_t num_packets, uint32_t* dropped_packets)
+        : dropped_packets_(dropped_packets), packets_(num_packets) {}
+
+    struct PacketInfo {
+      // The destination address from transport header.
+      std::shared_ptr<const Address::Instance> local_address_;
+      // The source address from transport header.
+      std::shared_ptr<const Address::Instance> peer_address_;
+      // The number of bytes received into the slice of this packet.
+      uint64_t msg_len_{0};
+    };
+
+    // If not nullptr, its value is the total number of packets dropped. recvmmsg() will update it
+    // when more packets are dropped.
+    uint32_t* dropped_packets_;
+    // One entry per slice passed to recvmmsg(). Only the first rc_ entries are filled in.
+    std::vector<PacketInfo> packets_;
+  };
+
+  /**
+   * Receive multiple messages with a single system call, one message per slice.
+   * @param slices points to the location of receiving buffers, one per message.
+   * @param num_packets indicates the number of slices |slices| contains. It must not be larger
+   * than the number of entries in |output|.
+   * @param self_port the port this handle is assigned to. This is used to populate
+   * local_address because local port can't be retrieved from control message.
+   * @param output modified upon each call to return fields requested in it.
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance or
+   * err_ = nullptr and rc_ = the number of messages received for success.
+   */
+  virtual Api::IoCallUint64Result recvmmsg(Buffer::RawSlice* slices, uint64_t num_packets,
+                                           uint32_t self_port, RecvMmsgOutput& output) PURE;
+
+  /**
+   * return true if the platform supports recvmmsg().
+   */
+  virtual bool supportsMmsg() const PURE;
 };
 
 using IoHandlePtr = std::unique_ptr<IoHandle>;
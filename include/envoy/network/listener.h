@@ -7,6 +7,7 @@
 #include "envoy/api/io_error.h"
 #include "envoy/common/exception.h"
 #include "envoy/network/connection.h"
+#include "envoy/network/connection_balancer.h"
 #include "envoy/network/listen_socket.h"
 #include "envoy/stats/scope.h"
 
@@ -42,6 +43,15 @@ public:
   virtual Socket& socket() PURE;
   virtual const Socket& socket() const PURE;
 
+  /**
+   * @param worker_index supplies the index of the worker that is about to start listening.
+   * @return Socket& the listen socket the given worker should accept connections on. Unless the
+   *         listener is configured with reuse_port this is always socket(). Otherwise every worker
+   *         gets its own socket bound to the same address with SO_REUSEPORT, so that the kernel
+   *         distributes new connections across workers.
+   */
+  virtual Socket& listenSocket(uint32_t worker_index) PURE;
+
   /**
    * @return bool specifies whether the listener should actually listen on the port.
    *         A listener that doesn't listen on a port can only receive connections
@@ -97,6 +107,12 @@ public:
    * nullptr.
    */
   virtual const ActiveUdpListenerFactory* udpListenerFactory() PURE;
+
+  /**
+   * @return the connection balancer for this listener. All workers accepting on the listener share
+   *         the same balancer.
+   */
+  virtual ConnectionBalancer& connectionBalancer() PURE;
 };
 
 /**
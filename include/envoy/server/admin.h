@@ -39,6 +39,13 @@ public:
    */
   virtual Http::StreamDecoderFilterCallbacks& getDecoderFilterCallbacks() const PURE;
 
+  /**
+   * @return bool whether the response can be streamed after the handler returns. This is false
+   * for requests made with Admin::request(), which have no downstream stream, so handlers must
+   * then write the whole response to the buffer they are given.
+   */
+  virtual bool canStreamResponse() const PURE;
+
   /**
    * @return const Buffer::Instance* the fully buffered admin request if applicable.
    */
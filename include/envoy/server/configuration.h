@@ -46,6 +46,12 @@ public:
    */
   virtual std::chrono::milliseconds statsFlushInterval() const PURE;
 
+  /**
+   * @return bool whether flushes to stat sinks only include the metrics that changed since the
+   *         previous flush.
+   */
+  virtual bool statsFlushChangedOnly() const PURE;
+
   /**
    * @return std::chrono::milliseconds the time interval after which we count a nonresponsive thread
    *         event as a "miss" statistic.
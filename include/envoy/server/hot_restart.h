@@ -40,9 +40,12 @@ public:
    * Retrieve a listening socket on the specified address from the parent process. The socket will
    * be duplicated across process boundaries.
    * @param address supplies the address of the socket to duplicate, e.g. tcp://127.0.0.1:5000.
+   * @param worker_index supplies the index of the worker whose socket should be duplicated. This
+   *        is only meaningful for listeners that use a socket per worker (reuse_port), all other
+   *        listeners share the socket of worker 0.
    * @return int the fd or -1 if there is no bound listen port in the parent.
    */
-  virtual int duplicateParentListenSocket(const std::string& address) PURE;
+  virtual int duplicateParentListenSocket(const std::string& address, uint32_t worker_index) PURE;
 
   /**
    * Initialize the parent logic of our restarter. Meant to be called after initialization of a
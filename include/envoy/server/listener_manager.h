@@ -54,6 +54,20 @@ public:
                      Network::Address::SocketType socket_type,
                      const Network::Socket::OptionsSharedPtr& options, bool bind_to_port) PURE;
 
+  /**
+   * Creates an additional stream socket for a listener that uses a socket per worker
+   * (reuse_port). The socket of the first worker is always created via createListenSocket().
+   * @param address supplies the socket's address. This must be the address the socket of the first
+   *        worker is bound to, so that a configured port zero has already been resolved.
+   * @param options to be set on the created socket just before calling 'bind()'.
+   * @param worker_index supplies the index of the worker the socket is created for.
+   * @return Network::SocketSharedPtr an initialized and bound socket.
+   */
+  virtual Network::SocketSharedPtr
+  createWorkerListenSocket(Network::Address::InstanceConstSharedPtr address,
+                           const Network::Socket::OptionsSharedPtr& options,
+                           uint32_t worker_index) PURE;
+
   /**
    * Creates a list of filter factories.
    * @param filters supplies the proto configuration.
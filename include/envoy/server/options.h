@@ -189,6 +189,22 @@ public:
    */
   virtual bool fakeSymbolTableEnabled() const PURE;
 
+  /**
+   * @return the number of shards each counter is split into, or 0 if counters are not sharded.
+   */
+  virtual uint32_t statsCounterShards() const PURE;
+
+  /**
+   * @return the number of shards the stats symbol table is split into.
+   */
+  virtual uint32_t statsSymbolTableShards() const PURE;
+
+  /**
+   * @return bool indicating whether the histograms of each thread record values without locking,
+   *         so that merging them does not need a post to every thread.
+   */
+  virtual bool statsLockFreeHistograms() const PURE;
+
   /**
    * @return bool indicating whether cpuset size should determine the number of worker threads.
    */
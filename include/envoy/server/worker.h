@@ -91,11 +91,12 @@ public:
   virtual ~WorkerFactory() = default;
 
   /**
+   * @param index supplies the index of the worker, used to select per-worker listen sockets.
    * @param overload_manager supplies the server's overload manager.
    * @param worker_name supplies the name of the worker, used for per-worker stats.
    * @return WorkerPtr a new worker.
    */
-  virtual WorkerPtr createWorker(OverloadManager& overload_manager,
+  virtual WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
                                  const std::string& worker_name) PURE;
 };
 
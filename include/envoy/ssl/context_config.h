@@ -58,6 +58,12 @@ public:
    */
   virtual unsigned maxProtocolVersion() const PURE;
 
+  /**
+   * @return true if record encryption for writes should be handed to the kernel after the
+   * handshake, when the negotiated session allows it.
+   */
+  virtual bool kernelTlsTxOffload() const PURE;
+
   /**
    * @return true if the ContextConfig is able to provide secrets to create SSL context,
    * and false if dynamic secrets are expected but are not downloaded from SDS server yet.
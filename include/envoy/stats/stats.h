@@ -98,11 +98,13 @@ public:
    * Flags:
    * Used: used by all stats types to figure out whether they have been used.
    * Logic...: used by gauges to cache how they should be combined with a parent's value.
+   * Changed: used by gauges to track whether their value changed since the last flush.
    */
   struct Flags {
     static const uint8_t Used = 0x01;
     static const uint8_t LogicAccumulate = 0x02;
     static const uint8_t NeverImport = 0x04;
+    static const uint8_t Changed = 0x08;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
@@ -161,6 +163,14 @@ public:
    * @param import_mode the new import mode.
    */
   virtual void mergeImportMode(ImportMode import_mode) PURE;
+
+  /**
+   * Returns whether the value of the gauge changed since the previous call, or since the gauge was
+   * created for the first call, and clears that state. This is used to flush only the gauges that
+   * changed to stats sinks.
+   * @return bool whether the value changed.
+   */
+  virtual bool latchChanged() PURE;
 };
 
 using GaugeSharedPtr = RefcountPtr<Gauge>;
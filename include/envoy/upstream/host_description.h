@@ -7,6 +7,7 @@
 #include "envoy/network/address.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/upstream/health_check_host_monitor.h"
+#include "envoy/upstream/latency_host_monitor.h"
 #include "envoy/upstream/outlier_detection.h"
 
 namespace Envoy {
@@ -27,6 +28,7 @@ namespace Upstream {
   COUNTER(rq_timeout)                                                                              \
   COUNTER(rq_total)                                                                                \
   GAUGE(cx_active, Accumulate)                                                                     \
+  GAUGE(cx_http2_active, Accumulate)                                                               \
   GAUGE(rq_active, Accumulate)
 
 /**
@@ -80,6 +82,11 @@ public:
    */
   virtual HealthCheckHostMonitor& healthChecker() const PURE;
 
+  /**
+   * @return the host's latency monitor.
+   */
+  virtual LatencyHostMonitor& latencyMonitor() const PURE;
+
   /**
    * @return the hostname associated with the host if any.
    * Empty string "" indicates that hostname is not a DNS name.
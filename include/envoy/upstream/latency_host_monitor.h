@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "envoy/common/pure.h"
+#include "envoy/common/time.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * A monitor for the latency of a host, fed with the response times of the requests sent to it and
+ * read by latency aware load balancers. It is used from every thread, so implementations must be
+ * thread safe.
+ */
+class LatencyHostMonitor {
+public:
+  virtual ~LatencyHostMonitor() = default;
+
+  /**
+   * Record the response time of a request.
+   * @param response_time supplies the time between the request being sent and its response being
+   *        complete.
+   * @param now supplies the current monotonic time.
+   */
+  virtual void putResponseTime(std::chrono::microseconds response_time, MonotonicTime now) PURE;
+
+  /**
+   * Record a request that failed without a complete response, such as a connection failure, a
+   * reset or a timeout.
+   * @param elapsed supplies the time between the request being sent, if it was, and its failure.
+   * @param now supplies the current monotonic time.
+   */
+  virtual void putFailure(std::chrono::microseconds elapsed, MonotonicTime now) PURE;
+
+  /**
+   * @param now supplies the current monotonic time.
+   * @return the estimated latency of the host in microseconds.
+   */
+  virtual double latencyEstimate(MonotonicTime now) PURE;
+};
+
+using LatencyHostMonitorPtr = std::unique_ptr<LatencyHostMonitor>;
+
+} // namespace Upstream
+} // namespace Envoy
@@ -541,6 +541,8 @@ public:
   COUNTER(upstream_cx_destroy_remote_with_active_rq)                                               \
   COUNTER(upstream_cx_destroy_with_active_rq)                                                      \
   COUNTER(upstream_cx_http1_total)                                                                 \
+  COUNTER(upstream_cx_http2_per_host_overflow)                                                     \
+  COUNTER(upstream_cx_http2_per_host_reselect)                                                     \
   COUNTER(upstream_cx_http2_total)                                                                 \
   COUNTER(upstream_cx_idle_timeout)                                                                \
   COUNTER(upstream_cx_max_requests)                                                                \
@@ -549,6 +551,7 @@ public:
   COUNTER(upstream_cx_pool_overflow)                                                               \
   COUNTER(upstream_cx_protocol_error)                                                              \
   COUNTER(upstream_cx_rx_bytes_total)                                                              \
+  COUNTER(upstream_cx_spare_total)                                                                 \
   COUNTER(upstream_cx_total)                                                                       \
   COUNTER(upstream_cx_tx_bytes_total)                                                              \
   COUNTER(upstream_flow_control_backed_up_total)                                                   \
@@ -679,6 +682,12 @@ public:
    */
   virtual const absl::optional<std::chrono::milliseconds> idleTimeout() const PURE;
 
+  /**
+   * @return the soft limit on HTTP/2 connections to a single host of this cluster, counted across
+   *         all workers.
+   */
+  virtual const absl::optional<uint32_t> maxHttp2ConnectionsPerHost() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -735,6 +744,12 @@ public:
   virtual const absl::optional<envoy::api::v2::Cluster::LeastRequestLbConfig>&
   lbLeastRequestConfig() const PURE;
 
+  /**
+   * @return configuration for peak EWMA load balancing, only used if LB type is peak EWMA.
+   */
+  virtual const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>&
+  lbPeakEwmaConfig() const PURE;
+
   /**
    * @return configuration for ring hash load balancing, only used if type is set to ring_hash_lb.
    */
@@ -781,6 +796,17 @@ public:
    */
   virtual Network::TransportSocketFactory& transportSocketFactory() const PURE;
 
+  /**
+   * @return the number of idle connections that a connection pool keeps open ahead of requests,
+   *         in addition to the connections in use. 0 indicates no spare connections.
+   */
+  virtual uint32_t spareConnectionsPerHost() const PURE;
+
+  /**
+   * @return the connection pool that every worker creates for each healthy host ahead of requests.
+   */
+  virtual envoy::api::v2::Cluster::PoolWarming poolWarming() const PURE;
+
   /**
    * @return ClusterStats& strongly named stats for this cluster.
    */
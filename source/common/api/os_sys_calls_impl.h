@@ -18,6 +18,9 @@ public:
   SysCallSizeResult recvfrom(int sockfd, void* buffer, size_t length, int flags,
                              struct sockaddr* addr, socklen_t* addrlen) override;
   SysCallSizeResult recvmsg(int sockfd, struct msghdr* msg, int flags) override;
+  SysCallIntResult recvmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags,
+                            struct timespec* timeout) override;
+  bool supportsMmsg() const override;
   SysCallIntResult close(int fd) override;
   SysCallIntResult ftruncate(int fd, off_t length) override;
   SysCallPtrResult mmap(void* addr, size_t length, int prot, int flags, int fd,
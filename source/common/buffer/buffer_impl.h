@@ -12,6 +12,7 @@
 #include "common/common/non_copyable.h"
 #include "common/common/utility.h"
 #include "common/event/libevent.h"
+#include "common/memory/block_cache.h"
 
 namespace Envoy {
 namespace Buffer {
@@ -221,18 +222,28 @@ public:
     return slice;
   }
 
+  // Slices are allocated through Memory::BlockCache so that freed slices of the common sizes are
+  // reused by the next slice created on the same thread.
+  static void operator delete(void* address) { Memory::BlockCache::release(address); }
+
 private:
   OwnedSlice(uint64_t size) : Slice(0, 0, size) { base_ = storage_; }
 
+  static void* operator new(size_t object_size, size_t data_size_bytes) {
+    return Memory::BlockCache::allocate(object_size + data_size_bytes);
+  }
+
   /**
    * Compute a slice size big enough to hold a specified amount of data.
    * @param data_size the minimum amount of data the slice must be able to store, in bytes.
-   * @return a recommended slice size, in bytes.
+   * @return a recommended slice size, in bytes. The slice and its block header fill a whole
+   *         number of pages.
    */
   static uint64_t sliceSize(uint64_t data_size) {
-    static constexpr uint64_t PageSize = 4096;
-    const uint64_t num_pages = (sizeof(OwnedSlice) + data_size + PageSize - 1) / PageSize;
-    return num_pages * PageSize - sizeof(OwnedSlice);
+    static constexpr uint64_t PageSize = Memory::BlockCache::PageSize;
+    static constexpr uint64_t Overhead = sizeof(OwnedSlice) + Memory::BlockCache::HeaderSize;
+    const uint64_t num_pages = (Overhead + data_size + PageSize - 1) / PageSize;
+    return num_pages * PageSize - Overhead;
   }
 
   uint8_t storage_[];
@@ -10,6 +10,11 @@ void WatermarkBuffer::add(const void* data, uint64_t size) {
   checkHighWatermark();
 }
 
+void WatermarkBuffer::addBufferFragment(BufferFragment& fragment) {
+  OwnedImpl::addBufferFragment(fragment);
+  checkHighWatermark();
+}
+
 void WatermarkBuffer::add(absl::string_view data) {
   OwnedImpl::add(data);
   checkHighWatermark();
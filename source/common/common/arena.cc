@@ -0,0 +1,40 @@
+#include "common/common/arena.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+
+namespace {
+
+// Size of the heap blocks, unless a single allocation needs more.
+constexpr size_t BlockBytes = 4096;
+
+} // namespace
+
+void* MonotonicArena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment <= alignof(std::max_align_t) && (alignment & (alignment - 1)) == 0);
+  size_t padding = -reinterpret_cast<uintptr_t>(current_) & (alignment - 1);
+  if (padding + size > static_cast<size_t>(end_ - current_)) {
+    newBlock(size);
+    padding = 0;
+  }
+
+  char* result = current_ + padding;
+  current_ = result + size;
+  allocations_++;
+  bytes_ += padding + size;
+  return result;
+}
+
+void MonotonicArena::newBlock(size_t size) {
+  // Whatever is left of the current block is abandoned. operator new[] returns memory aligned for
+  // any fundamental type, so a new block never needs padding.
+  const size_t block_size = std::max(size, BlockBytes);
+  blocks_.emplace_back(new char[block_size]);
+  current_ = blocks_.back().get();
+  end_ = current_ + block_size;
+}
+
+} // namespace Envoy
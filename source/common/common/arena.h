@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * Bump allocator for objects that all die together. Memory is handed out from heap blocks, and is
+ * only released when the arena is destroyed. The arena does not run destructors: objects placed in
+ * it are still destroyed by their owners, their memory just isn't returned until the arena goes
+ * away. Not thread-safe.
+ */
+class MonotonicArena : NonCopyable {
+public:
+  MonotonicArena() = default;
+
+  /**
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the alignment of the returned memory, a power of two no larger than
+   *        alignof(std::max_align_t).
+   * @return void* the allocated memory, valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @return uint64_t the number of allocations made from the arena.
+   */
+  uint64_t allocations() const { return allocations_; }
+
+  /**
+   * @return uint64_t the number of bytes handed out by the arena, including alignment padding.
+   */
+  uint64_t bytes() const { return bytes_; }
+
+  /**
+   * @param size supplies the size of an allocation with the default alignment.
+   * @return the number of bytes that the allocation takes up in the arena.
+   */
+  static constexpr size_t footprint(size_t size) {
+    return (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  }
+
+protected:
+  /**
+   * @param block supplies memory aligned to alignof(std::max_align_t) that is used before any
+   *        heap block. It must outlive the arena.
+   * @param size supplies the size of the block.
+   */
+  MonotonicArena(char* block, size_t size) : current_(block), end_(block + size) {}
+
+private:
+  void newBlock(size_t size);
+
+  char* current_{};
+  char* end_{};
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  uint64_t allocations_{};
+  uint64_t bytes_{};
+};
+
+/**
+ * MonotonicArena that starts out with an inline block of InlineBytes, so that as long as the
+ * allocations fit in it, the arena does not touch the heap at all.
+ */
+template <size_t InlineBytes> class InlineMonotonicArena : public MonotonicArena {
+public:
+  InlineMonotonicArena() : MonotonicArena(inline_block_, InlineBytes) {}
+
+private:
+  alignas(std::max_align_t) char inline_block_[InlineBytes];
+};
+
+} // namespace Envoy
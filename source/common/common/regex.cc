@@ -1,5 +1,7 @@
 #include "common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 
 #include "common/common/assert.h"
@@ -51,6 +53,12 @@ private:
   const re2::RE2 regex_;
 };
 
+re2::RE2::Options setOptions() {
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  return options;
+}
+
 } // namespace
 
 CompiledMatcherPtr Utility::parseRegex(const envoy::type::matcher::RegexMatcher& matcher) {
@@ -64,6 +72,38 @@ CompiledMatcherPtr Utility::parseStdRegexAsCompiledMatcher(const std::string& re
   return std::make_unique<CompiledStdMatcher>(parseStdRegex(regex, flags));
 }
 
+GoogleReMatcherSet::GoogleReMatcherSet() : set_(setOptions(), re2::RE2::ANCHOR_BOTH) {}
+
+uint32_t GoogleReMatcherSet::add(const envoy::type::matcher::RegexMatcher& matcher) {
+  ASSERT(matcher.has_google_re2());
+  ASSERT(!compiled_);
+  std::string error;
+  const int index = set_.Add(matcher.regex(), &error);
+  if (index < 0) {
+    throw EnvoyException(error);
+  }
+  ASSERT(static_cast<uint32_t>(index) == size_);
+  return size_++;
+}
+
+void GoogleReMatcherSet::compile() {
+  ASSERT(!compiled_);
+  if (!set_.Compile()) {
+    throw EnvoyException("unable to compile regex set: out of memory");
+  }
+  compiled_ = true;
+}
+
+bool GoogleReMatcherSet::match(absl::string_view value, std::vector<int>& matches) const {
+  ASSERT(compiled_);
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(re2::StringPiece(value.data(), value.size()), &matches, &error_info)) {
+    return error_info.kind == re2::RE2::Set::kNoError;
+  }
+  std::sort(matches.begin(), matches.end());
+  return true;
+}
+
 std::regex Utility::parseStdRegex(const std::string& regex, std::regex::flag_type flags) {
   // TODO(zuercher): In the future, PGV (https://github.com/lyft/protoc-gen-validate) annotations
   // may allow us to remove this in favor of direct validation of regular expressions.
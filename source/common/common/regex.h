@@ -2,10 +2,14 @@
 
 #include <memory>
 #include <regex>
+#include <vector>
 
 #include "envoy/common/regex.h"
 #include "envoy/type/matcher/regex.pb.h"
 
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
 namespace Envoy {
 namespace Regex {
 
@@ -40,5 +44,49 @@ public:
   static CompiledMatcherPtr parseRegex(const envoy::type::matcher::RegexMatcher& matcher);
 };
 
+/**
+ * A set of Google RE2 regular expressions that are matched against a value in a single pass,
+ * reporting which of them fully match it. This is cheaper than matching the expressions one by one
+ * once there are more than a handful of them.
+ */
+class GoogleReMatcherSet {
+public:
+  GoogleReMatcherSet();
+
+  /**
+   * Add an expression to the set. Must not be called after compile().
+   * @param matcher supplies the match config. Its program size limit is not checked here; parse it
+   *        with Utility::parseRegex() for that.
+   * @return the index of the expression in the set, starting from 0.
+   * @throw EnvoyException if the expression is invalid.
+   */
+  uint32_t add(const envoy::type::matcher::RegexMatcher& matcher);
+
+  /**
+   * Build the matcher once all expressions are added.
+   * @throw EnvoyException if the matcher could not be built.
+   */
+  void compile();
+
+  /**
+   * @return the number of expressions in the set.
+   */
+  uint32_t size() const { return size_; }
+
+  /**
+   * Match a value against all expressions in the set.
+   * @param value supplies the value to match.
+   * @param matches supplies the vector the indexes of the matching expressions are stored in, in
+   *        increasing order.
+   * @return false if the matcher ran out of memory and could not tell which expressions match.
+   */
+  bool match(absl::string_view value, std::vector<int>& matches) const;
+
+private:
+  re2::RE2::Set set_;
+  uint32_t size_{};
+  bool compiled_{};
+};
+
 } // namespace Regex
 } // namespace Envoy
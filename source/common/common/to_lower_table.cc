@@ -1,5 +1,8 @@
 #include "common/common/to_lower_table.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace Envoy {
 ToLowerTable::ToLowerTable() {
   for (size_t c = 0; c < 256; c++) {
@@ -11,7 +14,25 @@ ToLowerTable::ToLowerTable() {
 }
 
 void ToLowerTable::toLowerCase(char* buffer, uint32_t size) const {
-  for (size_t i = 0; i < size; i++) {
+  constexpr uint64_t ones = 0x0101010101010101;
+  constexpr uint64_t high_bits = ones * 0x80;
+
+  // Convert eight bytes at a time. Adding to the low seven bits of a byte cannot carry into the
+  // next one, so the high bit of each byte of ge_a and gt_z tells whether that byte is >= 'A' and
+  // > 'Z' respectively. Upper case bytes get 0x20 set, which is their high bit shifted by two.
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, buffer + i, sizeof(word));
+    const uint64_t low_bits = word & ~high_bits;
+    const uint64_t ge_a = low_bits + ones * (0x80 - 'A');
+    const uint64_t gt_z = low_bits + ones * (0x80 - 'Z' - 1);
+    const uint64_t upper = (ge_a ^ gt_z) & ~word & high_bits;
+    word |= upper >> 2;
+    memcpy(buffer + i, &word, sizeof(word));
+  }
+
+  for (; i < size; i++) {
     buffer[i] = table_[static_cast<uint8_t>(buffer[i])];
   }
 }
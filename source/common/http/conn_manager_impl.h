@@ -28,6 +28,7 @@
 #include "envoy/upstream/upstream.h"
 
 #include "common/buffer/watermark_buffer.h"
+#include "common/common/arena.h"
 #include "common/common/dump_state_utils.h"
 #include "common/common/linked_object.h"
 #include "common/grpc/common.h"
@@ -103,6 +104,12 @@ private:
           continue_headers_continued_(false), end_stream_(false), dual_filter_(dual_filter),
           decode_headers_called_(false), encode_headers_called_(false) {}
 
+    // Filter wrappers are allocated from the arena of their stream, so deleting one only runs its
+    // destructor and the memory is released together with the stream.
+    static void* operator new(size_t size, MonotonicArena& arena) { return arena.allocate(size); }
+    static void operator delete(void*, MonotonicArena&) {}
+    static void operator delete(void*) {}
+
     // Functions in the following block are called after the filter finishes processing
     // corresponding data. Those functions handle state updates and data storage (if needed)
     // according to the status returned by filter's callback functions.
@@ -601,6 +608,13 @@ private:
     HeaderMapPtr request_headers_;
     Buffer::WatermarkBufferPtr buffered_request_data_;
     HeaderMapPtr request_trailers_;
+    // Room for the wrappers of four decoder and four encoder filters, which covers common filter
+    // chains without a heap allocation. Longer chains continue in heap blocks.
+    static constexpr size_t ArenaInlineBytes =
+        4 * (MonotonicArena::footprint(sizeof(ActiveStreamDecoderFilter)) +
+             MonotonicArena::footprint(sizeof(ActiveStreamEncoderFilter)));
+    // Backs the filter wrappers below and must therefore outlive them.
+    InlineMonotonicArena<ArenaInlineBytes> arena_;
     std::list<ActiveStreamDecoderFilterPtr> decoder_filters_;
     std::list<ActiveStreamEncoderFilterPtr> encoder_filters_;
     std::list<AccessLog::InstanceSharedPtr> access_log_handlers_;
@@ -1,5 +1,7 @@
 #include "common/http/header_map_impl.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -18,9 +20,19 @@ namespace Http {
 
 namespace {
 constexpr size_t MinDynamicCapacity{32};
+// Entries in the first arena block of a header map. This is kept small so that maps with few
+// headers, such as trailers, stay small. Each further block doubles in size, up to MaxBlockSlots
+// entries.
+constexpr uint32_t InitialBlockSlots{2};
+constexpr uint32_t MaxBlockSlots{64};
 // This includes the NULL (StringUtil::itoa technically only needs 21).
 constexpr size_t MaxIntegerLength{32};
 
+size_t roundUpToAlignment(size_t size) {
+  constexpr size_t alignment = alignof(std::max_align_t);
+  return (size + alignment - 1) / alignment * alignment;
+}
+
 uint64_t newCapacity(uint32_t existing_capacity, uint32_t size_to_append) {
   return (static_cast<uint64_t>(existing_capacity) + size_to_append) * 2;
 }
@@ -305,7 +317,52 @@ void HeaderMapImpl::appendToHeader(HeaderString& header, absl::string_view data)
   header.append(data.data(), data.size());
 }
 
-HeaderMapImpl::HeaderMapImpl() { memset(&inline_headers_, 0, sizeof(inline_headers_)); }
+HeaderMapImpl::EntryArena::~EntryArena() {
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next_;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* HeaderMapImpl::EntryArena::allocate(size_t size) {
+  if (slot_size_ == 0) {
+    slot_size_ = roundUpToAlignment(std::max(size, sizeof(FreeSlot)));
+    next_block_slots_ = InitialBlockSlots;
+  }
+  ASSERT(size <= slot_size_);
+
+  if (free_slots_ != nullptr) {
+    FreeSlot* slot = free_slots_;
+    free_slots_ = slot->next_;
+    return slot;
+  }
+
+  if (next_slot_ == block_end_) {
+    const size_t header_size = roundUpToAlignment(sizeof(Block));
+    const size_t block_size = header_size + slot_size_ * next_block_slots_;
+    Block* block = static_cast<Block*>(::operator new(block_size));
+    block->next_ = blocks_;
+    blocks_ = block;
+    next_slot_ = reinterpret_cast<char*>(block) + header_size;
+    block_end_ = reinterpret_cast<char*>(block) + block_size;
+    next_block_slots_ = std::min(next_block_slots_ * 2, MaxBlockSlots);
+  }
+
+  void* slot = next_slot_;
+  next_slot_ += slot_size_;
+  return slot;
+}
+
+void HeaderMapImpl::EntryArena::deallocate(void* slot) {
+  FreeSlot* free_slot = static_cast<FreeSlot*>(slot);
+  free_slot->next_ = free_slots_;
+  free_slots_ = free_slot;
+}
+
+HeaderMapImpl::HeaderMapImpl() : headers_(arena_) {
+  memset(&inline_headers_, 0, sizeof(inline_headers_));
+}
 
 HeaderMapImpl::HeaderMapImpl(
     const std::initializer_list<std::pair<LowerCaseString, std::string>>& values)
@@ -363,7 +420,7 @@ void HeaderMapImpl::insertByKey(HeaderString&& key, HeaderString&& value) {
       value.clear();
     }
   } else {
-    std::list<HeaderEntryImpl>::iterator i = headers_.insert(std::move(key), std::move(value));
+    HeaderEntryList::iterator i = headers_.insert(std::move(key), std::move(value));
     i->entry_ = i;
   }
 }
@@ -574,7 +631,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
     return **entry;
   }
 
-  std::list<HeaderEntryImpl>::iterator i = headers_.insert(key);
+  HeaderEntryList::iterator i = headers_.insert(key);
   i->entry_ = i;
   *entry = &(*i);
   return **entry;
@@ -588,7 +645,7 @@ HeaderMapImpl::HeaderEntryImpl& HeaderMapImpl::maybeCreateInline(HeaderEntryImpl
     return **entry;
   }
 
-  std::list<HeaderEntryImpl>::iterator i = headers_.insert(key, std::move(value));
+  HeaderEntryList::iterator i = headers_.insert(key, std::move(value));
   i->entry_ = i;
   *entry = &(*i);
   return **entry;
@@ -8,6 +8,7 @@
 
 #include "envoy/http/header_map.h"
 
+#include "common/common/assert.h"
 #include "common/common/non_copyable.h"
 #include "common/http/headers.h"
 
@@ -88,6 +89,67 @@ protected:
   void copyFrom(const HeaderMap& rhs);
   void clear() { removePrefix(LowerCaseString("")); }
 
+  /**
+   * Backing storage for the entries of a header map. Entries are carved out of blocks of growing
+   * size and a removed entry's slot is kept for reuse, so a map with a few dozen headers needs a
+   * handful of allocations instead of one per header. All blocks are released together when the
+   * map is destroyed.
+   */
+  class EntryArena : NonCopyable {
+  public:
+    ~EntryArena();
+
+    void* allocate(size_t size);
+    void deallocate(void* slot);
+
+  private:
+    struct Block {
+      Block* next_;
+    };
+    struct FreeSlot {
+      FreeSlot* next_;
+    };
+
+    Block* blocks_{};
+    FreeSlot* free_slots_{};
+    char* next_slot_{};
+    char* block_end_{};
+    size_t slot_size_{};
+    uint32_t next_block_slots_{};
+  };
+
+  /**
+   * Standard allocator handing out EntryArena slots, one object at a time.
+   */
+  template <class T> class EntryAllocator {
+  public:
+    using value_type = T;
+
+    explicit EntryAllocator(EntryArena& arena) : arena_(&arena) {}
+    template <class U> EntryAllocator(const EntryAllocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      ASSERT(n == 1);
+      return static_cast<T*>(arena_->allocate(sizeof(T)));
+    }
+    void deallocate(T* p, size_t) { arena_->deallocate(p); }
+
+    template <class U> bool operator==(const EntryAllocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+    template <class U> bool operator!=(const EntryAllocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+  private:
+    template <class U> friend class EntryAllocator;
+
+    EntryArena* arena_;
+  };
+
+  struct HeaderEntryImpl;
+  using HeaderEntryList = std::list<HeaderEntryImpl, EntryAllocator<HeaderEntryImpl>>;
+
   struct HeaderEntryImpl : public HeaderEntry, NonCopyable {
     HeaderEntryImpl(const LowerCaseString& key);
     HeaderEntryImpl(const LowerCaseString& key, HeaderString&& value);
@@ -104,7 +166,7 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    HeaderEntryList::iterator entry_;
   };
 
   struct StaticLookupResponse {
@@ -137,16 +199,17 @@ protected:
    */
   class HeaderList : NonCopyable {
   public:
-    HeaderList() : pseudo_headers_end_(headers_.end()) {}
+    explicit HeaderList(EntryArena& arena)
+        : headers_(EntryAllocator<HeaderEntryImpl>(arena)), pseudo_headers_end_(headers_.end()) {}
 
     template <class Key> bool isPseudoHeader(const Key& key) {
       return !key.getStringView().empty() && key.getStringView()[0] == ':';
     }
 
     template <class Key, class... Value>
-    std::list<HeaderEntryImpl>::iterator insert(Key&& key, Value&&... value) {
+    HeaderEntryList::iterator insert(Key&& key, Value&&... value) {
       const bool is_pseudo_header = isPseudoHeader(key);
-      std::list<HeaderEntryImpl>::iterator i =
+      HeaderEntryList::iterator i =
           headers_.emplace(is_pseudo_header ? pseudo_headers_end_ : headers_.end(),
                            std::forward<Key>(key), std::forward<Value>(value)...);
       if (!is_pseudo_header && pseudo_headers_end_ == headers_.end()) {
@@ -155,7 +218,7 @@ protected:
       return i;
     }
 
-    std::list<HeaderEntryImpl>::iterator erase(std::list<HeaderEntryImpl>::iterator i) {
+    HeaderEntryList::iterator erase(HeaderEntryList::iterator i) {
       if (pseudo_headers_end_ == i) {
         pseudo_headers_end_++;
       }
@@ -174,18 +237,18 @@ protected:
       });
     }
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     size_t size() const { return headers_.size(); }
     bool empty() const { return headers_.empty(); }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
-    std::list<HeaderEntryImpl>::iterator pseudo_headers_end_;
+    HeaderEntryList headers_;
+    HeaderEntryList::iterator pseudo_headers_end_;
   };
 
   void insertByKey(HeaderString&& key, HeaderString&& value);
@@ -197,6 +260,8 @@ protected:
   void removeInline(HeaderEntryImpl** entry);
 
   AllInlineHeaders inline_headers_;
+  // Must outlive headers_.
+  EntryArena arena_;
   HeaderList headers_;
 
   ALL_INLINE_HEADERS(DEFINE_INLINE_HEADER_FUNCS)
@@ -1,5 +1,7 @@
 #include "common/http/header_utility.h"
 
+#include <cstring>
+
 #include "common/common/regex.h"
 #include "common/common/utility.h"
 #include "common/config/rds_json.h"
@@ -7,7 +9,6 @@
 #include "common/protobuf/utility.h"
 
 #include "absl/strings/match.h"
-#include "nghttp2/nghttp2.h"
 
 namespace Envoy {
 namespace Http {
@@ -139,9 +140,46 @@ bool HeaderUtility::matchHeaders(const Http::HeaderMap& request_headers,
   return match != header_data.invert_match_;
 }
 
+namespace {
+
+// field-vchar, SP and HTAB, the same set nghttp2_check_header_value() accepts: everything but
+// control characters other than HTAB and DEL.
+bool isValidHeaderValueChar(uint8_t c) { return c == '\t' || (c >= 0x20 && c != 0x7f); }
+
+} // namespace
+
 bool HeaderUtility::headerIsValid(const absl::string_view header_value) {
-  return (nghttp2_check_header_value(reinterpret_cast<const uint8_t*>(header_value.data()),
-                                     header_value.size()) != 0);
+  constexpr uint64_t ones = 0x0101010101010101;
+  constexpr uint64_t high_bits = ones * 0x80;
+
+  // Check eight bytes at a time whether any of them is below SP or is DEL. The expressions may flag
+  // extra bytes above a flagged one but never miss one. Only words containing HTAB or an invalid
+  // character take the byte by byte check.
+  const char* data = header_value.data();
+  const size_t size = header_value.size();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    const uint64_t below_space = (word - ones * 0x20) & ~word & high_bits;
+    const uint64_t not_del = word ^ (ones * 0x7f);
+    const uint64_t del = (not_del - ones) & ~not_del & high_bits;
+    if ((below_space | del) == 0) {
+      continue;
+    }
+    for (size_t j = i; j < i + sizeof(uint64_t); j++) {
+      if (!isValidHeaderValueChar(data[j])) {
+        return false;
+      }
+    }
+  }
+
+  for (; i < size; i++) {
+    if (!isValidHeaderValueChar(data[i])) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void HeaderUtility::addHeaders(Http::HeaderMap& headers, const Http::HeaderMap& headers_to_add) {
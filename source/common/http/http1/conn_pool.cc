@@ -28,7 +28,14 @@ ConnPoolImpl::ConnPoolImpl(Event::Dispatcher& dispatcher, Upstream::HostConstSha
                            const Network::ConnectionSocket::OptionsSharedPtr& options)
     : ConnPoolImplBase(std::move(host), std::move(priority)), dispatcher_(dispatcher),
       socket_options_(options),
-      upstream_ready_timer_(dispatcher_.createTimer([this]() { onUpstreamReady(); })) {}
+      upstream_ready_timer_(dispatcher_.createTimer([this]() { onUpstreamReady(); })) {
+  if (host_->cluster().spareConnectionsPerHost() > 0) {
+    // Connections cannot be created before the derived class provides createCodecClient(), so the
+    // pool is warmed up on the next dispatcher iteration.
+    warm_up_timer_ = dispatcher_.createTimer([this]() { createSpareConnections(); });
+    warm_up_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
 
 ConnPoolImpl::~ConnPoolImpl() {
   while (!ready_clients_.empty()) {
@@ -64,6 +71,8 @@ bool ConnPoolImpl::hasActiveConnections() const {
   return !pending_requests_.empty() || !busy_clients_.empty();
 }
 
+bool ConnPoolImpl::hasUsableConnection() const { return !ready_clients_.empty(); }
+
 void ConnPoolImpl::attachRequestToClient(ActiveClient& client, StreamDecoder& response_decoder,
                                          ConnectionPool::Callbacks& callbacks) {
   ASSERT(!client.stream_wrapper_);
@@ -90,6 +99,23 @@ void ConnPoolImpl::createNewConnection() {
   ENVOY_LOG(debug, "creating a new connection");
   ActiveClientPtr client(new ActiveClient(*this));
   client->moveIntoList(std::move(client), busy_clients_);
+  connecting_clients_++;
+}
+
+void ConnPoolImpl::createSpareConnections() {
+  const uint32_t spare_connections = host_->cluster().spareConnectionsPerHost();
+  if (spare_connections == 0 || !drained_callbacks_.empty()) {
+    return;
+  }
+
+  // Connecting clients are spare unless a pending request is waiting for them.
+  while (ready_clients_.size() + connecting_clients_ <
+             spare_connections + pending_requests_.size() &&
+         host_->cluster().resourceManager(priority_).connections().canCreate()) {
+    ENVOY_LOG(debug, "creating a spare connection");
+    host_->cluster().stats().upstream_cx_spare_total_.inc();
+    createNewConnection();
+  }
 }
 
 ConnectionPool::Cancellable* ConnPoolImpl::newStream(StreamDecoder& response_decoder,
@@ -98,6 +124,7 @@ ConnectionPool::Cancellable* ConnPoolImpl::newStream(StreamDecoder& response_dec
     ready_clients_.front()->moveBetweenLists(ready_clients_, busy_clients_);
     ENVOY_CONN_LOG(debug, "using existing connection", *busy_clients_.front()->codec_client_);
     attachRequestToClient(*busy_clients_.front(), response_decoder, callbacks);
+    createSpareConnections();
     return nullptr;
   }
 
@@ -113,7 +140,9 @@ ConnectionPool::Cancellable* ConnPoolImpl::newStream(StreamDecoder& response_dec
       createNewConnection();
     }
 
-    return newPendingRequest(response_decoder, callbacks);
+    ConnectionPool::Cancellable* pending_request = newPendingRequest(response_decoder, callbacks);
+    createSpareConnections();
+    return pending_request;
   } else {
     ENVOY_LOG(debug, "max pending requests overflow");
     callbacks.onPoolFailure(ConnectionPool::PoolFailureReason::Overflow, absl::string_view(),
@@ -133,6 +162,7 @@ void ConnPoolImpl::onConnectionEvent(ActiveClient& client, Network::ConnectionEv
     Envoy::Upstream::reportUpstreamCxDestroy(host_, event);
     ActiveClientPtr removed;
     bool check_for_drained = true;
+    const bool connected = !client.connect_timer_;
     if (client.stream_wrapper_) {
       if (!client.stream_wrapper_->decode_complete_) {
         Envoy::Upstream::reportUpstreamCxDestroyActiveRequest(host_, event);
@@ -171,6 +201,13 @@ void ConnPoolImpl::onConnectionEvent(ActiveClient& client, Network::ConnectionEv
       createNewConnection();
     }
 
+    // Replace the connections the upstream closes rather than wait for the next request to do so.
+    // Connect failures are left alone, so that an unreachable host does not get a connection
+    // attempt after every failed one.
+    if (connected && event == Network::ConnectionEvent::RemoteClose) {
+      createSpareConnections();
+    }
+
     if (check_for_drained) {
       checkForDrained();
     }
@@ -179,6 +216,7 @@ void ConnPoolImpl::onConnectionEvent(ActiveClient& client, Network::ConnectionEv
   if (client.connect_timer_) {
     client.connect_timer_->disableTimer();
     client.connect_timer_.reset();
+    connecting_clients_--;
   }
 
   // Note that the order in this function is important. Concretely, we must destroy the connect
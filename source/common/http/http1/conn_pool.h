@@ -41,6 +41,7 @@ public:
   void addDrainedCallback(DrainedCb cb) override;
   void drainConnections() override;
   bool hasActiveConnections() const override;
+  bool hasUsableConnection() const override;
   ConnectionPool::Cancellable* newStream(StreamDecoder& response_decoder,
                                          ConnectionPool::Callbacks& callbacks) override;
   Upstream::HostDescriptionConstSharedPtr host() const override { return host_; };
@@ -110,6 +111,7 @@ protected:
                              ConnectionPool::Callbacks& callbacks);
   virtual CodecClientPtr createCodecClient(Upstream::Host::CreateConnectionData& data) PURE;
   void createNewConnection();
+  void createSpareConnections();
   void onConnectionEvent(ActiveClient& client, Network::ConnectionEvent event);
   void onDownstreamReset(ActiveClient& client);
   void onResponseComplete(ActiveClient& client);
@@ -124,6 +126,10 @@ protected:
   const Network::ConnectionSocket::OptionsSharedPtr socket_options_;
   Event::TimerPtr upstream_ready_timer_;
   bool upstream_ready_enabled_{false};
+  // Opens the spare connections of a new pool before its first request.
+  Event::TimerPtr warm_up_timer_;
+  // Clients in busy_clients_ that are not connected yet.
+  uint64_t connecting_clients_{};
 };
 
 /**
@@ -75,8 +75,9 @@ static void insertHeader(std::vector<nghttp2_nv>& headers, const HeaderEntry& he
                      header_value.size(), flags});
 }
 
-void ConnectionImpl::StreamImpl::buildHeaders(std::vector<nghttp2_nv>& final_headers,
-                                              const HeaderMap& headers) {
+const std::vector<nghttp2_nv>& ConnectionImpl::StreamImpl::buildHeaders(const HeaderMap& headers) {
+  std::vector<nghttp2_nv>& final_headers = parent_.header_nvs_;
+  final_headers.clear();
   final_headers.reserve(headers.size());
   headers.iterate(
       [](const HeaderEntry& header, void* context) -> HeaderMap::Iterate {
@@ -85,6 +86,7 @@ void ConnectionImpl::StreamImpl::buildHeaders(std::vector<nghttp2_nv>& final_hea
         return HeaderMap::Iterate::Continue;
       },
       &final_headers);
+  return final_headers;
 }
 
 void ConnectionImpl::StreamImpl::encode100ContinueHeaders(const HeaderMap& headers) {
@@ -93,18 +95,16 @@ void ConnectionImpl::StreamImpl::encode100ContinueHeaders(const HeaderMap& heade
 }
 
 void ConnectionImpl::StreamImpl::encodeHeaders(const HeaderMap& headers, bool end_stream) {
-  std::vector<nghttp2_nv> final_headers;
-
   // This must exist outside of the scope of isUpgrade as the underlying memory is
   // needed until submitHeaders has been called.
   Http::HeaderMapPtr modified_headers;
+  const HeaderMap* headers_to_encode = &headers;
   if (Http::Utility::isUpgrade(headers)) {
     modified_headers = std::make_unique<Http::HeaderMapImpl>(headers);
     transformUpgradeFromH1toH2(*modified_headers);
-    buildHeaders(final_headers, *modified_headers);
-  } else {
-    buildHeaders(final_headers, headers);
+    headers_to_encode = modified_headers.get();
   }
+  const std::vector<nghttp2_nv>& final_headers = buildHeaders(*headers_to_encode);
 
   nghttp2_data_provider provider;
   if (!end_stream) {
@@ -210,8 +210,7 @@ void ConnectionImpl::StreamImpl::saveHeader(HeaderString&& name, HeaderString&&
 }
 
 void ConnectionImpl::StreamImpl::submitTrailers(const HeaderMap& trailers) {
-  std::vector<nghttp2_nv> final_headers;
-  buildHeaders(final_headers, trailers);
+  const std::vector<nghttp2_nv>& final_headers = buildHeaders(trailers);
   int rc =
       nghttp2_submit_trailer(parent_.session_, stream_id_, &final_headers[0], final_headers.size());
   ASSERT(rc == 0);
@@ -367,6 +366,30 @@ bool checkRuntimeOverride(bool config_value, const char* override_key) {
   return Runtime::runtimeFeatureEnabled(override_key) ? true : config_value;
 }
 
+// DATA frame payloads smaller than this are copied even when zero copy is enabled, as copying them
+// is cheaper than referencing them and would not keep a mostly unused read buffer slice allocated.
+constexpr size_t MinZeroCopyDataFrameBytes = 4096;
+
+/**
+ * The payload of a received DATA frame, referencing the dispatched slice it was parsed from.
+ */
+class DataFrameFragment : public Buffer::BufferFragment {
+public:
+  DataFrameFragment(const uint8_t* data, size_t size, std::shared_ptr<Buffer::Instance> slice)
+      : data_(data), size_(size), slice_(std::move(slice)) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_; }
+  size_t size() const override { return size_; }
+  void done() override { delete this; }
+
+private:
+  const uint8_t* const data_;
+  const size_t size_;
+  // Holds the slice that data_ points into.
+  const std::shared_ptr<Buffer::Instance> slice_;
+};
+
 } // namespace
 
 ConnectionImpl::ConnectionImpl(Network::Connection& connection, Stats::Scope& stats,
@@ -377,7 +400,7 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, Stats::Scope& st
       per_stream_buffer_limit_(http2_settings.initial_stream_window_size_),
       stream_error_on_invalid_http_messaging_(checkRuntimeOverride(
           http2_settings.stream_error_on_invalid_http_messaging_, InvalidHttpMessagingOverrideKey)),
-      flood_detected_(false),
+      zero_copy_data_frames_(http2_settings.zero_copy_data_frames_), flood_detected_(false),
       max_outbound_frames_(
           Runtime::getInteger(MaxOutboundFramesOverrideKey, http2_settings.max_outbound_frames_)),
       frame_buffer_releasor_([this](const Buffer::OwnedBufferFragmentImpl* fragment) {
@@ -403,31 +426,52 @@ ConnectionImpl::~ConnectionImpl() { nghttp2_session_del(session_); }
 
 void ConnectionImpl::dispatch(Buffer::Instance& data) {
   ENVOY_CONN_LOG(trace, "dispatching {} bytes", connection_, data.length());
-  uint64_t num_slices = data.getRawSlices(nullptr, 0);
-  STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
-  data.getRawSlices(slices.begin(), num_slices);
-  for (const Buffer::RawSlice& slice : slices) {
-    dispatching_ = true;
-    ssize_t rc =
-        nghttp2_session_mem_recv(session_, static_cast<const uint8_t*>(slice.mem_), slice.len_);
-    if (rc == NGHTTP2_ERR_FLOODED || flood_detected_) {
-      throw FrameFloodException(
-          "Flooding was detected in this HTTP/2 session, and it must be closed");
+  const uint64_t length = data.length();
+  if (zero_copy_data_frames_) {
+    // Released on every exit, so that only the payloads passed on keep a slice allocated.
+    Cleanup release_slice([this]() { dispatch_slice_buffer_.reset(); });
+    while (data.length() > 0) {
+      // Each slice is moved into a buffer of its own, which is a zero-copy move, so that a DATA
+      // frame payload referencing it keeps only that slice allocated.
+      Buffer::RawSlice slice;
+      data.getRawSlices(&slice, 1);
+      dispatch_slice_buffer_ = std::make_shared<Buffer::OwnedImpl>();
+      dispatch_slice_buffer_->move(data, slice.len_);
+      dispatch_slice_buffer_->getRawSlices(&slice, 1);
+      dispatchSlice(slice);
     }
-    if (rc != static_cast<ssize_t>(slice.len_)) {
-      throw CodecProtocolException(fmt::format("{}", nghttp2_strerror(rc)));
+  } else {
+    uint64_t num_slices = data.getRawSlices(nullptr, 0);
+    STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
+    data.getRawSlices(slices.begin(), num_slices);
+    for (const Buffer::RawSlice& slice : slices) {
+      dispatchSlice(slice);
     }
-
-    dispatching_ = false;
+    data.drain(data.length());
   }
 
-  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, data.length());
-  data.drain(data.length());
+  ENVOY_CONN_LOG(trace, "dispatched {} bytes", connection_, length);
 
   // Decoding incoming frames can generate outbound frames so flush pending.
   sendPendingFrames();
 }
 
+void ConnectionImpl::dispatchSlice(const Buffer::RawSlice& slice) {
+  dispatching_ = true;
+  dispatch_slice_ = slice;
+  ssize_t rc =
+      nghttp2_session_mem_recv(session_, static_cast<const uint8_t*>(slice.mem_), slice.len_);
+  if (rc == NGHTTP2_ERR_FLOODED || flood_detected_) {
+    throw FrameFloodException(
+        "Flooding was detected in this HTTP/2 session, and it must be closed");
+  }
+  if (rc != static_cast<ssize_t>(slice.len_)) {
+    throw CodecProtocolException(fmt::format("{}", nghttp2_strerror(rc)));
+  }
+
+  dispatching_ = false;
+}
+
 ConnectionImpl::StreamImpl* ConnectionImpl::getStream(int32_t stream_id) {
   return static_cast<StreamImpl*>(nghttp2_session_get_stream_user_data(session_, stream_id));
 }
@@ -436,7 +480,15 @@ int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   StreamImpl* stream = getStream(stream_id);
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
-  stream->pending_recv_data_.add(data, len);
+  const uint8_t* slice_begin = static_cast<const uint8_t*>(dispatch_slice_.mem_);
+  if (dispatch_slice_buffer_ != nullptr && len >= MinZeroCopyDataFrameBytes &&
+      data >= slice_begin && data + len <= slice_begin + dispatch_slice_.len_) {
+    // nghttp2 hands out DATA frame payloads in place, so they can be referenced instead of copied.
+    stream->pending_recv_data_.addBufferFragment(
+        *new DataFrameFragment(data, len, dispatch_slice_buffer_));
+  } else {
+    stream->pending_recv_data_.add(data, len);
+  }
   // Update the window to the peer unless some consumer of this stream's data has hit a flow control
   // limit and disabled reads on this stream
   if (!stream->buffers_overrun()) {
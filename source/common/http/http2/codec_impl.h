@@ -151,7 +151,9 @@ protected:
     ssize_t onDataSourceRead(uint64_t length, uint32_t* data_flags);
     int onDataSourceSend(const uint8_t* framehd, size_t length);
     void resetStreamWorker(StreamResetReason reason);
-    static void buildHeaders(std::vector<nghttp2_nv>& final_headers, const HeaderMap& headers);
+    // Converts headers into the connection's reusable nghttp2_nv array, which stays valid until
+    // the next call. nghttp2 copies the array when a frame is submitted.
+    const std::vector<nghttp2_nv>& buildHeaders(const HeaderMap& headers);
     void saveHeader(HeaderString&& name, HeaderString&& value);
     virtual void submitHeaders(const std::vector<nghttp2_nv>& final_headers,
                                nghttp2_data_provider* provider) PURE;
@@ -286,12 +288,20 @@ protected:
 
   std::list<StreamImplPtr> active_streams_;
   nghttp2_session* session_{};
+  // Scratch array that header maps are converted into before they are submitted, so that encoding
+  // headers or trailers does not allocate a new array for every frame.
+  std::vector<nghttp2_nv> header_nvs_;
+  // The slice being parsed by dispatch(). When DATA frame payloads are passed on by reference, it
+  // is moved into a buffer of its own that those payloads keep allocated.
+  std::shared_ptr<Buffer::Instance> dispatch_slice_buffer_;
+  Buffer::RawSlice dispatch_slice_{};
   CodecStats stats_;
   Network::Connection& connection_;
   const uint32_t max_request_headers_kb_;
   uint32_t per_stream_buffer_limit_;
   bool allow_metadata_;
   const bool stream_error_on_invalid_http_messaging_;
+  const bool zero_copy_data_frames_;
   bool flood_detected_;
 
   // Set if the type of frame that is about to be sent is PING or SETTINGS with the ACK flag set, or
@@ -352,6 +362,7 @@ protected:
 private:
   virtual ConnectionCallbacks& callbacks() PURE;
   virtual int onBeginHeaders(const nghttp2_frame* frame) PURE;
+  void dispatchSlice(const Buffer::RawSlice& slice);
   int onData(int32_t stream_id, const uint8_t* data, size_t len);
   int onBeforeFrameReceived(const nghttp2_frame_hd* hd);
   int onFrameReceived(const nghttp2_frame* frame);
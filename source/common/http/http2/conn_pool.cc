@@ -57,6 +57,8 @@ bool ConnPoolImpl::hasActiveConnections() const {
   return !pending_requests_.empty();
 }
 
+bool ConnPoolImpl::hasUsableConnection() const { return primary_client_ != nullptr; }
+
 void ConnPoolImpl::checkForDrained() {
   if (drained_callbacks_.empty()) {
     return;
@@ -284,6 +286,7 @@ ConnPoolImpl::ActiveClient::ActiveClient(ConnPoolImpl& parent)
 
   parent_.host_->stats().cx_total_.inc();
   parent_.host_->stats().cx_active_.inc();
+  parent_.host_->stats().cx_http2_active_.inc();
   parent_.host_->cluster().stats().upstream_cx_total_.inc();
   parent_.host_->cluster().stats().upstream_cx_active_.inc();
   parent_.host_->cluster().stats().upstream_cx_http2_total_.inc();
@@ -299,6 +302,7 @@ ConnPoolImpl::ActiveClient::ActiveClient(ConnPoolImpl& parent)
 
 ConnPoolImpl::ActiveClient::~ActiveClient() {
   parent_.host_->stats().cx_active_.dec();
+  parent_.host_->stats().cx_http2_active_.dec();
   parent_.host_->cluster().stats().upstream_cx_active_.dec();
   conn_length_->complete();
 }
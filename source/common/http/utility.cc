@@ -267,6 +267,7 @@ Utility::parseHttp2Settings(const envoy::api::v2::core::Http2ProtocolOptions& co
   ret.allow_connect_ = config.allow_connect();
   ret.allow_metadata_ = config.allow_metadata();
   ret.stream_error_on_invalid_http_messaging_ = config.stream_error_on_invalid_http_messaging();
+  ret.zero_copy_data_frames_ = config.zero_copy_data_frames();
   return ret;
 }
 
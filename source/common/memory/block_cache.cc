@@ -0,0 +1,185 @@
+#include "common/memory/block_cache.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace Envoy {
+namespace Memory {
+
+namespace {
+
+// Counters are kept per thread and folded into these every FlushInterval updates, so that the
+// allocation fast path doesn't bounce a shared cache line between workers.
+constexpr int64_t FlushInterval = 64;
+std::atomic<uint64_t> total_hits{0};
+std::atomic<uint64_t> total_misses{0};
+std::atomic<int64_t> total_retained_bytes{0};
+
+struct FreeBlock {
+  FreeBlock* next_;
+};
+
+class ThreadCache {
+public:
+  ~ThreadCache();
+
+  void* pop(size_t pages);
+  bool push(void* block, size_t pages);
+  void clear();
+  void recordMiss();
+
+private:
+  void maybeFlushCounters();
+  void flushCounters();
+
+  FreeBlock* free_lists_[BlockCache::MaxCachedPages]{};
+  size_t cached_bytes_{};
+  int64_t pending_updates_{};
+  uint64_t pending_hits_{};
+  uint64_t pending_misses_{};
+  int64_t pending_retained_bytes_{};
+};
+
+// Set once the calling thread's cache has been destroyed. Blocks released after that point, e.g.
+// by other thread_local destructors, go straight back to the heap.
+thread_local bool thread_cache_destroyed = false;
+
+ThreadCache* threadCache() {
+  if (thread_cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+ThreadCache::~ThreadCache() {
+  clear();
+  thread_cache_destroyed = true;
+}
+
+void* ThreadCache::pop(size_t pages) {
+  FreeBlock* block = free_lists_[pages - 1];
+  if (block == nullptr) {
+    return nullptr;
+  }
+  free_lists_[pages - 1] = block->next_;
+  cached_bytes_ -= pages * BlockCache::PageSize;
+  pending_retained_bytes_ -= pages * BlockCache::PageSize;
+  pending_hits_++;
+  maybeFlushCounters();
+  return block;
+}
+
+bool ThreadCache::push(void* block, size_t pages) {
+  if (cached_bytes_ + pages * BlockCache::PageSize > BlockCache::MaxCachedBytesPerThread) {
+    return false;
+  }
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next_ = free_lists_[pages - 1];
+  free_lists_[pages - 1] = free_block;
+  cached_bytes_ += pages * BlockCache::PageSize;
+  pending_retained_bytes_ += pages * BlockCache::PageSize;
+  maybeFlushCounters();
+  return true;
+}
+
+void ThreadCache::clear() {
+  for (FreeBlock*& head : free_lists_) {
+    while (head != nullptr) {
+      FreeBlock* next = head->next_;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+  pending_retained_bytes_ -= cached_bytes_;
+  cached_bytes_ = 0;
+  flushCounters();
+}
+
+void ThreadCache::recordMiss() {
+  pending_misses_++;
+  maybeFlushCounters();
+}
+
+void ThreadCache::maybeFlushCounters() {
+  if (++pending_updates_ >= FlushInterval) {
+    flushCounters();
+  }
+}
+
+void ThreadCache::flushCounters() {
+  total_hits.fetch_add(pending_hits_, std::memory_order_relaxed);
+  total_misses.fetch_add(pending_misses_, std::memory_order_relaxed);
+  total_retained_bytes.fetch_add(pending_retained_bytes_, std::memory_order_relaxed);
+  pending_updates_ = 0;
+  pending_hits_ = 0;
+  pending_misses_ = 0;
+  pending_retained_bytes_ = 0;
+}
+
+// Returns the number of pages of a block with the given total size, or 0 if it isn't cacheable.
+size_t cacheablePages(size_t total_size) {
+  if (total_size % BlockCache::PageSize != 0) {
+    return 0;
+  }
+  const size_t pages = total_size / BlockCache::PageSize;
+  return pages <= BlockCache::MaxCachedPages ? pages : 0;
+}
+
+} // namespace
+
+void* BlockCache::allocate(size_t size) {
+  static_assert(HeaderSize >= sizeof(size_t) && HeaderSize % alignof(std::max_align_t) == 0,
+                "block header must keep the payload aligned");
+  const size_t total_size = size + HeaderSize;
+  void* block = nullptr;
+  const size_t pages = cacheablePages(total_size);
+  if (pages != 0) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr) {
+      block = cache->pop(pages);
+      if (block == nullptr) {
+        cache->recordMiss();
+      }
+    }
+  }
+  if (block == nullptr) {
+    block = ::operator new(total_size);
+  }
+  *static_cast<size_t*>(block) = total_size;
+  return static_cast<char*>(block) + HeaderSize;
+}
+
+void BlockCache::release(void* address) {
+  if (address == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(address) - HeaderSize;
+  const size_t pages = cacheablePages(*static_cast<size_t*>(block));
+  if (pages != 0) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr && cache->push(block, pages)) {
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
+void BlockCache::releaseThreadCache() {
+  ThreadCache* cache = threadCache();
+  if (cache != nullptr) {
+    cache->clear();
+  }
+}
+
+uint64_t BlockCache::hits() { return total_hits.load(std::memory_order_relaxed); }
+
+uint64_t BlockCache::misses() { return total_misses.load(std::memory_order_relaxed); }
+
+uint64_t BlockCache::retainedBytes() {
+  return static_cast<uint64_t>(total_retained_bytes.load(std::memory_order_relaxed));
+}
+
+} // namespace Memory
+} // namespace Envoy
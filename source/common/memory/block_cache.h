@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * Allocator for variable-size blocks which keeps a bounded per-thread free list of recently
+ * released blocks of whole pages. Buffer slices are allocated and freed at a high rate in a small
+ * number of page-rounded sizes, so reusing a block on the same thread avoids a round trip through
+ * the heap for most of them.
+ *
+ * Every block is prefixed with a header of HeaderSize bytes that records its size, so callers that
+ * want a block to be cacheable should ask for a multiple of PageSize minus HeaderSize.
+ */
+class BlockCache {
+public:
+  static constexpr size_t PageSize = 4096;
+  static constexpr size_t HeaderSize = 16;
+
+  // Blocks larger than this many pages are never cached.
+  static constexpr size_t MaxCachedPages = 8;
+
+  // Upper bound on the bytes cached by a single thread.
+  static constexpr size_t MaxCachedBytesPerThread = 1024 * 1024;
+
+  /**
+   * @param size the number of usable bytes to allocate.
+   * @return void* a block with at least size usable bytes, aligned like ::operator new.
+   */
+  static void* allocate(size_t size);
+
+  /**
+   * Release a block previously returned by allocate(). It may be on any thread.
+   * @param block the block to release, or nullptr.
+   */
+  static void release(void* block);
+
+  /**
+   * Free every block cached by the calling thread.
+   */
+  static void releaseThreadCache();
+
+  /**
+   * @return uint64_t the number of allocations served from a thread cache.
+   */
+  static uint64_t hits();
+
+  /**
+   * @return uint64_t the number of cacheable allocations that had to go to the heap.
+   */
+  static uint64_t misses();
+
+  /**
+   * @return uint64_t the number of bytes currently held in thread caches.
+   */
+  static uint64_t retainedBytes();
+};
+
+} // namespace Memory
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "common/common/logger.h"
+#include "common/memory/block_cache.h"
 
 #ifdef TCMALLOC
 
@@ -47,6 +48,8 @@ void Stats::dumpStatsToLog() {
   auto buffer = std::make_unique<char[]>(buffer_size);
   MallocExtension::instance()->GetStats(buffer.get(), buffer_size);
   ENVOY_LOG_MISC(debug, "TCMalloc stats:\n{}", buffer.get());
+  ENVOY_LOG_MISC(debug, "Slice cache: {} hits, {} misses, {} bytes retained", sliceCacheHits(),
+                 sliceCacheMisses(), sliceCacheRetainedBytes());
 }
 
 } // namespace Memory
@@ -62,9 +65,22 @@ uint64_t Stats::totalThreadCacheBytes() { return 0; }
 uint64_t Stats::totalCurrentlyReserved() { return 0; }
 uint64_t Stats::totalPageHeapUnmapped() { return 0; }
 uint64_t Stats::totalPageHeapFree() { return 0; }
-void Stats::dumpStatsToLog() {}
+void Stats::dumpStatsToLog() {
+  ENVOY_LOG_MISC(debug, "Slice cache: {} hits, {} misses, {} bytes retained", sliceCacheHits(),
+                 sliceCacheMisses(), sliceCacheRetainedBytes());
+}
 
 } // namespace Memory
 } // namespace Envoy
 
 #endif // #ifdef TCMALLOC
+
+namespace Envoy {
+namespace Memory {
+
+uint64_t Stats::sliceCacheHits() { return BlockCache::hits(); }
+uint64_t Stats::sliceCacheMisses() { return BlockCache::misses(); }
+uint64_t Stats::sliceCacheRetainedBytes() { return BlockCache::retainedBytes(); }
+
+} // namespace Memory
+} // namespace Envoy
@@ -40,6 +40,22 @@ public:
    */
   static uint64_t totalPageHeapFree();
 
+  /**
+   * @return uint64_t the number of buffer slice allocations served from a per-thread block cache.
+   */
+  static uint64_t sliceCacheHits();
+
+  /**
+   * @return uint64_t the number of cacheable buffer slice allocations that missed the per-thread
+   *                  block caches and went to the heap.
+   */
+  static uint64_t sliceCacheMisses();
+
+  /**
+   * @return uint64_t the number of bytes of freed buffer slices held in per-thread block caches.
+   */
+  static uint64_t sliceCacheRetainedBytes();
+
   /**
    * Log detailed stats about current memory allocation. Intended for debugging purposes.
    */
@@ -0,0 +1,50 @@
+#include "common/network/connection_balancer_impl.h"
+
+#include <algorithm>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Network {
+
+void ExactConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(&handler);
+}
+
+void ExactConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  // This could be made more efficient in various ways, but the number of listeners is generally
+  // small and this is a rare operation so we can start with this and optimize later if this
+  // becomes a perf bottleneck.
+  auto it = std::find(handlers_.begin(), handlers_.end(), &handler);
+  ASSERT(it != handlers_.end());
+  handlers_.erase(it);
+}
+
+bool ExactConnectionBalancerImpl::balanceConnection(BalancedConnectionHandler& current_handler,
+                                                    ConnectionSocketPtr& socket) {
+  absl::MutexLock lock(&lock_);
+  BalancedConnectionHandler* min_connection_handler = &current_handler;
+  for (BalancedConnectionHandler* handler : handlers_) {
+    // Strictly less than, so that the current handler wins a tie and we avoid a needless
+    // cross-thread transfer.
+    if (handler->numConnections() < min_connection_handler->numConnections()) {
+      min_connection_handler = handler;
+    }
+  }
+
+  min_connection_handler->incNumConnections();
+  if (min_connection_handler == &current_handler) {
+    return false;
+  }
+
+  // The transfer happens with the lock held so that the target handler cannot be unregistered and
+  // destroyed on its own worker in the meantime. post() only queues the socket on the target
+  // worker's dispatcher so this is cheap.
+  min_connection_handler->post(std::move(socket));
+  return true;
+}
+
+} // namespace Network
+} // namespace Envoy
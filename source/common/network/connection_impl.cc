@@ -365,6 +365,7 @@ void ConnectionImpl::write(Buffer::Instance& data, bool end_stream) {
 
 void ConnectionImpl::write(Buffer::Instance& data, bool end_stream, bool through_filter_chain) {
   ASSERT(!end_stream || enable_half_close_);
+  ASSERT(socket_event_cb_ == nullptr);
 
   if (write_end_stream_) {
     // It is an API violation to write more data after writing end_stream, but a duplicate
@@ -481,6 +482,11 @@ void ConnectionImpl::onFileEvent(uint32_t events) {
     return;
   }
 
+  if (socket_event_cb_ != nullptr) {
+    socket_event_cb_(events);
+    return;
+  }
+
   if (events & Event::FileReadyType::Write) {
     onWriteReady();
   }
@@ -539,6 +545,19 @@ ConnectionImpl::unixSocketPeerCredentials() const {
 #endif
 }
 
+void ConnectionImpl::takeOverSocketEvents(SocketEventCb cb, Buffer::Instance& read_data,
+                                          Buffer::Instance& write_data) {
+  ASSERT(state() == State::Open && !connecting_ && socket_event_cb_ == nullptr);
+  ENVOY_CONN_LOG(debug, "socket events taken over", *this);
+  read_data.move(read_buffer_);
+  write_data.move(*write_buffer_);
+  updateReadBufferStats(0, 0);
+  updateWriteBufferStats(0, 0);
+  socket_event_cb_ = std::move(cb);
+  // Edge triggered events may have fired already, so make sure the moved data gets sent.
+  file_event_->activate(Event::FileReadyType::Write);
+}
+
 void ConnectionImpl::onWriteReady() {
   ENVOY_CONN_LOG(trace, "write ready", *this);
 
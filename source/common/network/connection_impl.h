@@ -80,6 +80,8 @@ public:
     return socket_->localAddress();
   }
   absl::optional<UnixDomainSocketPeerCredentials> unixSocketPeerCredentials() const override;
+  void takeOverSocketEvents(SocketEventCb cb, Buffer::Instance& read_data,
+                            Buffer::Instance& write_data) override;
   void setConnectionStats(const ConnectionStats& stats) override;
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return transport_socket_->ssl(); }
   State state() const override;
@@ -157,6 +159,8 @@ protected:
   ConnectionEvent immediate_error_event_{ConnectionEvent::Connected};
   bool bind_error_{false};
   Event::FileEventPtr file_event_;
+  // Set once the socket events have been taken over. @see takeOverSocketEvents().
+  SocketEventCb socket_event_cb_;
 
 private:
   friend class Envoy::RandomPauseFilter;
@@ -6,6 +6,7 @@
 #include "envoy/buffer/buffer.h"
 
 #include "common/api/os_sys_calls_impl.h"
+#include "common/common/macros.h"
 #include "common/common/stack_array.h"
 #include "common/network/address_impl.h"
 #include "common/network/io_socket_error_impl.h"
@@ -220,6 +221,52 @@ absl::optional<uint32_t> maybeGetPacketsDroppedFromHeader(
   return absl::nullopt;
 }
 
+Address::InstanceConstSharedPtr
+IoSocketHandleImpl::getPeerAddress(const sockaddr_storage& peer_addr, socklen_t peer_addr_len) {
+  try {
+    // Set v6only to false so that mapped-v6 address can be normalize to v4
+    // address. Though dual stack may be disabled, it's still okay to assume the
+    // address is from a dual stack socket. This is because mapped-v6 address
+    // must come from a dual stack socket. An actual v6 address can come from
+    // both dual stack socket and v6 only socket. If |peer_addr| is an actual v6
+    // address and the socket is actually v6 only, the returned address will be
+    // regarded as a v6 address from dual stack socket. However, this address is not going to be
+    // used to create socket. Wrong knowledge of dual stack support won't hurt.
+    return Address::addressFromSockAddr(peer_addr, peer_addr_len, /*v6only=*/false);
+  } catch (const EnvoyException& e) {
+    PANIC(fmt::format("Invalid remote address for fd: {}, error: {}", fd_, e.what()));
+  }
+}
+
+void IoSocketHandleImpl::parseControlMessages(msghdr& hdr, uint32_t self_port,
+                                              Address::InstanceConstSharedPtr& local_address,
+                                              uint32_t* dropped_packets) {
+  // Get overflow, local and peer addresses from control message.
+  if (hdr.msg_controllen > 0) {
+    struct cmsghdr* cmsg;
+    for (cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (local_address == nullptr) {
+        try {
+          Address::InstanceConstSharedPtr addr = maybeGetDstAddressFromHeader(*cmsg, self_port);
+          if (addr != nullptr) {
+            // This is a IP packet info message.
+            local_address = std::move(addr);
+            continue;
+          }
+        } catch (const EnvoyException& e) {
+          PANIC(fmt::format("Invalid destination address for fd: {}, error: {}", fd_, e.what()));
+        }
+      }
+      if (dropped_packets != nullptr) {
+        absl::optional<uint32_t> maybe_dropped = maybeGetPacketsDroppedFromHeader(*cmsg);
+        if (maybe_dropped) {
+          *dropped_packets = *maybe_dropped;
+        }
+      }
+    }
+  }
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
                                                     const uint64_t num_slice, uint32_t self_port,
                                                     RecvMsgOutput& output) {
@@ -264,46 +311,82 @@ Api::IoCallUint64Result IoSocketHandleImpl::recvmsg(Buffer::RawSlice* slices,
                  fmt::format("Incorrectly set control message length: {}", hdr.msg_controllen));
   RELEASE_ASSERT(hdr.msg_namelen > 0,
                  fmt::format("Unable to get remote address from recvmsg() for fd: {}", fd_));
-  try {
-    // Set v6only to false so that mapped-v6 address can be normalize to v4
-    // address. Though dual stack may be disabled, it's still okay to assume the
-    // address is from a dual stack socket. This is because mapped-v6 address
-    // must come from a dual stack socket. An actual v6 address can come from
-    // both dual stack socket and v6 only socket. If |peer_addr| is an actual v6
-    // address and the socket is actually v6 only, the returned address will be
-    // regarded as a v6 address from dual stack socket. However, this address is not going to be
-    // used to create socket. Wrong knowledge of dual stack support won't hurt.
-    output.peer_address_ =
-        Address::addressFromSockAddr(peer_addr, hdr.msg_namelen, /*v6only=*/false);
-  } catch (const EnvoyException& e) {
-    PANIC(fmt::format("Invalid remote address for fd: {}, error: {}", fd_, e.what()));
+  output.peer_address_ = getPeerAddress(peer_addr, hdr.msg_namelen);
+  parseControlMessages(hdr, self_port, output.local_address_, output.dropped_packets_);
+  return sysCallResultToIoCallResult(result);
+}
+
+Api::IoCallUint64Result IoSocketHandleImpl::recvmmsg(Buffer::RawSlice* slices,
+                                                     uint64_t num_packets, uint32_t self_port,
+                                                     RecvMmsgOutput& output) {
+#ifdef _MSC_VER
+  // mmsghdr is not defined on Windows, where supportsMmsg() is false.
+  UNREFERENCED_PARAMETER(slices);
+  UNREFERENCED_PARAMETER(num_packets);
+  UNREFERENCED_PARAMETER(self_port);
+  UNREFERENCED_PARAMETER(output);
+  return sysCallResultToIoCallResult(Api::SysCallSizeResult{-1, ENOSYS});
+#else
+  ASSERT(num_packets <= output.packets_.size());
+
+  // The minimum cmsg buffer size to filled in destination address and packets dropped when
+  // receiving a packet. It is possible for a received packet to contain both IPv4 and IPv6
+  // addresses.
+  const size_t cmsg_space = CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(struct in_pktinfo)) +
+                            CMSG_SPACE(sizeof(struct in6_pktinfo));
+  STACK_ARRAY(cbuf, char, cmsg_space * num_packets);
+  memset(cbuf.begin(), 0, cmsg_space * num_packets);
+
+  STACK_ARRAY(iov, iovec, num_packets);
+  STACK_ARRAY(peer_addrs, sockaddr_storage, num_packets);
+  STACK_ARRAY(mmsg_hdr, mmsghdr, num_packets);
+  for (uint64_t i = 0; i < num_packets; i++) {
+    iov[i].iov_base = slices[i].mem_;
+    iov[i].iov_len = slices[i].len_;
+
+    msghdr& hdr = mmsg_hdr[i].msg_hdr;
+    hdr.msg_name = &peer_addrs[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iov[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_flags = 0;
+    auto cmsg = reinterpret_cast<struct cmsghdr*>(cbuf.begin() + cmsg_space * i);
+    cmsg->cmsg_len = cmsg_space;
+    hdr.msg_control = cmsg;
+    hdr.msg_controllen = cmsg_space;
+    mmsg_hdr[i].msg_len = 0;
   }
 
-  // Get overflow, local and peer addresses from control message.
-  if (hdr.msg_controllen > 0) {
-    struct cmsghdr* cmsg;
-    for (cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
-      if (output.local_address_ == nullptr) {
-        try {
-          Address::InstanceConstSharedPtr addr = maybeGetDstAddressFromHeader(*cmsg, self_port);
-          if (addr != nullptr) {
-            // This is a IP packet info message.
-            output.local_address_ = std::move(addr);
-            continue;
-          }
-        } catch (const EnvoyException& e) {
-          PANIC(fmt::format("Invalid destination address for fd: {}, error: {}", fd_, e.what()));
-        }
-      }
-      if (output.dropped_packets_ != nullptr) {
-        absl::optional<uint32_t> maybe_dropped = maybeGetPacketsDroppedFromHeader(*cmsg);
-        if (maybe_dropped) {
-          *output.dropped_packets_ = *maybe_dropped;
-        }
-      }
-    }
+  // Set MSG_WAITFORONE so that recvmmsg() returns as soon as the socket runs out of packets
+  // instead of waiting for all |num_packets| to arrive.
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const Api::SysCallIntResult result = os_sys_calls.recvmmsg(
+      fd_, mmsg_hdr.begin(), static_cast<unsigned int>(num_packets), MSG_WAITFORONE, nullptr);
+  if (result.rc_ <= 0) {
+    return sysCallResultToIoCallResult(Api::SysCallSizeResult{result.rc_, result.errno_});
   }
-  return sysCallResultToIoCallResult(result);
+
+  const uint64_t num_packets_read = static_cast<uint64_t>(result.rc_);
+  for (uint64_t i = 0; i < num_packets_read; i++) {
+    msghdr& hdr = mmsg_hdr[i].msg_hdr;
+    RELEASE_ASSERT((hdr.msg_flags & MSG_CTRUNC) == 0,
+                   fmt::format("Incorrectly set control message length: {}", hdr.msg_controllen));
+    RELEASE_ASSERT(hdr.msg_namelen > 0,
+                   fmt::format("Unable to get remote address from recvmmsg() for fd: {}", fd_));
+
+    RecvMmsgOutput::PacketInfo& packet = output.packets_[i];
+    packet.msg_len_ = mmsg_hdr[i].msg_len;
+    packet.peer_address_ = getPeerAddress(peer_addrs[i], hdr.msg_namelen);
+    packet.local_address_ = nullptr;
+    parseControlMessages(hdr, self_port, packet.local_address_, output.dropped_packets_);
+  }
+  return Api::IoCallUint64Result(num_packets_read,
+                                 Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+#endif
+}
+
+bool IoSocketHandleImpl::supportsMmsg() const {
+  return Api::OsSysCallsSingleton::get().supportsMmsg();
 }
 
 } // namespace Network
@@ -2,6 +2,7 @@
 
 #include "envoy/api/io_error.h"
 #include "envoy/api/os_sys_calls.h"
+#include "envoy/network/address.h"
 #include "envoy/network/io_handle.h"
 
 #include "common/common/logger.h"
@@ -41,10 +42,25 @@ public:
   Api::IoCallUint64Result recvmsg(Buffer::RawSlice* slices, const uint64_t num_slice,
                                   uint32_t self_port, RecvMsgOutput& output) override;
 
+  Api::IoCallUint64Result recvmmsg(Buffer::RawSlice* slices, uint64_t num_packets,
+                                   uint32_t self_port, RecvMmsgOutput& output) override;
+
+  bool supportsMmsg() const override;
+
 private:
   // Converts a SysCallSizeResult to IoCallUint64Result.
   Api::IoCallUint64Result sysCallResultToIoCallResult(const Api::SysCallSizeResult& result);
 
+  // Returns the source address of a message received by recvmsg() or recvmmsg().
+  Address::InstanceConstSharedPtr getPeerAddress(const sockaddr_storage& peer_addr,
+                                                 socklen_t peer_addr_len);
+
+  // Extracts the destination address and the dropped packets count from the control messages of
+  // |hdr|. |local_address| is only set if it is still nullptr.
+  void parseControlMessages(msghdr& hdr, uint32_t self_port,
+                            Address::InstanceConstSharedPtr& local_address,
+                            uint32_t* dropped_packets);
+
   int fd_;
 };
 
@@ -45,6 +45,17 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   return {action, bytes_read, end_stream};
 }
 
+bool RawBufferSocket::endsInsideSlice(uint64_t bytes, const Buffer::RawSlice* slices,
+                                      uint64_t num_slices) {
+  for (uint64_t i = 0; i < num_slices; i++) {
+    if (bytes < slices[i].len_) {
+      return bytes != 0;
+    }
+    bytes -= slices[i].len_;
+  }
+  return false;
+}
+
 IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
@@ -60,11 +71,27 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
       action = PostIoAction::KeepOpen;
       break;
     }
-    Api::IoCallUint64Result result = buffer.write(callbacks_->ioHandle());
+    // The slices are handed to writev() here rather than through Buffer::Instance::write(), so
+    // that a short write can be told apart from a write that was only limited by the number of
+    // slices.
+    constexpr uint64_t MaxSlices = 16;
+    Buffer::RawSlice slices[MaxSlices];
+    const uint64_t num_slices = std::min(buffer.getRawSlices(slices, MaxSlices), MaxSlices);
+    Api::IoCallUint64Result result = callbacks_->ioHandle().writev(slices, num_slices);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "write returns: {}", callbacks_->connection(), result.rc_);
+      const bool short_write = endsInsideSlice(result.rc_, slices, num_slices);
+      if (result.rc_ > 0) {
+        buffer.drain(result.rc_);
+      }
       bytes_written += result.rc_;
+      if (short_write) {
+        // The kernel stopped in the middle of a slice, so the socket send buffer is full and
+        // another writev() would only return EAGAIN. The next write event will resume.
+        action = PostIoAction::KeepOpen;
+        break;
+      }
     } else {
       ENVOY_CONN_LOG(trace, "write error: {}", callbacks_->connection(),
                      result.err_->getErrorDetails());
@@ -22,6 +22,12 @@ public:
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
 
+  /**
+   * @return true if a write of |bytes| stopped strictly inside one of |slices|. A writev() only
+   * does that when the socket send buffer has filled up.
+   */
+  static bool endsInsideSlice(uint64_t bytes, const Buffer::RawSlice* slices, uint64_t num_slices);
+
 private:
   TransportSocketCallbacks* callbacks_{};
   bool shutdown_{};
@@ -32,7 +32,8 @@ static const uint64_t MAX_UDP_PACKET_SIZE = 1500;
 
 UdpListenerImpl::UdpListenerImpl(Event::DispatcherImpl& dispatcher, Socket& socket,
                                  UdpListenerCallbacks& cb, TimeSource& time_source)
-    : BaseListenerImpl(dispatcher, socket), cb_(cb), time_source_(time_source) {
+    : BaseListenerImpl(dispatcher, socket), cb_(cb), time_source_(time_source),
+      recv_mmsg_output_(MAX_NUM_PACKETS_PER_MMSG_CALL, &packets_dropped_) {
   file_event_ = dispatcher_.createFileEvent(
       socket.ioHandle().fd(), [this](uint32_t events) -> void { onSocketEvent(events); },
       Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
@@ -72,74 +73,142 @@ void UdpListenerImpl::onSocketEvent(short flags) {
 
 void UdpListenerImpl::handleReadCallback() {
   ENVOY_UDP_LOG(trace, "handleReadCallback");
+  if (socket_.ioHandle().supportsMmsg()) {
+    while (readPacketBatch()) {
+    }
+  } else {
+    while (readPacket()) {
+    }
+  }
+}
+
+bool UdpListenerImpl::readPacket() {
   // TODO(danzh) make this variable configurable to support jumbo frames.
   const uint64_t read_buffer_length = MAX_UDP_PACKET_SIZE;
-  do {
-    Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
-    Buffer::RawSlice slice;
-    const uint64_t num_slices = buffer->reserve(read_buffer_length, &slice, 1);
-    ASSERT(num_slices == 1);
+  Buffer::InstancePtr buffer = std::make_unique<Buffer::OwnedImpl>();
+  Buffer::RawSlice slice;
+  const uint64_t num_slices = buffer->reserve(read_buffer_length, &slice, 1);
+  ASSERT(num_slices == 1);
+
+  IoHandle::RecvMsgOutput output(&packets_dropped_);
+  uint32_t old_packets_dropped = packets_dropped_;
+  MonotonicTime receive_time = time_source_.monotonicTime();
+  Api::IoCallUint64Result result = socket_.ioHandle().recvmsg(
+      &slice, num_slices, socket_.localAddress()->ip()->port(), output);
+
+  if (!result.ok()) {
+    handleReadError(result);
+    return false;
+  }
 
-    IoHandle::RecvMsgOutput output(&packets_dropped_);
-    uint32_t old_packets_dropped = packets_dropped_;
-    MonotonicTime receive_time = time_source_.monotonicTime();
-    Api::IoCallUint64Result result = socket_.ioHandle().recvmsg(
-        &slice, num_slices, socket_.localAddress()->ip()->port(), output);
-
-    if (!result.ok()) {
-      // No more to read or encountered a system error.
-      if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
-        ENVOY_UDP_LOG(error, "recvmsg result {}: {}", static_cast<int>(result.err_->getErrorCode()),
-                      result.err_->getErrorDetails());
-        cb_.onReceiveError(UdpListenerCallbacks::ErrorCode::SyscallError,
-                           result.err_->getErrorCode());
-      }
-      // Stop reading.
-      return;
-    }
+  logPacketsDropped(old_packets_dropped);
 
-    if (result.rc_ == 0) {
-      // TODO(conqerAtapple): Is zero length packet interesting? If so add stats
-      // for it. Otherwise remove the warning log below.
-      ENVOY_UDP_LOG(trace, "received 0-length packet");
-    }
+  // Adjust used memory length.
+  slice.len_ = std::min(slice.len_, static_cast<size_t>(result.rc_));
+  buffer->commit(&slice, 1);
+
+  ENVOY_UDP_LOG(trace, "recvmsg bytes {}", result.rc_);
 
-    RELEASE_ASSERT(output.local_address_ != nullptr, "fail to get local address from IP header");
-
-    if (packets_dropped_ != old_packets_dropped) {
-      // The kernel tracks SO_RXQ_OVFL as a uint32 which can overflow to a smaller
-      // value. So as long as this count differs from previously recorded value,
-      // more packets are dropped by kernel.
-      uint32_t delta = (packets_dropped_ > old_packets_dropped)
-                           ? (packets_dropped_ - old_packets_dropped)
-                           : (packets_dropped_ +
-                              (std::numeric_limits<uint32_t>::max() - old_packets_dropped) + 1);
-      // TODO(danzh) add stats for this.
-      ENVOY_UDP_LOG(debug, "Kernel dropped {} more packets. Consider increase receive buffer size.",
-                    delta);
+  passPacketToCallbacks(std::move(output.local_address_), std::move(output.peer_address_),
+                        std::move(buffer), receive_time);
+  return true;
+}
+
+bool UdpListenerImpl::readPacketBatch() {
+  // TODO(danzh) make this variable configurable to support jumbo frames.
+  const uint64_t read_buffer_length = MAX_UDP_PACKET_SIZE;
+  Buffer::RawSlice slices[MAX_NUM_PACKETS_PER_MMSG_CALL];
+  for (uint64_t i = 0; i < MAX_NUM_PACKETS_PER_MMSG_CALL; i++) {
+    // Buffers which didn't receive a packet in the previous call are reused, so only the packets
+    // actually handed to the callbacks cost an allocation.
+    if (batch_buffers_[i] == nullptr) {
+      batch_buffers_[i] = std::make_unique<Buffer::OwnedImpl>();
     }
+    const uint64_t num_slices = batch_buffers_[i]->reserve(read_buffer_length, &slices[i], 1);
+    ASSERT(num_slices == 1);
+  }
+
+  uint32_t old_packets_dropped = packets_dropped_;
+  MonotonicTime receive_time = time_source_.monotonicTime();
+  Api::IoCallUint64Result result =
+      socket_.ioHandle().recvmmsg(slices, MAX_NUM_PACKETS_PER_MMSG_CALL,
+                                  socket_.localAddress()->ip()->port(), recv_mmsg_output_);
 
+  if (!result.ok()) {
+    handleReadError(result);
+    return false;
+  }
+
+  logPacketsDropped(old_packets_dropped);
+
+  const uint64_t num_packets_read = result.rc_;
+  ENVOY_UDP_LOG(trace, "recvmmsg read {} packets", num_packets_read);
+  for (uint64_t i = 0; i < num_packets_read; i++) {
+    IoHandle::RecvMmsgOutput::PacketInfo& packet = recv_mmsg_output_.packets_[i];
     // Adjust used memory length.
-    slice.len_ = std::min(slice.len_, static_cast<size_t>(result.rc_));
-    buffer->commit(&slice, 1);
-
-    ENVOY_UDP_LOG(trace, "recvmsg bytes {}", result.rc_);
-
-    RELEASE_ASSERT(output.peer_address_ != nullptr,
-                   fmt::format("Unable to get remote address for fd: {}, local address: {} ",
-                               socket_.ioHandle().fd(), socket_.localAddress()->asString()));
-
-    // Unix domain sockets are not supported
-    RELEASE_ASSERT(output.peer_address_->type() == Address::Type::Ip,
-                   fmt::format("Unsupported remote address: {} local address: {}, receive size: "
-                               "{}",
-                               output.peer_address_->asString(), socket_.localAddress()->asString(),
-                               result.rc_));
-
-    UdpRecvData recvData{std::move(output.local_address_), std::move(output.peer_address_),
-                         std::move(buffer), receive_time};
-    cb_.onData(recvData);
-  } while (true);
+    slices[i].len_ = std::min(slices[i].len_, static_cast<size_t>(packet.msg_len_));
+    batch_buffers_[i]->commit(&slices[i], 1);
+
+    ENVOY_UDP_LOG(trace, "recvmmsg bytes {}", packet.msg_len_);
+
+    passPacketToCallbacks(std::move(packet.local_address_), std::move(packet.peer_address_),
+                          std::move(batch_buffers_[i]), receive_time);
+  }
+  // A partially filled batch means the socket has been drained, so skip the recvmmsg() call
+  // which would only return EAGAIN.
+  return num_packets_read == MAX_NUM_PACKETS_PER_MMSG_CALL;
+}
+
+void UdpListenerImpl::handleReadError(const Api::IoCallUint64Result& result) {
+  // No more to read or encountered a system error.
+  if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+    ENVOY_UDP_LOG(error, "recvmsg result {}: {}", static_cast<int>(result.err_->getErrorCode()),
+                  result.err_->getErrorDetails());
+    cb_.onReceiveError(UdpListenerCallbacks::ErrorCode::SyscallError, result.err_->getErrorCode());
+  }
+}
+
+void UdpListenerImpl::logPacketsDropped(uint32_t old_packets_dropped) {
+  if (packets_dropped_ != old_packets_dropped) {
+    // The kernel tracks SO_RXQ_OVFL as a uint32 which can overflow to a smaller
+    // value. So as long as this count differs from previously recorded value,
+    // more packets are dropped by kernel.
+    uint32_t delta = (packets_dropped_ > old_packets_dropped)
+                         ? (packets_dropped_ - old_packets_dropped)
+                         : (packets_dropped_ +
+                            (std::numeric_limits<uint32_t>::max() - old_packets_dropped) + 1);
+    // TODO(danzh) add stats for this.
+    ENVOY_UDP_LOG(debug, "Kernel dropped {} more packets. Consider increase receive buffer size.",
+                  delta);
+  }
+}
+
+void UdpListenerImpl::passPacketToCallbacks(Address::InstanceConstSharedPtr local_address,
+                                            Address::InstanceConstSharedPtr peer_address,
+                                            Buffer::InstancePtr buffer,
+                                            MonotonicTime receive_time) {
+  if (buffer->length() == 0) {
+    // TODO(conqerAtapple): Is zero length packet interesting? If so add stats
+    // for it. Otherwise remove the warning log below.
+    ENVOY_UDP_LOG(trace, "received 0-length packet");
+  }
+
+  RELEASE_ASSERT(local_address != nullptr, "fail to get local address from IP header");
+
+  RELEASE_ASSERT(peer_address != nullptr,
+                 fmt::format("Unable to get remote address for fd: {}, local address: {} ",
+                             socket_.ioHandle().fd(), socket_.localAddress()->asString()));
+
+  // Unix domain sockets are not supported
+  RELEASE_ASSERT(peer_address->type() == Address::Type::Ip,
+                 fmt::format("Unsupported remote address: {} local address: {}, receive size: "
+                             "{}",
+                             peer_address->asString(), socket_.localAddress()->asString(),
+                             buffer->length()));
+
+  UdpRecvData recvData{std::move(local_address), std::move(peer_address), std::move(buffer),
+                       receive_time};
+  cb_.onData(recvData);
 }
 
 void UdpListenerImpl::handleWriteCallback() {
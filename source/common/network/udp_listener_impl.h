@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 
 #include "envoy/common/time.h"
@@ -43,9 +44,26 @@ protected:
 
 private:
   void onSocketEvent(short flags);
+  // Reads a single packet with recvmsg(). Returns true if the socket may have more to read.
+  bool readPacket();
+  // Reads up to a batch of packets with recvmmsg(). Returns true if the socket may have more to
+  // read.
+  bool readPacketBatch();
+  void handleReadError(const Api::IoCallUint64Result& result);
+  void logPacketsDropped(uint32_t old_packets_dropped);
+  void passPacketToCallbacks(Address::InstanceConstSharedPtr local_address,
+                             Address::InstanceConstSharedPtr peer_address,
+                             Buffer::InstancePtr buffer, MonotonicTime receive_time);
+
+  // Max number of packets read by a single recvmmsg() call.
+  static constexpr uint64_t MAX_NUM_PACKETS_PER_MMSG_CALL = 16;
 
   TimeSource& time_source_;
   Event::FileEventPtr file_event_;
+  // Receive buffers for readPacketBatch(). Entries are handed to the callbacks as packets arrive.
+  std::array<Buffer::InstancePtr, MAX_NUM_PACKETS_PER_MMSG_CALL> batch_buffers_;
+  // Per packet results of readPacketBatch(), kept across calls to avoid an allocation per read.
+  IoHandle::RecvMmsgOutput recv_mmsg_output_;
 };
 
 } // namespace Network
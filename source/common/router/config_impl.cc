@@ -980,18 +980,28 @@ VirtualHostImpl::VirtualHostImpl(const envoy::api::v2::route::VirtualHost& virtu
   }
 
   for (const auto& route : virtual_host.routes()) {
+    const uint32_t position = routes_.size();
+    const bool case_sensitive =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(route.match(), case_sensitive, true);
     switch (route.match().path_specifier_case()) {
     case envoy::api::v2::route::RouteMatch::kPrefix: {
       routes_.emplace_back(new PrefixRouteEntryImpl(*this, route, factory_context));
+      path_match_index_.addPrefix(route.match().prefix(), case_sensitive, position);
       break;
     }
     case envoy::api::v2::route::RouteMatch::kPath: {
       routes_.emplace_back(new PathRouteEntryImpl(*this, route, factory_context));
+      path_match_index_.addPath(route.match().path(), case_sensitive, position);
+      break;
+    }
+    case envoy::api::v2::route::RouteMatch::kRegex: {
+      routes_.emplace_back(new RegexRouteEntryImpl(*this, route, factory_context));
+      path_match_index_.addUnindexed(position);
       break;
     }
-    case envoy::api::v2::route::RouteMatch::kRegex:
     case envoy::api::v2::route::RouteMatch::kSafeRegex: {
       routes_.emplace_back(new RegexRouteEntryImpl(*this, route, factory_context));
+      path_match_index_.addRegex(route.match().safe_regex(), position);
       break;
     }
     case envoy::api::v2::route::RouteMatch::PATH_SPECIFIER_NOT_SET:
@@ -1009,6 +1019,8 @@ VirtualHostImpl::VirtualHostImpl(const envoy::api::v2::route::VirtualHost& virtu
     }
   }
 
+  path_match_index_.compile();
+
   for (const auto& virtual_cluster : virtual_host.virtual_clusters()) {
     virtual_clusters_.push_back(VirtualClusterEntry(virtual_cluster, stat_name_pool_));
   }
@@ -1123,9 +1135,18 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const Http::HeaderMap&
     return SSL_REDIRECT_ROUTE;
   }
 
-  // Check for a route that matches the request.
-  for (const RouteEntryImplBaseConstSharedPtr& route : routes_) {
-    RouteConstSharedPtr route_entry = route->matches(headers, random_value);
+  // A request without a :path cannot match any route, and there is nothing to look up without
+  // routes.
+  if (routes_.empty() || headers.Path() == nullptr) {
+    return nullptr;
+  }
+
+  // Check for a route that matches the request. Routes whose path criterion cannot match are
+  // skipped, the remaining ones are evaluated in configuration order.
+  PathMatchIndex::Candidates candidates;
+  path_match_index_.candidates(headers.Path()->value().getStringView(), candidates);
+  for (const uint32_t position : candidates) {
+    RouteConstSharedPtr route_entry = routes_[position]->matches(headers, random_value);
     if (nullptr != route_entry) {
       return route_entry;
     }
@@ -23,6 +23,7 @@
 #include "common/router/header_formatter.h"
 #include "common/router/header_parser.h"
 #include "common/router/metadatamatchcriteria_impl.h"
+#include "common/router/path_match_index.h"
 #include "common/router/router_ratelimit.h"
 #include "common/stats/symbol_table_impl.h"
 
@@ -202,6 +203,7 @@ private:
   Stats::StatNamePool stat_name_pool_;
   const Stats::StatName stat_name_;
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  PathMatchIndex path_match_index_;
   std::vector<VirtualClusterEntry> virtual_clusters_;
   SslRequirements ssl_requirements_;
   const RateLimitPolicyImpl rate_limit_policy_;
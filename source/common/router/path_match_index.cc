@@ -0,0 +1,151 @@
+#include "common/router/path_match_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Router {
+
+namespace {
+
+template <class Children> auto lowerBoundChild(Children& children, char first) {
+  return std::lower_bound(children.begin(), children.end(), first,
+                          [](const auto& child, char c) { return child->label_[0] < c; });
+}
+
+} // namespace
+
+void PathMatchIndex::PrefixTrie::add(absl::string_view prefix, uint32_t position) {
+  Node* node = &root_;
+  std::string key(prefix);
+  if (ignore_case_) {
+    absl::AsciiStrToLower(&key);
+  }
+  absl::string_view rest = key;
+
+  while (!rest.empty()) {
+    auto it = lowerBoundChild(node->children_, rest[0]);
+    if (it == node->children_.end() || (*it)->label_[0] != rest[0]) {
+      auto child = std::make_unique<Node>();
+      child->label_ = std::string(rest);
+      child->positions_.push_back(position);
+      node->children_.insert(it, std::move(child));
+      return;
+    }
+
+    Node& child = **it;
+    const auto mismatch = std::mismatch(child.label_.begin(), child.label_.end(), rest.begin(),
+                                        rest.end());
+    const size_t common = mismatch.first - child.label_.begin();
+    ASSERT(common > 0);
+    if (common < child.label_.size()) {
+      // Split the edge: the new node takes the common part and the existing child keeps the rest.
+      auto middle = std::make_unique<Node>();
+      middle->label_ = child.label_.substr(0, common);
+      child.label_.erase(0, common);
+      middle->children_.push_back(std::move(*it));
+      *it = std::move(middle);
+    }
+    node = it->get();
+    rest.remove_prefix(common);
+  }
+  node->positions_.push_back(position);
+}
+
+void PathMatchIndex::PrefixTrie::findPrefixesOf(absl::string_view key,
+                                                Candidates& positions) const {
+  const Node* node = &root_;
+  size_t offset = 0;
+  while (true) {
+    positions.insert(positions.end(), node->positions_.begin(), node->positions_.end());
+    if (offset == key.size()) {
+      return;
+    }
+    auto it = lowerBoundChild(node->children_, fold(key[offset]));
+    if (it == node->children_.end()) {
+      return;
+    }
+    const std::string& label = (*it)->label_;
+    if (key.size() - offset < label.size()) {
+      return;
+    }
+    for (size_t i = 0; i < label.size(); i++) {
+      if (fold(key[offset + i]) != label[i]) {
+        return;
+      }
+    }
+    offset += label.size();
+    node = it->get();
+  }
+}
+
+void PathMatchIndex::addPrefix(absl::string_view prefix, bool case_sensitive, uint32_t position) {
+  (case_sensitive ? prefixes_ : prefixes_ignore_case_).add(prefix, position);
+}
+
+void PathMatchIndex::addPath(absl::string_view path, bool case_sensitive, uint32_t position) {
+  if (case_sensitive) {
+    paths_[std::string(path)].push_back(position);
+  } else {
+    paths_ignore_case_[absl::AsciiStrToLower(path)].push_back(position);
+  }
+}
+
+void PathMatchIndex::addRegex(const envoy::type::matcher::RegexMatcher& matcher,
+                              uint32_t position) {
+  regexes_.add(matcher);
+  regex_positions_.push_back(position);
+}
+
+void PathMatchIndex::addUnindexed(uint32_t position) { unindexed_.push_back(position); }
+
+void PathMatchIndex::compile() {
+  if (regexes_.size() > 0) {
+    regexes_.compile();
+  }
+}
+
+void PathMatchIndex::candidates(absl::string_view path, Candidates& candidates) const {
+  Candidates indexed;
+  prefixes_.findPrefixesOf(path, indexed);
+  if (!prefixes_ignore_case_.empty()) {
+    prefixes_ignore_case_.findPrefixesOf(path, indexed);
+  }
+
+  // Exact path matches ignore the query string.
+  const absl::string_view path_only = path.substr(0, path.find('?'));
+  if (!paths_.empty()) {
+    auto it = paths_.find(path_only);
+    if (it != paths_.end()) {
+      indexed.insert(indexed.end(), it->second.begin(), it->second.end());
+    }
+  }
+  if (!paths_ignore_case_.empty()) {
+    auto it = paths_ignore_case_.find(absl::AsciiStrToLower(path_only));
+    if (it != paths_ignore_case_.end()) {
+      indexed.insert(indexed.end(), it->second.begin(), it->second.end());
+    }
+  }
+
+  if (regexes_.size() > 0) {
+    std::vector<int> matches;
+    if (regexes_.match(path_only, matches)) {
+      for (const int index : matches) {
+        indexed.push_back(regex_positions_[index]);
+      }
+    } else {
+      // The regex set ran out of memory, every regex route has to be evaluated on its own.
+      indexed.insert(indexed.end(), regex_positions_.begin(), regex_positions_.end());
+    }
+  }
+
+  // Every route is in exactly one of the structures above, so there are no duplicates to remove.
+  std::sort(indexed.begin(), indexed.end());
+  std::merge(indexed.begin(), indexed.end(), unindexed_.begin(), unindexed_.end(),
+             std::back_inserter(candidates));
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/type/matcher/regex.pb.h"
+
+#include "common/common/regex.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path match criteria of an ordered list of routes. Given a request path it yields
+ * the positions of all routes whose path criterion can match it, in route order, so that only
+ * those routes have to be evaluated. Prefix criteria are kept in radix tries and exact paths in
+ * hash maps. RE2 regular expressions are compiled into one set that is matched in a single pass.
+ * Routes whose path criterion cannot be indexed (std::regex expressions) are always candidates.
+ * The remaining conditions of a route (headers, query parameters, runtime, ...) are not looked at
+ * here and still have to be checked by evaluating the route itself, so evaluating
+ * the candidates in order and stopping at the first match gives the same result as evaluating
+ * every route in order.
+ */
+class PathMatchIndex {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * Add a route that matches paths starting with prefix.
+   * @param prefix supplies the path prefix.
+   * @param case_sensitive supplies whether the prefix is compared case sensitively.
+   * @param position supplies the position of the route. Positions must be added in increasing
+   *        order across all add*() calls.
+   */
+  void addPrefix(absl::string_view prefix, bool case_sensitive, uint32_t position);
+
+  /**
+   * Add a route that matches one exact path, ignoring the query string of the request.
+   * @param path supplies the path.
+   * @param case_sensitive supplies whether the path is compared case sensitively.
+   * @param position supplies the position of the route.
+   */
+  void addPath(absl::string_view path, bool case_sensitive, uint32_t position);
+
+  /**
+   * Add a route that matches paths against a regular expression, ignoring the query string of the
+   * request. All such routes are matched together in a single pass.
+   * @param matcher supplies the regex match config. It must use the Google RE2 engine.
+   * @param position supplies the position of the route.
+   */
+  void addRegex(const envoy::type::matcher::RegexMatcher& matcher, uint32_t position);
+
+  /**
+   * Add a route that has to be evaluated for every request path.
+   * @param position supplies the position of the route.
+   */
+  void addUnindexed(uint32_t position);
+
+  /**
+   * Build the index once all routes are added.
+   */
+  void compile();
+
+  /**
+   * Find the routes that may match a request path.
+   * @param path supplies the :path header value, including the query string.
+   * @param candidates supplies the vector the route positions are appended to, in increasing
+   *        order.
+   */
+  void candidates(absl::string_view path, Candidates& candidates) const;
+
+private:
+  // A radix trie mapping prefixes to the positions of the routes using them. Each node owns the
+  // part of the key on the edge leading to it.
+  class PrefixTrie {
+  public:
+    explicit PrefixTrie(bool ignore_case) : ignore_case_(ignore_case) {}
+
+    bool empty() const { return root_.positions_.empty() && root_.children_.empty(); }
+    void add(absl::string_view prefix, uint32_t position);
+    // Appends the positions of all prefixes of key, shortest prefix first.
+    void findPrefixesOf(absl::string_view key, Candidates& positions) const;
+
+  private:
+    struct Node {
+      std::string label_;
+      std::vector<uint32_t> positions_;
+      // Sorted by the first character of their label, which is unique among siblings.
+      std::vector<std::unique_ptr<Node>> children_;
+    };
+
+    char fold(char c) const { return ignore_case_ ? absl::ascii_tolower(c) : c; }
+
+    const bool ignore_case_;
+    Node root_;
+  };
+
+  using PathMap = absl::flat_hash_map<std::string, std::vector<uint32_t>>;
+
+  PrefixTrie prefixes_{false};
+  PrefixTrie prefixes_ignore_case_{true};
+  PathMap paths_;
+  PathMap paths_ignore_case_;
+  Regex::GoogleReMatcherSet regexes_;
+  // Route positions by index in regexes_.
+  std::vector<uint32_t> regex_positions_;
+  std::vector<uint32_t> unindexed_;
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -713,6 +713,7 @@ void Filter::onResponseTimeout() {
       if (!upstream_request->outlier_detection_timeout_recorded_) {
         updateOutlierDetection(Upstream::Outlier::Result::LOCAL_ORIGIN_TIMEOUT, *upstream_request,
                                absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
+        updateLatencyMonitorOnFailure(*upstream_request);
       }
 
       chargeUpstreamAbort(timeout_response_code_, false, *upstream_request);
@@ -731,6 +732,7 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
   // cancel the request yet and might get a 2xx later.
   updateOutlierDetection(Upstream::Outlier::Result::LOCAL_ORIGIN_TIMEOUT, upstream_request,
                          absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
+  updateLatencyMonitorOnFailure(upstream_request);
   upstream_request.outlier_detection_timeout_recorded_ = true;
 
   if (!downstream_response_started_ && retry_state_) {
@@ -769,6 +771,7 @@ void Filter::onPerTryTimeout(UpstreamRequest& upstream_request) {
 
   updateOutlierDetection(Upstream::Outlier::Result::LOCAL_ORIGIN_TIMEOUT, upstream_request,
                          absl::optional<uint64_t>(enumToInt(timeout_response_code_)));
+  updateLatencyMonitorOnFailure(upstream_request);
 
   if (maybeRetryReset(Http::StreamResetReason::LocalReset, upstream_request)) {
     return;
@@ -790,6 +793,23 @@ void Filter::updateOutlierDetection(Upstream::Outlier::Result result,
   }
 }
 
+void Filter::updateLatencyMonitorOnFailure(UpstreamRequest& upstream_request) {
+  if (cluster_->lbType() != Upstream::LoadBalancerType::PeakEwma ||
+      !upstream_request.upstream_host_) {
+    return;
+  }
+
+  // Requests that failed before being sent, such as on connection failures, count as failing at
+  // once. The latency monitor applies its failure penalty either way.
+  const MonotonicTime now = callbacks_->dispatcher().timeSource().monotonicTime();
+  const absl::optional<MonotonicTime>& sent =
+      upstream_request.upstream_timing_.first_upstream_tx_byte_sent_;
+  upstream_request.upstream_host_->latencyMonitor().putFailure(
+      std::chrono::duration_cast<std::chrono::microseconds>(sent ? now - sent.value()
+                                                                 : MonotonicTime::duration(0)),
+      now);
+}
+
 void Filter::chargeUpstreamAbort(Http::Code code, bool dropped, UpstreamRequest& upstream_request) {
   if (downstream_response_started_) {
     if (upstream_request.grpc_rq_success_deferred_) {
@@ -882,6 +902,10 @@ void Filter::onUpstreamReset(Http::StreamResetReason reset_reason,
   // param set to true.
   updateOutlierDetection(Upstream::Outlier::Result::LOCAL_ORIGIN_CONNECT_FAILED, upstream_request,
                          absl::nullopt);
+  // Overflows come from the local circuit breakers rather than from the host.
+  if (reset_reason != Http::StreamResetReason::Overflow) {
+    updateLatencyMonitorOnFailure(upstream_request);
+  }
 
   if (maybeRetryReset(reset_reason, upstream_request)) {
     return;
@@ -1180,6 +1204,18 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
   }
   callbacks_->streamInfo().setUpstreamTiming(final_upstream_request_->upstream_timing_);
 
+  // Feed the response time of the request to latency aware load balancing.
+  const StreamInfo::UpstreamTiming& upstream_timing = upstream_request.upstream_timing_;
+  if (cluster_->lbType() == Upstream::LoadBalancerType::PeakEwma &&
+      upstream_timing.first_upstream_tx_byte_sent_ &&
+      upstream_timing.last_upstream_rx_byte_received_) {
+    upstream_request.upstream_host_->latencyMonitor().putResponseTime(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            upstream_timing.last_upstream_rx_byte_received_.value() -
+            upstream_timing.first_upstream_tx_byte_sent_.value()),
+        upstream_timing.last_upstream_rx_byte_received_.value());
+  }
+
   if (config_.emit_dynamic_stats_ && !callbacks_->streamInfo().healthCheck() &&
       DateUtil::timePointValid(downstream_request_complete_time_)) {
     Event::Dispatcher& dispatcher = callbacks_->dispatcher();
@@ -117,11 +117,49 @@ private:
   std::atomic<uint64_t> pending_increment_{0};
 };
 
+// Counter whose value is kept in the shards of the allocator, so that threads incrementing it
+// concurrently do not contend. value_ holds the sum of the shards as of the last reset(), which
+// is subtracted from the sum to get the value.
+class ShardedCounterImpl : public StatsSharedImpl<Counter> {
+public:
+  ShardedCounterImpl(StatName name, AllocatorImpl& alloc, absl::string_view tag_extracted_name,
+                     const std::vector<Tag>& tags, CounterShards& shards, uint32_t slot)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, tags), shards_(shards), slot_(slot) {}
+  ~ShardedCounterImpl() override {
+    alloc_.removeCounterFromSet(this);
+    shards_.freeSlot(slot_);
+  }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    shards_.add(slot_, amount);
+    // Only write flags_ once, as writing it on every increment would have all threads contend for
+    // its cache line again.
+    if (!(flags_.load(std::memory_order_relaxed) & Flags::Used)) {
+      flags_ |= Flags::Used;
+    }
+  }
+  void inc() override { add(1); }
+  uint64_t latch() override {
+    const uint64_t sum = shards_.sum(slot_);
+    return sum - latched_sum_.exchange(sum);
+  }
+  void reset() override { value_ = shards_.sum(slot_); }
+  uint64_t value() const override { return shards_.sum(slot_) - value_; }
+
+private:
+  CounterShards& shards_;
+  const uint32_t slot_;
+  // The sum of the shards as of the last latch().
+  std::atomic<uint64_t> latched_sum_{0};
+};
+
 class GaugeImpl : public StatsSharedImpl<Gauge> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, absl::string_view tag_extracted_name,
             const std::vector<Tag>& tags, ImportMode import_mode)
       : StatsSharedImpl(name, alloc, tag_extracted_name, tags) {
+    flags_ |= Flags::Changed;
     switch (import_mode) {
     case ImportMode::Accumulate:
       flags_ |= Flags::LogicAccumulate;
@@ -140,22 +178,28 @@ public:
   ~GaugeImpl() override { alloc_.removeGaugeFromSet(this); }
 
   // Stats::Gauge
+  // The Changed flag is set along with the Used flag, which costs no extra atomic operation.
   void add(uint64_t amount) override {
     value_ += amount;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
-    value_ = value;
-    flags_ |= Flags::Used;
+    // Many gauges are set to the same value over and over, which is not a change.
+    const bool changed = value_.exchange(value) != value;
+    flags_ |= changed ? Flags::Used | Flags::Changed : Flags::Used;
   }
   void sub(uint64_t amount) override {
     ASSERT(value_ >= amount);
     ASSERT(used() || amount == 0);
     value_ -= amount;
+    flags_ |= Flags::Changed;
   }
   uint64_t value() const override { return value_; }
+  bool latchChanged() override {
+    return flags_.fetch_and(static_cast<uint16_t>(~Flags::Changed)) & Flags::Changed;
+  }
 
   ImportMode importMode() const override {
     if (flags_ & Flags::NeverImport) {
@@ -202,7 +246,16 @@ CounterSharedPtr AllocatorImpl::makeCounter(StatName name, absl::string_view tag
   if (iter != counters_.end()) {
     return CounterSharedPtr(*iter);
   }
-  auto counter = CounterSharedPtr(new CounterImpl(name, *this, tag_extracted_name, tags));
+  // Once all slots are taken, further counters are not sharded.
+  const absl::optional<uint32_t> slot =
+      counter_shards_ != nullptr ? counter_shards_->allocateSlot() : absl::optional<uint32_t>();
+  CounterSharedPtr counter;
+  if (slot) {
+    counter = CounterSharedPtr(
+        new ShardedCounterImpl(name, *this, tag_extracted_name, tags, *counter_shards_, *slot));
+  } else {
+    counter = CounterSharedPtr(new CounterImpl(name, *this, tag_extracted_name, tags));
+  }
   counters_.insert(counter.get());
   return counter;
 }
@@ -6,6 +6,7 @@
 #include "envoy/stats/stats.h"
 #include "envoy/stats/symbol_table.h"
 
+#include "common/stats/counter_shards.h"
 #include "common/stats/metric_impl.h"
 
 #include "absl/container/flat_hash_set.h"
@@ -17,6 +18,16 @@ namespace Stats {
 class AllocatorImpl : public Allocator {
 public:
   AllocatorImpl(SymbolTable& symbol_table) : symbol_table_(symbol_table) {}
+
+  /**
+   * @param symbol_table supplies the symbol table of the stats.
+   * @param counter_shards supplies the number of shards to spread the increments of each counter
+   *        over, rounded up to a power of 2. Values below 2 keep counters unsharded.
+   */
+  AllocatorImpl(SymbolTable& symbol_table, uint32_t counter_shards)
+      : symbol_table_(symbol_table),
+        counter_shards_(counter_shards > 1 ? std::make_unique<CounterShards>(counter_shards)
+                                           : nullptr) {}
   ~AllocatorImpl() override;
 
   void removeCounterFromSet(Counter* counter);
@@ -60,6 +71,9 @@ private:
 
   SymbolTable& symbol_table_;
 
+  // Storage of the values of sharded counters, or nullptr if counters are not sharded.
+  std::unique_ptr<CounterShards> counter_shards_;
+
   // A mutex is needed here to protect both the stats_ object from both
   // alloc() and free() operations. Although alloc() operations are called under existing locking,
   // free() operations are made from the destructors of the individual stat objects, which are not
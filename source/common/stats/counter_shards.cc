@@ -0,0 +1,80 @@
+#include "common/stats/counter_shards.h"
+
+#include "common/common/assert.h"
+#include "common/common/lock_guard.h"
+
+namespace Envoy {
+namespace Stats {
+
+constexpr uint32_t CounterShards::SlotsPerChunk;
+constexpr uint32_t CounterShards::MaxChunks;
+constexpr uint32_t CounterShards::PaddingSlots;
+
+namespace {
+
+uint32_t roundUpToPowerOf2(uint32_t value) {
+  uint32_t power = 1;
+  while (power < value) {
+    power <<= 1;
+  }
+  return power;
+}
+
+} // namespace
+
+CounterShards::CounterShards(uint32_t num_shards)
+    : shard_mask_(roundUpToPowerOf2(num_shards) - 1),
+      chunks_(new std::atomic<Value*>[MaxChunks]()) {}
+
+CounterShards::~CounterShards() {
+  for (uint32_t i = 0; i < MaxChunks; ++i) {
+    delete[] chunks_[i].load(std::memory_order_relaxed);
+  }
+}
+
+uint32_t CounterShards::threadShard() {
+  static std::atomic<uint32_t> next_thread_shard{0};
+  thread_local const uint32_t thread_shard = next_thread_shard++;
+  return thread_shard;
+}
+
+absl::optional<uint32_t> CounterShards::allocateSlot() {
+  Thread::LockGuard lock(mutex_);
+  if (!free_slots_.empty()) {
+    const uint32_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+  }
+
+  if (num_slots_ == num_chunks_ * SlotsPerChunk) {
+    if (num_chunks_ == MaxChunks) {
+      return absl::nullopt;
+    }
+    // Value-initialization zeroes the values.
+    chunks_[num_chunks_].store(new Value[numShards() * (SlotsPerChunk + PaddingSlots)](),
+                               std::memory_order_release);
+    ++num_chunks_;
+  }
+  return num_slots_++;
+}
+
+void CounterShards::freeSlot(uint32_t slot) {
+  for (uint32_t shard = 0; shard < numShards(); ++shard) {
+    value(slot, shard).store(0, std::memory_order_relaxed);
+  }
+
+  Thread::LockGuard lock(mutex_);
+  ASSERT(slot < num_slots_);
+  free_slots_.push_back(slot);
+}
+
+uint64_t CounterShards::sum(uint32_t slot) const {
+  uint64_t sum = 0;
+  for (uint32_t shard = 0; shard < numShards(); ++shard) {
+    sum += value(slot, shard).load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+} // namespace Stats
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/common/thread.h"
+#include "common/common/thread_annotations.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Storage for the values of sharded counters. Each counter is given a slot, which has a value in
+ * every shard. A thread always adds to the same shard, and different threads are spread over the
+ * shards, so that threads incrementing the same counter do not contend for its cache line. Reading
+ * a counter sums its values over all shards.
+ *
+ * The values of a shard are laid out next to each other in chunks of slots, rather than next to
+ * the values of the other shards, so that each counter takes 8 bytes per shard rather than a cache
+ * line per shard.
+ */
+class CounterShards {
+public:
+  /**
+   * @param num_shards supplies the number of shards, which is rounded up to a power of 2.
+   */
+  explicit CounterShards(uint32_t num_shards);
+  ~CounterShards();
+
+  /**
+   * Allocate a slot, whose values are all 0.
+   * @return the slot, or absl::nullopt if there are no more slots.
+   */
+  absl::optional<uint32_t> allocateSlot();
+
+  /**
+   * Free a slot so that it can be reused. The slot must no longer be added to.
+   * @param slot supplies the slot.
+   */
+  void freeSlot(uint32_t slot);
+
+  /**
+   * Add to the value of a slot in the shard of the calling thread.
+   * @param slot supplies the slot.
+   * @param amount supplies the amount to add.
+   */
+  void add(uint32_t slot, uint64_t amount) {
+    value(slot, threadShard() & shard_mask_).fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @param slot supplies the slot.
+   * @return the sum of the values of a slot over all shards.
+   */
+  uint64_t sum(uint32_t slot) const;
+
+  uint32_t numShards() const { return shard_mask_ + 1; }
+
+  static constexpr uint32_t SlotsPerChunk = 512;
+  static constexpr uint32_t MaxChunks = 8192;
+
+private:
+  // Values between the ones of two shards in a chunk, so that they do not share a cache line.
+  static constexpr uint32_t PaddingSlots = 8;
+
+  using Value = std::atomic<uint64_t>;
+
+  Value& value(uint32_t slot, uint32_t shard) const {
+    Value* chunk = chunks_[slot / SlotsPerChunk].load(std::memory_order_acquire);
+    return chunk[shard * (SlotsPerChunk + PaddingSlots) + slot % SlotsPerChunk];
+  }
+
+  // The shard of the calling thread, before masking. Threads are given consecutive numbers, so
+  // that up to numShards() threads each have a shard of their own.
+  static uint32_t threadShard();
+
+  const uint32_t shard_mask_;
+  // Chunks are only added, and only freed on destruction, so a slot can be accessed without
+  // locking once it is allocated.
+  std::unique_ptr<std::atomic<Value*>[]> chunks_;
+  Thread::MutexBasicLockable mutex_;
+  uint32_t num_chunks_ GUARDED_BY(mutex_){};
+  uint32_t num_slots_ GUARDED_BY(mutex_){};
+  std::vector<uint32_t> free_slots_ GUARDED_BY(mutex_);
+};
+
+} // namespace Stats
+} // namespace Envoy
@@ -0,0 +1,66 @@
+#include "common/stats/histogram_buckets.h"
+
+namespace Envoy {
+namespace Stats {
+
+constexpr uint32_t HistogramBuckets::NumRows;
+constexpr uint32_t HistogramBuckets::BucketsPerRow;
+
+HistogramBuckets::HistogramBuckets() : rows_(new std::atomic<Row*>[NumRows]()) {}
+
+HistogramBuckets::~HistogramBuckets() {
+  for (uint32_t i = 0; i < NumRows; ++i) {
+    delete rows_[i].load(std::memory_order_relaxed);
+  }
+}
+
+void HistogramBuckets::recordValue(uint64_t value) {
+  if (value == 0) {
+    increment(zeros_recorded_);
+    return;
+  }
+
+  // The row of a value is its number of digits less 1, and its bucket in the row is given by its
+  // 2 most significant digits, as scaled by circllhist.
+  uint32_t row_index = 0;
+  uint64_t row_start = 1;
+  while (value / 10 >= row_start) {
+    row_start *= 10;
+    ++row_index;
+  }
+  const uint64_t mantissa = row_index == 0 ? value * 10 : value / (row_start / 10);
+
+  Row* row = rows_[row_index].load(std::memory_order_relaxed);
+  if (row == nullptr) {
+    row = new Row();
+    rows_[row_index].store(row, std::memory_order_release);
+  }
+  increment(row->recorded_[mantissa - 10]);
+}
+
+void HistogramBuckets::mergeNew(histogram_t* target) {
+  const uint64_t zeros = zeros_recorded_.load(std::memory_order_relaxed);
+  if (zeros != zeros_merged_) {
+    hist_insert_intscale(target, 0, 0, zeros - zeros_merged_);
+    zeros_merged_ = zeros;
+  }
+
+  for (uint32_t row_index = 0; row_index < NumRows; ++row_index) {
+    Row* row = rows_[row_index].load(std::memory_order_acquire);
+    if (row == nullptr) {
+      continue;
+    }
+    for (uint32_t i = 0; i < BucketsPerRow; ++i) {
+      const uint64_t count = row->recorded_[i].load(std::memory_order_relaxed);
+      if (count != row->merged_[i]) {
+        // Inserts (i + 10) * 10^(row_index - 1), the lowest value of the bucket.
+        hist_insert_intscale(target, i + 10, static_cast<int>(row_index) - 1,
+                             count - row->merged_[i]);
+        row->merged_[i] = count;
+      }
+    }
+  }
+}
+
+} // namespace Stats
+} // namespace Envoy
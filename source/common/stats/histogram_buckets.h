@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "circllhist.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Counts of recorded values in the log-linear buckets of circllhist, which keep the two most
+ * significant decimal digits of a value. Values are recorded by a single thread without locking,
+ * and another thread can merge the counts into a circllhist at the same time, without swapping
+ * buffers with the recording thread.
+ *
+ * The buckets of values with the same number of digits form a row, which is allocated the first
+ * time such a value is recorded, so that the memory used grows with the range of the recorded
+ * values rather than with the range of uint64_t.
+ */
+class HistogramBuckets {
+public:
+  HistogramBuckets();
+  ~HistogramBuckets();
+
+  /**
+   * Record a value. This must only be called by one thread.
+   * @param value supplies the value.
+   */
+  void recordValue(uint64_t value);
+
+  /**
+   * Add the values recorded since the previous merge to a histogram. This must only be called by
+   * one thread, which need not be the recording one.
+   * @param target supplies the histogram to add to.
+   */
+  void mergeNew(histogram_t* target);
+
+  // Values of up to 20 digits, as uint64_t values have.
+  static constexpr uint32_t NumRows = 20;
+  // The 2 most significant digits of a value, 10 to 99.
+  static constexpr uint32_t BucketsPerRow = 90;
+
+private:
+  struct Row {
+    // Written by the recording thread only, so incremented without a read-modify-write.
+    std::atomic<uint64_t> recorded_[BucketsPerRow]{};
+    // The counts as of the previous merge, only accessed by the merging thread.
+    uint64_t merged_[BucketsPerRow]{};
+  };
+
+  static void increment(std::atomic<uint64_t>& count) {
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> zeros_recorded_{};
+  uint64_t zeros_merged_{};
+  // Rows are only added, by the recording thread, and only freed on destruction.
+  std::unique_ptr<std::atomic<Row*>[]> rows_;
+};
+
+} // namespace Stats
+} // namespace Envoy
@@ -31,6 +31,7 @@ public:
   uint64_t value() const override { return 0; }
   ImportMode importMode() const override { return ImportMode::NeverImport; }
   void mergeImportMode(ImportMode /* import_mode */) override {}
+  bool latchChanged() override { return false; }
 
   // Metric
   bool used() const override { return false; }
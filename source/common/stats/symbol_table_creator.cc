@@ -6,9 +6,13 @@ namespace Stats {
 bool SymbolTableCreator::initialized_ = false;
 bool SymbolTableCreator::use_fake_symbol_tables_ = true;
 
-SymbolTablePtr SymbolTableCreator::initAndMakeSymbolTable(bool use_fake) {
+SymbolTablePtr SymbolTableCreator::initAndMakeSymbolTable(bool use_fake, uint32_t num_shards) {
   ASSERT(!initialized_ || (use_fake_symbol_tables_ == use_fake));
   use_fake_symbol_tables_ = use_fake;
+  if (!use_fake) {
+    initialized_ = true;
+    return std::make_unique<SymbolTableImpl>(num_shards);
+  }
   return makeSymbolTable();
 }
 
@@ -19,9 +19,10 @@ public:
    * TestUtil::SymbolTableCreatorTestPeer::setUseFakeSymbolTables(use_fakes).
    *
    * @param use_fakes Whether to use fake symbol tables; typically from a command-line option.
+   * @param num_shards The number of shards to split a real symbol table into.
    * @return a SymbolTable.
    */
-  static SymbolTablePtr initAndMakeSymbolTable(bool use_fakes);
+  static SymbolTablePtr initAndMakeSymbolTable(bool use_fakes, uint32_t num_shards = 1);
 
   /**
    * Factory method to create SymbolTables. This is needed to help make it
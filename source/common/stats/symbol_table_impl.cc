@@ -1,7 +1,9 @@
 #include "common/stats/symbol_table_impl.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
 #include <vector>
 
@@ -96,9 +98,23 @@ uint64_t SymbolTableImpl::Encoding::moveToStorage(SymbolTable::Storage symbol_ar
   return sz + StatNameSizeEncodingBytes;
 }
 
-SymbolTableImpl::SymbolTableImpl()
-    // Have to be explicitly initialized, if we want to use the GUARDED_BY macro.
-    : next_symbol_(0), monotonic_counter_(0) {}
+constexpr uint32_t SymbolTableImpl::MaxShards;
+
+namespace {
+
+uint32_t shardBits(uint32_t num_shards) {
+  uint32_t bits = 0;
+  while ((1U << bits) < std::min(num_shards, SymbolTableImpl::MaxShards)) {
+    ++bits;
+  }
+  return bits;
+}
+
+} // namespace
+
+SymbolTableImpl::SymbolTableImpl(uint32_t num_shards)
+    : shard_bits_(shardBits(num_shards)), shard_mask_((1U << shard_bits_) - 1),
+      shards_(new Shard[numShards()]) {}
 
 SymbolTableImpl::~SymbolTableImpl() {
   // To avoid leaks into the symbol table, we expect all StatNames to be freed.
@@ -108,6 +124,17 @@ SymbolTableImpl::~SymbolTableImpl() {
   ASSERT(numSymbols() == 0);
 }
 
+SymbolTableImpl::IndexVec SymbolTableImpl::orderByShard(const IndexVec& shard_indices) const {
+  IndexVec order(shard_indices.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (shard_mask_ != 0) {
+    std::sort(order.begin(), order.end(), [&shard_indices](uint32_t a, uint32_t b) {
+      return shard_indices[a] < shard_indices[b] || (shard_indices[a] == shard_indices[b] && a < b);
+    });
+  }
+  return order;
+}
+
 // TODO(ambuc): There is a possible performance optimization here for avoiding
 // the encoding of IPs / numbers if they appear in stat names. We don't want to
 // waste time symbolizing an integer as an integer, if we can help it.
@@ -116,18 +143,26 @@ void SymbolTableImpl::addTokensToEncoding(const absl::string_view name, Encoding
     return;
   }
 
-  // We want to hold the lock for the minimum amount of time, so we do the
-  // string-splitting and prepare a temp vector of Symbol first.
+  // We want to hold the locks for the minimum amount of time, so we do the
+  // string-splitting, find the shards of the tokens and prepare a temp vector
+  // of Symbol first.
   const std::vector<absl::string_view> tokens = absl::StrSplit(name, '.');
-  std::vector<Symbol> symbols;
-  symbols.reserve(tokens.size());
-
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
-  {
-    Thread::LockGuard lock(lock_);
-    for (auto& token : tokens) {
-      symbols.push_back(toSymbol(token));
+  IndexVec shard_indices;
+  shard_indices.reserve(tokens.size());
+  for (absl::string_view token : tokens) {
+    shard_indices.push_back(tokenShard(token));
+  }
+  std::vector<Symbol> symbols(tokens.size());
+
+  // Now take the lock of each shard once, and populate the Symbol objects of
+  // its tokens, which involves bumping ref-counts in the shard.
+  const IndexVec order = orderByShard(shard_indices);
+  for (auto it = order.begin(); it != order.end();) {
+    const uint32_t shard_index = shard_indices[*it];
+    Shard& shard = shards_[shard_index];
+    Thread::LockGuard lock(shard.lock_);
+    for (; it != order.end() && shard_indices[*it] == shard_index; ++it) {
+      symbols[*it] = toSymbol(shard, tokens[*it]);
     }
   }
 
@@ -138,9 +173,14 @@ void SymbolTableImpl::addTokensToEncoding(const absl::string_view name, Encoding
 }
 
 uint64_t SymbolTableImpl::numSymbols() const {
-  Thread::LockGuard lock(lock_);
-  ASSERT(encode_map_.size() == decode_map_.size());
-  return encode_map_.size();
+  uint64_t num_symbols = 0;
+  for (uint32_t i = 0; i < numShards(); ++i) {
+    Shard& shard = shards_[i];
+    Thread::LockGuard lock(shard.lock_);
+    ASSERT(shard.encode_map_.size() == shard.decode_map_.size());
+    num_symbols += shard.encode_map_.size();
+  }
+  return num_symbols;
 }
 
 std::string SymbolTableImpl::toString(const StatName& stat_name) const {
@@ -152,77 +192,107 @@ void SymbolTableImpl::callWithStringView(StatName stat_name,
   fn(toString(stat_name));
 }
 
+SymbolTableImpl::IndexVec SymbolTableImpl::symbolShards(const SymbolVec& symbols) const {
+  IndexVec shard_indices;
+  shard_indices.reserve(symbols.size());
+  for (Symbol symbol : symbols) {
+    shard_indices.push_back(symbolShard(symbol));
+  }
+  return shard_indices;
+}
+
 std::string SymbolTableImpl::decodeSymbolVec(const SymbolVec& symbols) const {
-  std::vector<absl::string_view> name_tokens;
-  name_tokens.reserve(symbols.size());
-  {
-    // Hold the lock only while decoding symbols.
-    Thread::LockGuard lock(lock_);
-    for (Symbol symbol : symbols) {
-      name_tokens.push_back(fromSymbol(symbol));
+  std::vector<absl::string_view> name_tokens(symbols.size());
+  const IndexVec shard_indices = symbolShards(symbols);
+  const IndexVec order = orderByShard(shard_indices);
+  for (auto it = order.begin(); it != order.end();) {
+    // Hold the lock of each shard only while decoding its symbols.
+    const uint32_t shard_index = shard_indices[*it];
+    Shard& shard = shards_[shard_index];
+    Thread::LockGuard lock(shard.lock_);
+    for (; it != order.end() && shard_indices[*it] == shard_index; ++it) {
+      name_tokens[*it] = fromSymbol(shard, symbols[*it]);
     }
   }
   return absl::StrJoin(name_tokens, ".");
 }
 
 void SymbolTableImpl::incRefCount(const StatName& stat_name) {
-  // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
+  // Before taking the locks, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name.data(), stat_name.dataSize());
+  const IndexVec shard_indices = symbolShards(symbols);
+  const IndexVec order = orderByShard(shard_indices);
 
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
+  for (auto it = order.begin(); it != order.end();) {
+    const uint32_t shard_index = shard_indices[*it];
+    Shard& shard = shards_[shard_index];
+    Thread::LockGuard lock(shard.lock_);
+    for (; it != order.end() && shard_indices[*it] == shard_index; ++it) {
+      auto decode_search = shard.decode_map_.find(symbols[*it]);
+      ASSERT(decode_search != shard.decode_map_.end());
 
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end());
+      auto encode_search = shard.encode_map_.find(decode_search->second->toStringView());
+      ASSERT(encode_search != shard.encode_map_.end());
 
-    ++encode_search->second.ref_count_;
+      ++encode_search->second.ref_count_;
+    }
   }
 }
 
 void SymbolTableImpl::free(const StatName& stat_name) {
-  // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
+  // Before taking the locks, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name.data(), stat_name.dataSize());
-
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
-
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end());
-
-    // If that was the last remaining client usage of the symbol, erase the
-    // current mappings and add the now-unused symbol to the reuse pool.
-    //
-    // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
-    // symbol_table_speed_test.cc, relative to breaking out the decrement into a
-    // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
-      decode_map_.erase(decode_search);
-      encode_map_.erase(encode_search);
-      pool_.push(symbol);
+  const IndexVec shard_indices = symbolShards(symbols);
+  const IndexVec order = orderByShard(shard_indices);
+
+  for (auto it = order.begin(); it != order.end();) {
+    const uint32_t shard_index = shard_indices[*it];
+    Shard& shard = shards_[shard_index];
+    Thread::LockGuard lock(shard.lock_);
+    for (; it != order.end() && shard_indices[*it] == shard_index; ++it) {
+      const Symbol symbol = symbols[*it];
+      auto decode_search = shard.decode_map_.find(symbol);
+      ASSERT(decode_search != shard.decode_map_.end());
+
+      auto encode_search = shard.encode_map_.find(decode_search->second->toStringView());
+      ASSERT(encode_search != shard.encode_map_.end());
+
+      // If that was the last remaining client usage of the symbol, erase the
+      // current mappings and add the now-unused symbol index to the reuse pool.
+      //
+      // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
+      // symbol_table_speed_test.cc, relative to breaking out the decrement into a
+      // separate step, likely due to the non-trivial dereferences in EXPR.
+      if (--encode_search->second.ref_count_ == 0) {
+        shard.decode_map_.erase(decode_search);
+        shard.encode_map_.erase(encode_search);
+        shard.pool_.push(symbol >> shard_bits_);
+      }
     }
   }
 }
-Symbol SymbolTableImpl::toSymbol(absl::string_view sv) {
+
+Symbol SymbolTableImpl::toSymbol(Shard& shard, absl::string_view sv) {
   Symbol result;
-  auto encode_find = encode_map_.find(sv);
+  auto encode_find = shard.encode_map_.find(sv);
   // If the string segment doesn't already exist,
-  if (encode_find == encode_map_.end()) {
+  if (encode_find == shard.encode_map_.end()) {
     // We create the actual string, place it in the decode_map_, and then insert
     // a string_view pointing to it in the encode_map_. This allows us to only
     // store the string once. We use unique_ptr so copies are not made as
     // flat_hash_map moves values around.
+    //
+    // The index of the shard goes into the low-order bits of the symbol.
+    const Symbol symbol =
+        (shard.next_index_ << shard_bits_) | static_cast<Symbol>(&shard - shards_.get());
     InlineStringPtr str = InlineString::create(sv);
-    auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
+    auto encode_insert = shard.encode_map_.insert({str->toStringView(), SharedSymbol(symbol)});
     ASSERT(encode_insert.second);
-    auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
+    auto decode_insert = shard.decode_map_.insert({symbol, std::move(str)});
     ASSERT(decode_insert.second);
 
-    result = next_symbol_;
-    newSymbol();
+    result = symbol;
+    newSymbol(shard);
   } else {
     // If the insertion didn't take place, return the actual value at that location and up the
     // refcount at that location
@@ -232,22 +302,22 @@ Symbol SymbolTableImpl::toSymbol(absl::string_view sv) {
   return result;
 }
 
-absl::string_view SymbolTableImpl::fromSymbol(const Symbol symbol) const
-    EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  auto search = decode_map_.find(symbol);
-  RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
+absl::string_view SymbolTableImpl::fromSymbol(const Shard& shard, const Symbol symbol) const {
+  auto search = shard.decode_map_.find(symbol);
+  RELEASE_ASSERT(search != shard.decode_map_.end(), "no such symbol");
   return search->second->toStringView();
 }
 
-void SymbolTableImpl::newSymbol() EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  if (pool_.empty()) {
-    next_symbol_ = ++monotonic_counter_;
+void SymbolTableImpl::newSymbol(Shard& shard) {
+  if (shard.pool_.empty()) {
+    shard.next_index_ = ++shard.monotonic_counter_;
   } else {
-    next_symbol_ = pool_.top();
-    pool_.pop();
+    shard.next_index_ = shard.pool_.top();
+    shard.pool_.pop();
   }
-  // This should catch integer overflow for the new symbol.
-  ASSERT(monotonic_counter_ != 0);
+  // This should catch integer overflow for the new symbol, whose low-order bits hold the shard.
+  ASSERT(shard.monotonic_counter_ != 0 &&
+         shard.monotonic_counter_ <= (std::numeric_limits<Symbol>::max() >> shard_bits_));
 }
 
 bool SymbolTableImpl::lessThan(const StatName& a, const StatName& b) const {
@@ -258,13 +328,24 @@ bool SymbolTableImpl::lessThan(const StatName& a, const StatName& b) const {
   const SymbolVec av = Encoding::decodeSymbols(a.data(), a.dataSize());
   const SymbolVec bv = Encoding::decodeSymbols(b.data(), b.dataSize());
 
-  // Calling fromSymbol requires holding the lock, as it needs read-access to
-  // the maps that are written when adding new symbols.
-  Thread::LockGuard lock(lock_);
   for (uint64_t i = 0, n = std::min(av.size(), bv.size()); i < n; ++i) {
     if (av[i] != bv[i]) {
-      bool ret = fromSymbol(av[i]) < fromSymbol(bv[i]);
-      return ret;
+      // Calling fromSymbol requires holding the lock of the shard, as it needs
+      // read-access to the maps that are written when adding new symbols. The
+      // strings stay put once the lock is released, as a and b hold references
+      // to them.
+      absl::string_view a_token, b_token;
+      {
+        Shard& shard = shards_[symbolShard(av[i])];
+        Thread::LockGuard lock(shard.lock_);
+        a_token = fromSymbol(shard, av[i]);
+      }
+      {
+        Shard& shard = shards_[symbolShard(bv[i])];
+        Thread::LockGuard lock(shard.lock_);
+        b_token = fromSymbol(shard, bv[i]);
+      }
+      return a_token < b_token;
     }
   }
   return av.size() < bv.size();
@@ -272,16 +353,19 @@ bool SymbolTableImpl::lessThan(const StatName& a, const StatName& b) const {
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTableImpl::debugPrint() const {
-  Thread::LockGuard lock(lock_);
-  std::vector<Symbol> symbols;
-  for (const auto& p : decode_map_) {
-    symbols.push_back(p.first);
-  }
-  std::sort(symbols.begin(), symbols.end());
-  for (Symbol symbol : symbols) {
-    const InlineString& token = *decode_map_.find(symbol)->second;
-    const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+  for (uint32_t i = 0; i < numShards(); ++i) {
+    Shard& shard = shards_[i];
+    Thread::LockGuard lock(shard.lock_);
+    std::vector<Symbol> symbols;
+    for (const auto& p : shard.decode_map_) {
+      symbols.push_back(p.first);
+    }
+    std::sort(symbols.begin(), symbols.end());
+    for (Symbol symbol : symbols) {
+      const InlineString& token = *shard.decode_map_.find(symbol)->second;
+      const SharedSymbol& shared_symbol = shard.encode_map_.find(token.toStringView())->second;
+      ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    }
   }
 }
 #endif
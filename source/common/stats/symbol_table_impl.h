@@ -20,6 +20,7 @@
 #include "common/common/utility.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 
@@ -123,7 +124,12 @@ public:
     std::vector<uint8_t> vec_;
   };
 
-  SymbolTableImpl();
+  /**
+   * @param num_shards supplies the number of shards the table is split into, each with its own
+   *        lock and maps. It is rounded up to a power of 2, and capped at MaxShards. Symbols
+   *        carry their shard in their low-order bits, so sharding makes encodings a bit larger.
+   */
+  explicit SymbolTableImpl(uint32_t num_shards = 1);
   ~SymbolTableImpl() override;
 
   // SymbolTable
@@ -159,6 +165,10 @@ public:
     return bytes;
   }
 
+  uint32_t numShards() const { return shard_mask_ + 1; }
+
+  static constexpr uint32_t MaxShards = 64;
+
 private:
   friend class StatName;
   friend class StatNameTest;
@@ -170,8 +180,39 @@ private:
     uint32_t ref_count_;
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // Bitmap implementation.
+  // The encode map stores both the symbol and the ref count of that symbol.
+  // Using absl::string_view lets us only store the complete string once, in the decode map.
+  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
+  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
+
+  // Indices of the tokens of a name, or of their shards. Names rarely have more than 16 tokens.
+  using IndexVec = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * The tokens whose hash falls into a shard, and the symbols they are mapped to. The symbols of
+   * a shard have the index of the shard in their low-order bits, so that a symbol can be decoded,
+   * and its ref count updated, by locking just its shard.
+   */
+  struct Shard {
+    // This must be held during both encode() and free() of the tokens of the shard.
+    Thread::MutexBasicLockable lock_;
+
+    // Stores the index to be used for the symbol at next insertion. This should exist ahead of
+    // insertion time so that if insertion succeeds, the value written is the correct one.
+    Symbol next_index_ GUARDED_BY(lock_){};
+
+    // If the free pool is exhausted, we monotonically increase this counter.
+    Symbol monotonic_counter_ GUARDED_BY(lock_){};
+
+    EncodeMap encode_map_ GUARDED_BY(lock_);
+    DecodeMap decode_map_ GUARDED_BY(lock_);
+
+    // Free pool of symbol indices for re-use.
+    // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
+    // using an Envoy::IntervalSet.
+    std::stack<Symbol> pool_ GUARDED_BY(lock_);
+  };
 
   /**
    * Decodes a vector of symbols back into its period-delimited stat name. If
@@ -187,23 +228,26 @@ private:
   /**
    * Convenience function for encode(), symbolizing one string segment at a time.
    *
+   * @param shard the shard of the string, as returned by tokenShard().
    * @param sv the individual string to be encoded as a symbol.
    * @return Symbol the encoded string.
    */
-  Symbol toSymbol(absl::string_view sv) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  Symbol toSymbol(Shard& shard, absl::string_view sv) EXCLUSIVE_LOCKS_REQUIRED(shard.lock_);
 
   /**
    * Convenience function for decode(), decoding one symbol at a time.
    *
+   * @param shard the shard of the symbol, as returned by symbolShard().
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(const Shard& shard, Symbol symbol) const
+      EXCLUSIVE_LOCKS_REQUIRED(shard.lock_);
 
   /**
-   * Stages a new symbol for use. To be called after a successful insertion.
+   * Stages a new symbol index for use. To be called after a successful insertion.
    */
-  void newSymbol();
+  void newSymbol(Shard& shard) EXCLUSIVE_LOCKS_REQUIRED(shard.lock_);
 
   /**
    * Tokenizes name, finds or allocates symbols for each token, and adds them
@@ -214,30 +258,40 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
-  Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
-    return monotonic_counter_;
-  }
+  /**
+   * Orders the indices of a vector of tokens or symbols by shard, so that each shard's lock can be
+   * taken once for all its entries, rather than once per entry.
+   *
+   * @param shard_indices supplies the index of the shard of each entry.
+   * @return the indices of the entries, with the ones in the same shard next to each other.
+   */
+  IndexVec orderByShard(const IndexVec& shard_indices) const;
 
-  // Stores the symbol to be used at next insertion. This should exist ahead of insertion time so
-  // that if insertion succeeds, the value written is the correct one.
-  Symbol next_symbol_ GUARDED_BY(lock_);
+  /**
+   * @param symbols supplies symbols.
+   * @return the index of the shard of each symbol.
+   */
+  IndexVec symbolShards(const SymbolVec& symbols) const;
 
-  // If the free pool is exhausted, we monotonically increase this counter.
-  Symbol monotonic_counter_;
+  uint32_t tokenShard(absl::string_view token) const {
+    return shard_mask_ == 0 ? 0 : HashUtil::xxHash64(token) & shard_mask_;
+  }
+  uint32_t symbolShard(Symbol symbol) const { return symbol & shard_mask_; }
 
-  // Bitmap implementation.
-  // The encode map stores both the symbol and the ref count of that symbol.
-  // Using absl::string_view lets us only store the complete string once, in the decode map.
-  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
-  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
-  EncodeMap encode_map_ GUARDED_BY(lock_);
-  DecodeMap decode_map_ GUARDED_BY(lock_);
+  Symbol monotonicCounter() {
+    Symbol counter = 0;
+    for (uint32_t i = 0; i < numShards(); ++i) {
+      Shard& shard = shards_[i];
+      Thread::LockGuard lock(shard.lock_);
+      counter += shard.monotonic_counter_;
+    }
+    return counter;
+  }
 
-  // Free pool of symbols for re-use.
-  // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
-  // using an Envoy::IntervalSet.
-  std::stack<Symbol> pool_ GUARDED_BY(lock_);
+  const uint32_t shard_bits_;
+  const uint32_t shard_mask_;
+  // unique_ptr<T[]>::operator[] returns a non-const Shard&, so const methods can take the locks.
+  const std::unique_ptr<Shard[]> shards_;
 };
 
 /**
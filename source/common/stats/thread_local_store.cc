@@ -20,8 +20,8 @@
 namespace Envoy {
 namespace Stats {
 
-ThreadLocalStoreImpl::ThreadLocalStoreImpl(Allocator& alloc)
-    : alloc_(alloc), default_scope_(createScope("")),
+ThreadLocalStoreImpl::ThreadLocalStoreImpl(Allocator& alloc, bool lock_free_histograms)
+    : alloc_(alloc), lock_free_histograms_(lock_free_histograms), default_scope_(createScope("")),
       tag_producer_(std::make_unique<TagProducerImpl>()),
       stats_matcher_(std::make_unique<StatsMatcherImpl>()), heap_allocator_(alloc.symbolTable()),
       null_counter_(alloc.symbolTable()), null_gauge_(alloc.symbolTable()),
@@ -167,6 +167,11 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
     ASSERT(!merge_in_progress_);
     merge_in_progress_ = true;
+    if (lock_free_histograms_) {
+      // The histograms of each thread can be merged while they record values.
+      mergeInternal(merge_complete_cb);
+      return;
+    }
     tls_->runOnAllThreads(
         [this]() -> void {
           for (const auto& scope : tls_->getTyped<TlsCache>().scope_cache_) {
@@ -551,8 +556,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::tlsHistogram(StatName name,
   std::vector<Tag> tags;
   std::string tag_extracted_name =
       parent_.tagProducer().produceTags(symbolTable().toString(name), tags);
-  TlsHistogramSharedPtr hist_tls_ptr(
-      new ThreadLocalHistogramImpl(name, tag_extracted_name, tags, symbolTable()));
+  TlsHistogramSharedPtr hist_tls_ptr(new ThreadLocalHistogramImpl(
+      name, tag_extracted_name, tags, symbolTable(), parent_.lock_free_histograms_));
 
   parent.addTlsHistogram(hist_tls_ptr);
 
@@ -565,26 +570,40 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::tlsHistogram(StatName name,
 ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name,
                                                    const std::string& tag_extracted_name,
                                                    const std::vector<Tag>& tags,
-                                                   SymbolTable& symbol_table)
+                                                   SymbolTable& symbol_table, bool lock_free)
     : HistogramImplHelper(name, tag_extracted_name, tags, symbol_table), current_active_(0),
       used_(false), created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
-  histograms_[0] = hist_alloc();
-  histograms_[1] = hist_alloc();
+  if (lock_free) {
+    buckets_ = std::make_unique<HistogramBuckets>();
+  } else {
+    histograms_[0] = hist_alloc();
+    histograms_[1] = hist_alloc();
+  }
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
   MetricImpl::clear(symbolTable());
-  hist_free(histograms_[0]);
-  hist_free(histograms_[1]);
+  if (buckets_ == nullptr) {
+    hist_free(histograms_[0]);
+    hist_free(histograms_[1]);
+  }
 }
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  if (buckets_ != nullptr) {
+    buckets_->recordValue(value);
+  } else {
+    hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  }
   used_ = true;
 }
 
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  if (buckets_ != nullptr) {
+    buckets_->mergeNew(target);
+    return;
+  }
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
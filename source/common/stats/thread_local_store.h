@@ -10,6 +10,7 @@
 
 #include "common/common/hash.h"
 #include "common/stats/allocator_impl.h"
+#include "common/stats/histogram_buckets.h"
 #include "common/stats/histogram_impl.h"
 #include "common/stats/null_counter.h"
 #include "common/stats/null_gauge.h"
@@ -26,19 +27,22 @@ namespace Stats {
 /**
  * A histogram that is stored in TLS and used to record values per thread. This holds two
  * histograms, one to collect the values and other as backup that is used for merge process. The
- * swap happens during the merge process.
+ * swap happens during the merge process. A lock-free histogram instead records values into
+ * HistogramBuckets, which the main thread merges from without a swap.
  */
 class ThreadLocalHistogramImpl : public HistogramImplHelper {
 public:
   ThreadLocalHistogramImpl(StatName name, const std::string& tag_extracted_name,
-                           const std::vector<Tag>& tags, SymbolTable& symbol_table);
+                           const std::vector<Tag>& tags, SymbolTable& symbol_table,
+                           bool lock_free);
   ~ThreadLocalHistogramImpl() override;
 
   void merge(histogram_t* target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
-   * not have to lock the histogram in high throughput TLS writes.
+   * not have to lock the histogram in high throughput TLS writes. Lock-free histograms need no
+   * swap, and can be merged without calling this first.
    */
   void beginMerge() {
     // This switches the current_active_ between 1 and 0.
@@ -56,7 +60,9 @@ public:
 private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_;
-  histogram_t* histograms_[2];
+  histogram_t* histograms_[2]{};
+  // Set for a lock-free histogram, instead of histograms_.
+  std::unique_ptr<HistogramBuckets> buckets_;
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -140,7 +146,12 @@ public:
  */
 class ThreadLocalStoreImpl : Logger::Loggable<Logger::Id::stats>, public StoreRoot {
 public:
-  ThreadLocalStoreImpl(Allocator& alloc);
+  /**
+   * @param alloc supplies the allocator of the stats.
+   * @param lock_free_histograms supplies whether the histograms of each thread record values
+   *        without a buffer swap, so that merging them does not need a post to every thread.
+   */
+  ThreadLocalStoreImpl(Allocator& alloc, bool lock_free_histograms = false);
   ~ThreadLocalStoreImpl() override;
 
   // Stats::Scope
@@ -348,6 +359,7 @@ private:
                                  StatNameHashSet* tls_rejected_stats);
 
   Allocator& alloc_;
+  const bool lock_free_histograms_;
   Event::Dispatcher* main_thread_dispatcher_{};
   ThreadLocal::SlotPtr tls_;
   mutable Thread::MutexBasicLockable lock_;
@@ -17,7 +17,14 @@ ConnPoolImpl::ConnPoolImpl(Event::Dispatcher& dispatcher, Upstream::HostConstSha
                            Network::TransportSocketOptionsSharedPtr transport_socket_options)
     : dispatcher_(dispatcher), host_(host), priority_(priority), socket_options_(options),
       transport_socket_options_(transport_socket_options),
-      upstream_ready_timer_(dispatcher_.createTimer([this]() { onUpstreamReady(); })) {}
+      upstream_ready_timer_(dispatcher_.createTimer([this]() { onUpstreamReady(); })) {
+  if (host_->cluster().spareConnectionsPerHost() > 0) {
+    // As in the HTTP/1.1 pool, the spare connections of a new pool are opened on the next
+    // dispatcher iteration rather than while its owner is still setting it up.
+    warm_up_timer_ = dispatcher_.createTimer([this]() { createSpareConnections(); });
+    warm_up_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
 
 ConnPoolImpl::~ConnPoolImpl() {
   while (!ready_conns_.empty()) {
@@ -84,11 +91,28 @@ void ConnPoolImpl::createNewConnection() {
   conn->moveIntoList(std::move(conn), pending_conns_);
 }
 
+void ConnPoolImpl::createSpareConnections() {
+  const uint32_t spare_connections = host_->cluster().spareConnectionsPerHost();
+  if (spare_connections == 0 || !drained_callbacks_.empty()) {
+    return;
+  }
+
+  // Connecting connections are spare unless a pending request is waiting for them.
+  while (ready_conns_.size() + pending_conns_.size() <
+             spare_connections + pending_requests_.size() &&
+         host_->cluster().resourceManager(priority_).connections().canCreate()) {
+    ENVOY_LOG(debug, "creating a spare connection");
+    host_->cluster().stats().upstream_cx_spare_total_.inc();
+    createNewConnection();
+  }
+}
+
 ConnectionPool::Cancellable* ConnPoolImpl::newConnection(ConnectionPool::Callbacks& callbacks) {
   if (!ready_conns_.empty()) {
     ready_conns_.front()->moveBetweenLists(ready_conns_, busy_conns_);
     ENVOY_CONN_LOG(debug, "using existing connection", *busy_conns_.front()->conn_);
     assignConnection(*busy_conns_.front(), callbacks);
+    createSpareConnections();
     return nullptr;
   }
 
@@ -108,7 +132,9 @@ ConnectionPool::Cancellable* ConnPoolImpl::newConnection(ConnectionPool::Callbac
     ENVOY_LOG(debug, "queueing request due to no available connections");
     PendingRequestPtr pending_request(new PendingRequest(*this, callbacks));
     pending_request->moveIntoList(std::move(pending_request), pending_requests_);
-    return pending_requests_.front().get();
+    ConnectionPool::Cancellable* cancellable = pending_requests_.front().get();
+    createSpareConnections();
+    return cancellable;
   } else {
     ENVOY_LOG(debug, "max pending requests overflow");
     callbacks.onPoolFailure(ConnectionPool::PoolFailureReason::Overflow, nullptr);
@@ -126,6 +152,7 @@ void ConnPoolImpl::onConnectionEvent(ActiveConn& conn, Network::ConnectionEvent
 
     ActiveConnPtr removed;
     bool check_for_drained = true;
+    const bool connected = !conn.connect_timer_;
     if (conn.wrapper_ != nullptr) {
       if (!conn.wrapper_->released_) {
         Envoy::Upstream::reportUpstreamCxDestroyActiveRequest(host_, event);
@@ -178,6 +205,13 @@ void ConnPoolImpl::onConnectionEvent(ActiveConn& conn, Network::ConnectionEvent
       createNewConnection();
     }
 
+    // Replace the connections the upstream closes rather than wait for the next request to do so.
+    // Connect failures are left alone, so that an unreachable host does not get a connection
+    // attempt after every failed one.
+    if (connected && event == Network::ConnectionEvent::RemoteClose) {
+      createSpareConnections();
+    }
+
     if (check_for_drained) {
       checkForDrained();
     }
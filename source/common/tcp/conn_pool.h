@@ -137,6 +137,7 @@ protected:
 
   void assignConnection(ActiveConn& conn, ConnectionPool::Callbacks& callbacks);
   void createNewConnection();
+  void createSpareConnections();
   void onConnectionEvent(ActiveConn& conn, Network::ConnectionEvent event);
   void onPendingRequestCancel(PendingRequest& request, ConnectionPool::CancelPolicy cancel_policy);
   virtual void onConnReleased(ActiveConn& conn);
@@ -159,6 +160,8 @@ protected:
   Stats::TimespanPtr conn_connect_ms_;
   Event::TimerPtr upstream_ready_timer_;
   bool upstream_ready_enabled_{false};
+  // Opens the spare connections of a new pool before its first request.
+  Event::TimerPtr warm_up_timer_;
 };
 
 } // namespace Tcp
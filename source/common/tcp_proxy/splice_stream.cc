@@ -0,0 +1,140 @@
+#include "common/tcp_proxy/splice_stream.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/api/os_sys_calls_impl.h"
+#include "common/common/assert.h"
+#include "common/common/stack_array.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+SpliceStream::SpliceStream(int src_fd, int dst_fd, int pipe_read_fd, int pipe_write_fd)
+    : src_fd_(src_fd), dst_fd_(dst_fd), pipe_read_fd_(pipe_read_fd),
+      pipe_write_fd_(pipe_write_fd) {}
+
+SpliceStream::~SpliceStream() {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  os_sys_calls.close(pipe_read_fd_);
+  os_sys_calls.close(pipe_write_fd_);
+}
+
+#ifdef __linux__
+namespace {
+// Upper bound for a single splice() from the source socket into the pipe. The pipe capacity
+// usually limits it further.
+constexpr size_t MaxSpliceChunk = 64 * 1024;
+} // namespace
+
+bool SpliceStream::isSupported() { return true; }
+
+SpliceStreamPtr SpliceStream::create(int src_fd, int dst_fd, uint32_t pipe_size) {
+  int fds[2];
+  if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+    ENVOY_LOG(debug, "splice: pipe2() failed: {}", errno);
+    return nullptr;
+  }
+  if (pipe_size > 0 && ::fcntl(fds[1], F_SETPIPE_SZ, pipe_size) < 0) {
+    // The default capacity still works, it just bounds the data in flight differently.
+    ENVOY_LOG(debug, "splice: unable to resize pipe to {} bytes: {}", pipe_size, errno);
+  }
+  return SpliceStreamPtr{new SpliceStream(src_fd, dst_fd, fds[0], fds[1])};
+}
+
+bool SpliceStream::flushPipe(Result& result) {
+  while (pipe_bytes_ > 0) {
+    const ssize_t rc = ::splice(pipe_read_fd_, nullptr, dst_fd_, nullptr, pipe_bytes_,
+                                SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (rc < 0) {
+      error_ = (errno != EAGAIN);
+      return false;
+    }
+    ASSERT(static_cast<uint64_t>(rc) <= pipe_bytes_);
+    pipe_bytes_ -= rc;
+    result.bytes_written_ += rc;
+  }
+  return true;
+}
+
+SpliceStream::Result SpliceStream::transfer(bool read_source) {
+  Result result;
+  ASSERT(!error_);
+  while (true) {
+    if (!flushPending(result) || !flushPipe(result)) {
+      break;
+    }
+    if (end_stream_) {
+      // The destination is a connection socket which is not written to otherwise, so the half
+      // close is passed on here rather than through the connection.
+      ::shutdown(dst_fd_, SHUT_WR);
+      result.status_ = Status::EndStream;
+      return result;
+    }
+    if (!read_source) {
+      break;
+    }
+
+    // The pipe is empty here, so EAGAIN can only mean that the source socket has no data.
+    const ssize_t rc = ::splice(src_fd_, nullptr, pipe_write_fd_, nullptr, MaxSpliceChunk,
+                                SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (rc < 0) {
+      error_ = (errno != EAGAIN);
+      break;
+    }
+    if (rc == 0) {
+      end_stream_ = true;
+      continue;
+    }
+    pipe_bytes_ += rc;
+    result.bytes_read_ += rc;
+  }
+
+  if (error_) {
+    ENVOY_LOG(debug, "splice: transfer from fd {} to fd {} failed: {}", src_fd_, dst_fd_, errno);
+    result.status_ = Status::Error;
+  }
+  return result;
+}
+#else
+bool SpliceStream::isSupported() { return false; }
+
+SpliceStreamPtr SpliceStream::create(int, int, uint32_t) { return nullptr; }
+
+bool SpliceStream::flushPipe(Result&) { NOT_REACHED_GCOVR_EXCL_LINE; }
+
+SpliceStream::Result SpliceStream::transfer(bool) { NOT_REACHED_GCOVR_EXCL_LINE; }
+#endif
+
+bool SpliceStream::flushPending(Result& result) {
+  while (pending_.length() > 0) {
+    const uint64_t num_slices = pending_.getRawSlices(nullptr, 0);
+    STACK_ARRAY(slices, Buffer::RawSlice, num_slices);
+    pending_.getRawSlices(slices.begin(), num_slices);
+    STACK_ARRAY(iov, iovec, num_slices);
+    for (uint64_t i = 0; i < num_slices; i++) {
+      iov[i].iov_base = slices[i].mem_;
+      iov[i].iov_len = slices[i].len_;
+    }
+
+    const Api::SysCallSizeResult rc =
+        Api::OsSysCallsSingleton::get().writev(dst_fd_, iov.begin(), num_slices);
+    if (rc.rc_ < 0) {
+      error_ = (rc.errno_ != EAGAIN);
+      return false;
+    }
+    pending_.drain(rc.rc_);
+    result.bytes_written_ += rc.rc_;
+  }
+  return true;
+}
+
+void SpliceStream::addPending(Buffer::Instance& data) {
+  // Anything spliced from the source was read after this data, so nothing may be in the pipe yet.
+  ASSERT(pipe_bytes_ == 0);
+  pending_.move(data);
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
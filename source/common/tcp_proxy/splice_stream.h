@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/buffer/buffer.h"
+
+#include "common/buffer/buffer_impl.h"
+#include "common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+class SpliceStream;
+using SpliceStreamPtr = std::unique_ptr<SpliceStream>;
+
+/**
+ * Moves bytes in one direction between two non-blocking sockets with splice() through a kernel
+ * pipe, so that the payload is never copied into user space. The pipe capacity bounds the amount
+ * of data in flight: once it is full and the destination socket would block, nothing more is read
+ * from the source socket and TCP flow control pushes back on the peer, the same way a full write
+ * buffer read-disables the source connection on the regular proxying path.
+ */
+class SpliceStream : Logger::Loggable<Logger::Id::filter> {
+public:
+  enum class Status {
+    // More data may follow; wait for the next socket event.
+    Open,
+    // The source reached EOF, everything read from it has been written to the destination and the
+    // write side of the destination has been shut down.
+    EndStream,
+    // A socket error occurred. The stream must not be used anymore.
+    Error,
+  };
+
+  struct Result {
+    Status status_{Status::Open};
+    // Bytes read from the source socket during this call.
+    uint64_t bytes_read_{};
+    // Bytes written to the destination socket during this call.
+    uint64_t bytes_written_{};
+  };
+
+  ~SpliceStream();
+
+  /**
+   * @return true if splice() is available on this platform.
+   */
+  static bool isSupported();
+
+  /**
+   * Create a stream moving bytes from src_fd to dst_fd.
+   * @param src_fd supplies the socket to read from.
+   * @param dst_fd supplies the socket to write to.
+   * @param pipe_size supplies the requested pipe capacity in bytes, or 0 for the kernel default.
+   *        The kernel may round it up; failing to resize the pipe is not an error.
+   * @return SpliceStreamPtr the new stream, or nullptr if splice() is not supported or the pipe
+   *         could not be created.
+   */
+  static SpliceStreamPtr create(int src_fd, int dst_fd, uint32_t pipe_size);
+
+  /**
+   * Move as much data as possible until either socket would block. Data added with
+   * addPending() is written to the destination before anything is spliced from the source.
+   * @param read_source supplies whether to read from the source socket. If false, only data
+   *        already read is written to the destination, e.g. while the source connection is read
+   *        disabled.
+   */
+  Result transfer(bool read_source);
+
+  /**
+   * Queue data that has already been read from the source socket by the connection, or was
+   * written to the destination connection, before splicing was set up.
+   * @param data supplies the data to queue. It is drained.
+   */
+  void addPending(Buffer::Instance& data);
+
+  /**
+   * @return whether transfer() has returned EndStream.
+   */
+  bool endStream() const { return end_stream_ && pending_.length() == 0 && pipe_bytes_ == 0; }
+
+private:
+  SpliceStream(int src_fd, int dst_fd, int pipe_read_fd, int pipe_write_fd);
+
+  // Returns false if the destination socket would block or failed. In the latter case error_ is
+  // set.
+  bool flushPending(Result& result);
+  bool flushPipe(Result& result);
+
+  const int src_fd_;
+  const int dst_fd_;
+  const int pipe_read_fd_;
+  const int pipe_write_fd_;
+  Buffer::OwnedImpl pending_;
+  uint64_t pipe_bytes_{};
+  bool end_stream_{};
+  bool error_{};
+};
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/exception.h"
 #include "envoy/config/filter/network/http_connection_manager/v2/http_connection_manager.pb.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
@@ -12,6 +13,7 @@
 #include "envoy/upstream/upstream.h"
 
 #include "common/access_log/access_log_impl.h"
+#include "common/buffer/buffer_impl.h"
 #include "common/common/assert.h"
 #include "common/common/empty_string.h"
 #include "common/common/enum_to_int.h"
@@ -67,10 +69,15 @@ Config::SharedConfig::SharedConfig(
 Config::Config(const envoy::config::filter::network::tcp_proxy::v2::TcpProxy& config,
                Server::Configuration::FactoryContext& context)
     : max_connect_attempts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connect_attempts, 1)),
+      use_splice_(config.use_splice()),
       upstream_drain_manager_slot_(context.threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.random()) {
 
+  if (use_splice_ && !SpliceStream::isSupported()) {
+    throw EnvoyException("tcp_proxy: use_splice is not supported on this platform");
+  }
+
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     return ThreadLocal::ThreadLocalObjectSharedPtr(new UpstreamDrainManager());
   });
@@ -186,6 +193,7 @@ Filter::~Filter() {
 
   ASSERT(upstream_handle_ == nullptr);
   ASSERT(upstream_conn_data_ == nullptr);
+  ASSERT(splice_ == nullptr);
 }
 
 TcpProxyStats Config::SharedConfig::generateStats(Stats::Scope& scope) {
@@ -212,6 +220,7 @@ void Filter::initialize(Network::ReadFilterCallbacks& callbacks, bool set_connec
   read_callbacks_->connection().readDisable(true);
 
   config_->stats().downstream_cx_total_.inc();
+  connection_stats_set_ = set_connection_stats;
   if (set_connection_stats) {
     read_callbacks_->connection().setConnectionStats(
         {config_->stats().downstream_cx_rx_bytes_total_,
@@ -468,6 +477,11 @@ Network::FilterStatus Filter::onData(Buffer::Instance& data, bool end_stream) {
 }
 
 void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
+  if (event == Network::ConnectionEvent::RemoteClose ||
+      event == Network::ConnectionEvent::LocalClose) {
+    stopSplice();
+  }
+
   if (upstream_conn_data_) {
     if (event == Network::ConnectionEvent::RemoteClose) {
       upstream_conn_data_->connection().close(Network::ConnectionCloseType::FlushWrite);
@@ -516,6 +530,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    stopSplice();
     upstream_conn_data_.reset();
     disableIdleTimer();
 
@@ -534,7 +549,9 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
     }
   } else if (event == Network::ConnectionEvent::Connected) {
     // Re-enable downstream reads now that the upstream connection is established
-    // so we have a place to send downstream data to.
+    // so we have a place to send downstream data to. When splicing, the read state of the
+    // connections decides which sockets data is spliced from.
+    startSplice();
     read_callbacks_->connection().readDisable(false);
 
     read_callbacks_->upstreamHost()->outlierDetector().putResult(
@@ -560,9 +577,122 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
   }
 }
 
+void Filter::startSplice() {
+  Network::Connection& downstream = read_callbacks_->connection();
+  Network::Connection& upstream = upstream_conn_data_->connection();
+  if (!config_->useSplice() || downstream.ssl() != nullptr || upstream.ssl() != nullptr) {
+    return;
+  }
+
+  const int downstream_fd = downstream.ioHandle().fd();
+  const int upstream_fd = upstream.ioHandle().fd();
+  auto splice = std::make_unique<SpliceState>();
+  // Size the pipes like the connection buffers so that splicing does not hold more data in flight
+  // than the regular path would buffer before read-disabling the source.
+  splice->downstream_to_upstream_ =
+      SpliceStream::create(downstream_fd, upstream_fd, upstream.bufferLimit());
+  splice->upstream_to_downstream_ =
+      SpliceStream::create(upstream_fd, downstream_fd, downstream.bufferLimit());
+  if (splice->downstream_to_upstream_ == nullptr || splice->upstream_to_downstream_ == nullptr) {
+    return;
+  }
+
+  ENVOY_CONN_LOG(debug, "proxying with splice()", downstream);
+  Buffer::OwnedImpl downstream_read;
+  Buffer::OwnedImpl downstream_write;
+  Buffer::OwnedImpl upstream_read;
+  Buffer::OwnedImpl upstream_write;
+  downstream.takeOverSocketEvents([this](uint32_t) { onSpliceReady(); }, downstream_read,
+                                  downstream_write);
+  upstream.takeOverSocketEvents([this](uint32_t) { onSpliceReady(); }, upstream_read,
+                                upstream_write);
+  // Whatever the connections already buffered must be sent before anything spliced after it: the
+  // data waiting to be written to a socket first, then the data read from its peer.
+  getStreamInfo().addBytesReceived(downstream_read.length());
+  splice->downstream_to_upstream_->addPending(upstream_write);
+  splice->downstream_to_upstream_->addPending(downstream_read);
+  splice->upstream_to_downstream_->addPending(downstream_write);
+  splice->upstream_to_downstream_->addPending(upstream_read);
+  splice_ = std::move(splice);
+}
+
+void Filter::stopSplice() {
+  // This closes the pipes. The sockets stay with the connections, which close them.
+  splice_.reset();
+}
+
+void Filter::onSpliceReady() {
+  if (splice_ == nullptr) {
+    return;
+  }
+  // A read disabled connection, e.g. by a watermark or the overload manager, is not spliced from,
+  // just like it is not read from on the regular path.
+  if (!splice_->downstream_to_upstream_->endStream()) {
+    onSpliceResult(
+        splice_->downstream_to_upstream_->transfer(read_callbacks_->connection().readEnabled()),
+        true);
+    if (splice_ == nullptr) {
+      return;
+    }
+  }
+  if (!splice_->upstream_to_downstream_->endStream()) {
+    onSpliceResult(
+        splice_->upstream_to_downstream_->transfer(upstream_conn_data_->connection().readEnabled()),
+        false);
+    if (splice_ == nullptr) {
+      return;
+    }
+  }
+
+  if (splice_->downstream_to_upstream_->endStream() &&
+      splice_->upstream_to_downstream_->endStream()) {
+    // Both directions are done and every byte has been handed to the kernel.
+    stopSplice();
+    read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite);
+  }
+}
+
+void Filter::onSpliceResult(const SpliceStream::Result& result, bool downstream_to_upstream) {
+  Upstream::ClusterStats& cluster_stats = read_callbacks_->upstreamHost()->cluster().stats();
+  // The connections do not see spliced bytes, so account them here the way the connection stats
+  // and onData()/onUpstreamData() would have.
+  if (downstream_to_upstream) {
+    getStreamInfo().addBytesReceived(result.bytes_read_);
+    cluster_stats.upstream_cx_tx_bytes_total_.add(result.bytes_written_);
+    if (connection_stats_set_) {
+      config_->stats().downstream_cx_rx_bytes_total_.add(result.bytes_read_);
+    }
+  } else {
+    getStreamInfo().addBytesSent(result.bytes_written_);
+    cluster_stats.upstream_cx_rx_bytes_total_.add(result.bytes_read_);
+    if (connection_stats_set_) {
+      config_->stats().downstream_cx_tx_bytes_total_.add(result.bytes_written_);
+    }
+  }
+  if (result.bytes_read_ > 0 || result.bytes_written_ > 0) {
+    resetIdleTimer();
+  }
+
+  switch (result.status_) {
+  case SpliceStream::Status::Open:
+    break;
+  case SpliceStream::Status::EndStream:
+    // The stream has already shut down the write side of the destination socket.
+    ENVOY_CONN_LOG(trace, "{} half closed while splicing", read_callbacks_->connection(),
+                   downstream_to_upstream ? "downstream" : "upstream");
+    break;
+  case SpliceStream::Status::Error:
+    stopSplice();
+    // This results in also closing the upstream connection.
+    read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+    break;
+  }
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
+  stopSplice();
 
   // This results in also closing the upstream connection.
   read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
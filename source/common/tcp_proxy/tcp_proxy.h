@@ -26,6 +26,7 @@
 #include "common/network/filter_impl.h"
 #include "common/network/utility.h"
 #include "common/stream_info/stream_info_impl.h"
+#include "common/tcp_proxy/splice_stream.h"
 #include "common/upstream/load_balancer_impl.h"
 
 namespace Envoy {
@@ -105,6 +106,7 @@ public:
   const TcpProxyStats& stats() { return shared_config_->stats(); }
   const std::vector<AccessLog::InstanceSharedPtr>& accessLogs() { return access_logs_; }
   uint32_t maxConnectAttempts() const { return max_connect_attempts_; }
+  bool useSplice() const { return use_splice_; }
   const absl::optional<std::chrono::milliseconds>& idleTimeout() {
     return shared_config_->idleTimeout();
   }
@@ -145,6 +147,7 @@ private:
   uint64_t total_cluster_weight_;
   std::vector<AccessLog::InstanceSharedPtr> access_logs_;
   const uint32_t max_connect_attempts_;
+  const bool use_splice_;
   ThreadLocal::SlotPtr upstream_drain_manager_slot_;
   SharedConfigSharedPtr shared_config_;
   std::unique_ptr<const Router::MetadataMatchCriteria> cluster_metadata_match_criteria_;
@@ -271,6 +274,17 @@ protected:
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
+  void startSplice();
+  void stopSplice();
+  void onSpliceReady();
+  void onSpliceResult(const SpliceStream::Result& result, bool downstream_to_upstream);
+
+  // State for proxying with splice() once the upstream connection is established. The socket
+  // events of both connections are taken over while it exists.
+  struct SpliceState {
+    SpliceStreamPtr downstream_to_upstream_;
+    SpliceStreamPtr upstream_to_downstream_;
+  };
 
   const ConfigSharedPtr config_;
   Upstream::ClusterManager& cluster_manager_;
@@ -282,8 +296,10 @@ protected:
   std::shared_ptr<UpstreamCallbacks> upstream_callbacks_; // shared_ptr required for passing as a
                                                           // read filter.
   StreamInfo::StreamInfoImpl stream_info_;
+  std::unique_ptr<SpliceState> splice_;
   uint32_t connect_attempts_{};
   bool connecting_{};
+  bool connection_stats_set_{};
 };
 
 // This class deals with an upstream connection that needs to finish flushing, when the downstream
@@ -1,5 +1,6 @@
 #include "common/upstream/cluster_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -38,6 +39,8 @@
 #include "common/upstream/ring_hash_lb.h"
 #include "common/upstream/subset_lb.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Upstream {
 namespace {
@@ -49,6 +52,10 @@ void addOptionsIfNotNull(Network::Socket::OptionsSharedPtr& options,
   }
 }
 
+// How many more hosts the load balancer is asked for when the chosen host is at its HTTP/2
+// connection limit.
+constexpr uint32_t MaxHttp2HostReselections = 8;
+
 } // namespace
 
 void ClusterManagerInitHelper::addCluster(Cluster& cluster) {
@@ -364,16 +371,22 @@ void ClusterManagerImpl::onClusterInit(Cluster& cluster) {
     // of removals, these maps will leak those HostSharedPtrs.
     //
     // See https://github.com/envoyproxy/envoy/pull/3941 for more context.
+    //
+    // When merge_membership_updates is set, adds/removes are merged anyway: the pending update
+    // keeps every add and remove that was not delivered yet, so the workers still see all of them.
     bool scheduled = false;
     const auto merge_timeout =
         PROTOBUF_GET_MS_OR_DEFAULT(cluster.info()->lbConfig(), update_merge_window, 1000);
-    // Remember: we only merge updates with no adds/removes — just hc/weight/metadata changes.
-    const bool is_mergeable = hosts_added.empty() && hosts_removed.empty();
+    // Remember: unless merge_membership_updates is set, we only merge updates with no
+    // adds/removes — just hc/weight/metadata changes.
+    const bool is_mergeable = (hosts_added.empty() && hosts_removed.empty()) ||
+                              cluster.info()->lbConfig().merge_membership_updates();
 
     if (merge_timeout > 0) {
       // If this is not mergeable, we should cancel any scheduled updates since
       // we'll deliver it immediately.
-      scheduled = scheduleUpdate(cluster, priority, is_mergeable, merge_timeout);
+      scheduled = scheduleUpdate(cluster, priority, is_mergeable, merge_timeout, hosts_added,
+                                 hosts_removed);
     }
 
     // If an update was not scheduled for later, deliver it immediately.
@@ -394,7 +407,8 @@ void ClusterManagerImpl::onClusterInit(Cluster& cluster) {
 }
 
 bool ClusterManagerImpl::scheduleUpdate(const Cluster& cluster, uint32_t priority, bool mergeable,
-                                        const uint64_t timeout) {
+                                        const uint64_t timeout, const HostVector& hosts_added,
+                                        const HostVector& hosts_removed) {
   // Find pending updates for this cluster.
   auto& updates_by_prio = updates_map_[cluster.info()->name()];
   if (!updates_by_prio) {
@@ -432,10 +446,17 @@ bool ClusterManagerImpl::scheduleUpdate(const Cluster& cluster, uint32_t priorit
       cm_stats_.update_merge_cancelled_.inc();
     }
 
+    // Adds/removes that were merged so far have to reach the workers before this update.
+    if (!updates->hosts_added_.empty() || !updates->hosts_removed_.empty()) {
+      deliverMergedMembership(cluster, priority, *updates);
+    }
+
     updates->last_updated_ = time_source_.monotonicTime();
     return false;
   }
 
+  updates->mergeMembership(hosts_added, hosts_removed);
+
   // If there's no timer, create one.
   if (updates->timer_ == nullptr) {
     updates->timer_ = dispatcher_.createTimer([this, &cluster, priority, &updates]() -> void {
@@ -455,19 +476,53 @@ void ClusterManagerImpl::applyUpdates(const Cluster& cluster, uint32_t priority,
                                       PendingUpdates& updates) {
   // Deliver pending updates.
 
-  // Remember that these merged updates are _only_ for updates related to
-  // HC/weight/metadata changes. That's why added/removed are empty. All
+  // Remember that unless merge_membership_updates is set, these merged updates are _only_ for
+  // updates related to HC/weight/metadata changes. That's why added/removed are empty. All
   // adds/removals were already immediately broadcasted.
-  static const HostVector hosts_added;
-  static const HostVector hosts_removed;
-
-  postThreadLocalClusterUpdate(cluster, priority, hosts_added, hosts_removed);
+  deliverMergedMembership(cluster, priority, updates);
 
   cm_stats_.cluster_updated_via_merge_.inc();
   updates.timer_enabled_ = false;
   updates.last_updated_ = time_source_.monotonicTime();
 }
 
+void ClusterManagerImpl::deliverMergedMembership(const Cluster& cluster, uint32_t priority,
+                                                 PendingUpdates& updates) {
+  postThreadLocalClusterUpdate(cluster, priority, updates.hosts_added_, updates.hosts_removed_);
+  // The workers may have created new connection pools to the removed hosts since their removal.
+  if (!updates.hosts_removed_.empty()) {
+    postThreadLocalDrainConnections(cluster, updates.hosts_removed_);
+  }
+  updates.hosts_added_.clear();
+  updates.hosts_removed_.clear();
+}
+
+void ClusterManagerImpl::PendingUpdates::mergeMembership(const HostVector& hosts_added,
+                                                          const HostVector& hosts_removed) {
+  // A re-added host gets a new HostSharedPtr, so a remove can only cancel out an add that was not
+  // delivered yet and never the other way around.
+  absl::flat_hash_set<HostSharedPtr> cancelled;
+  if (!hosts_added_.empty() && !hosts_removed.empty()) {
+    const absl::flat_hash_set<HostSharedPtr> removed(hosts_removed.begin(), hosts_removed.end());
+    hosts_added_.erase(std::remove_if(hosts_added_.begin(), hosts_added_.end(),
+                                      [&removed, &cancelled](const HostSharedPtr& host) {
+                                        if (removed.count(host) == 0) {
+                                          return false;
+                                        }
+                                        cancelled.insert(host);
+                                        return true;
+                                      }),
+                       hosts_added_.end());
+  }
+
+  hosts_added_.insert(hosts_added_.end(), hosts_added.begin(), hosts_added.end());
+  for (const HostSharedPtr& host : hosts_removed) {
+    if (cancelled.count(host) == 0) {
+      hosts_removed_.push_back(host);
+    }
+  }
+}
+
 bool ClusterManagerImpl::addOrUpdateCluster(const envoy::api::v2::Cluster& cluster,
                                             const std::string& version_info) {
   // First we need to see if this new config is new or an update to an existing dynamic cluster.
@@ -1048,6 +1103,15 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
     cluster_entry->lb_ = cluster_entry->lb_factory_->create();
   }
+
+  // Open spare connections to hosts as soon as they are healthy rather than with their first
+  // request. Health changes come through here as well, and hosts that already have a pool keep it.
+  if (cluster_entry->cluster_info_->poolWarming() != envoy::api::v2::Cluster::NO_POOL_WARMING) {
+    for (const HostSharedPtr& host :
+         cluster_entry->priority_set_.hostSetsPerPriority()[priority]->healthyHosts()) {
+      cluster_entry->warmConnPool(host);
+    }
+  }
 }
 
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::onHostHealthFailure(
@@ -1155,6 +1219,14 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
                                                      parent.parent_.random_, cluster->lbConfig());
       break;
     }
+    case LoadBalancerType::PeakEwma: {
+      ASSERT(lb_factory_ == nullptr);
+      lb_ = std::make_unique<PeakEwmaLoadBalancer>(
+          priority_set_, parent_.local_priority_set_, cluster->stats(), parent.parent_.runtime_,
+          parent.parent_.random_, parent.thread_local_dispatcher_.timeSource(), cluster->lbConfig(),
+          cluster->lbPeakEwmaConfig());
+      break;
+    }
     case LoadBalancerType::ClusterProvided:
     case LoadBalancerType::RingHash:
     case LoadBalancerType::Maglev:
@@ -1207,6 +1279,16 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
     option->hashKey(hash_key);
   }
 
+  if (protocol == Http::Protocol::Http2) {
+    // Hash based load balancers choose a host for its affinity, which choosing another one would
+    // break.
+    const absl::optional<uint32_t> max_connections = cluster_info_->maxHttp2ConnectionsPerHost();
+    if (max_connections.has_value() && cluster_info_->lbType() != LoadBalancerType::RingHash &&
+        cluster_info_->lbType() != LoadBalancerType::Maglev) {
+      host = chooseHttp2Host(std::move(host), max_connections.value(), priority, hash_key, context);
+    }
+  }
+
   ConnPoolsContainer& container = *parent_.getHttpConnPoolsContainer(host, true);
 
   // Note: to simplify this, we assume that the factory is only called in the scope of this
@@ -1225,6 +1307,73 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::connPool(
   }
 }
 
+HostConstSharedPtr ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::chooseHttp2Host(
+    HostConstSharedPtr host, uint32_t max_connections, ResourcePriority priority,
+    const std::vector<uint8_t>& hash_key, LoadBalancerContext* context) {
+  // A host whose pool on this worker has a connection that is open or being established can take
+  // the stream without a new connection. Pools outlive their connections, so it is the connection
+  // that is checked rather than the pool. For any other host, the active HTTP/2 connection gauge
+  // of the host is shared by all workers, so it tells whether opening yet another connection would
+  // exceed the limit.
+  const auto usable = [&](const HostConstSharedPtr& candidate) {
+    const ConnPoolsContainer* container = parent_.getHttpConnPoolsContainer(candidate);
+    if (container != nullptr) {
+      ConnPoolsContainer::ConnPools::OptPoolRef pool =
+          container->pools_->findPool(priority, hash_key);
+      if (pool.has_value() && pool.value().get().hasUsableConnection()) {
+        return true;
+      }
+    }
+    return candidate->stats().cx_http2_active_.value() < max_connections;
+  };
+
+  if (usable(host)) {
+    return host;
+  }
+  for (uint32_t i = 0; i < MaxHttp2HostReselections; i++) {
+    HostConstSharedPtr candidate = lb_->chooseHost(context);
+    if (candidate == host) {
+      // The load balancer went round to the original host, so it has no other host to offer.
+      break;
+    }
+    cluster_info_->stats().upstream_cx_http2_per_host_reselect_.inc();
+    if (candidate != nullptr && usable(candidate)) {
+      return candidate;
+    }
+  }
+  cluster_info_->stats().upstream_cx_http2_per_host_overflow_.inc();
+  return host;
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::warmConnPool(
+    const HostConstSharedPtr& host) {
+  // These are the pools that connPool() and tcpConnPool() return for requests and connections
+  // without socket options.
+  switch (cluster_info_->poolWarming()) {
+  case envoy::api::v2::Cluster::HTTP1_POOL: {
+    const std::vector<uint8_t> hash_key = {uint8_t(Http::Protocol::Http11)};
+    ConnPoolsContainer& container = *parent_.getHttpConnPoolsContainer(host, true);
+    container.pools_->getPool(ResourcePriority::Default, hash_key, [&]() {
+      return parent_.parent_.factory_.allocateConnPool(parent_.thread_local_dispatcher_, host,
+                                                       ResourcePriority::Default,
+                                                       Http::Protocol::Http11, nullptr);
+    });
+    break;
+  }
+  case envoy::api::v2::Cluster::TCP_POOL: {
+    const std::vector<uint8_t> hash_key = {uint8_t(ResourcePriority::Default)};
+    TcpConnPoolsContainer& container = parent_.host_tcp_conn_pool_map_[host];
+    if (!container.pools_[hash_key]) {
+      container.pools_[hash_key] = parent_.parent_.factory_.allocateTcpConnPool(
+          parent_.thread_local_dispatcher_, host, ResourcePriority::Default, nullptr, nullptr);
+    }
+    break;
+  }
+  default:
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
+}
+
 Tcp::ConnectionPool::Instance*
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::tcpConnPool(
     ResourcePriority priority, LoadBalancerContext* context,
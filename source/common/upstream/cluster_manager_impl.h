@@ -307,6 +307,16 @@ private:
 
       Http::ConnectionPool::Instance* connPool(ResourcePriority priority, Http::Protocol protocol,
                                                LoadBalancerContext* context);
+      // Applies the cluster's soft limit on HTTP/2 connections per host to a host chosen by the
+      // load balancer, possibly choosing another one. The priority and hash key identify the pool
+      // the request would use.
+      HostConstSharedPtr chooseHttp2Host(HostConstSharedPtr host, uint32_t max_connections,
+                                         ResourcePriority priority,
+                                         const std::vector<uint8_t>& hash_key,
+                                         LoadBalancerContext* context);
+      // Creates the connection pool of the cluster's pool_warming type for a host, unless it exists
+      // already. The pool then opens its spare connections.
+      void warmConnPool(const HostConstSharedPtr& host);
 
       Tcp::ConnectionPool::Instance*
       tcpConnPool(ResourcePriority priority, LoadBalancerContext* context,
@@ -422,6 +432,8 @@ private:
       }
       return was_enabled;
     }
+    // Adds the hosts of a membership update to the ones that have not been delivered yet.
+    void mergeMembership(const HostVector& hosts_added, const HostVector& hosts_removed);
 
     Event::TimerPtr timer_;
     // TODO(rgs1): this should be part of Event::Timer's interface.
@@ -437,6 +449,10 @@ private:
     // between now and the start time may fall within the
     // `Cluster.CommonLbConfig.update_merge_window`, with the side effect to delay the first update.
     MonotonicTime last_updated_;
+    // Membership changes merged into the pending update, when
+    // `Cluster.CommonLbConfig.merge_membership_updates` is set.
+    HostVector hosts_added_;
+    HostVector hosts_removed_;
   };
 
   using PendingUpdatesPtr = std::unique_ptr<PendingUpdates>;
@@ -446,7 +462,10 @@ private:
 
   void applyUpdates(const Cluster& cluster, uint32_t priority, PendingUpdates& updates);
   bool scheduleUpdate(const Cluster& cluster, uint32_t priority, bool mergeable,
-                      const uint64_t timeout);
+                      const uint64_t timeout, const HostVector& hosts_added,
+                      const HostVector& hosts_removed);
+  void deliverMergedMembership(const Cluster& cluster, uint32_t priority,
+                               PendingUpdates& updates);
   void createOrUpdateThreadLocalCluster(ClusterData& cluster);
   ProtobufTypes::MessagePtr dumpClusterConfigs();
   static ClusterManagerStats generateStats(Stats::Scope& scope);
@@ -33,6 +33,12 @@ public:
    */
   OptPoolRef getPool(KEY_TYPE key, const PoolFactory& factory);
 
+  /**
+   * Returns an existing pool for `key`, without creating one.
+   * @return The pool corresponding to `key`, or `absl::nullopt`.
+   */
+  OptPoolRef findPool(const KEY_TYPE& key) const;
+
   /**
    * @return the number of pools.
    */
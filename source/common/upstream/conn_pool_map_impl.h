@@ -60,6 +60,16 @@ ConnPoolMap<KEY_TYPE, POOL_TYPE>::getPool(KEY_TYPE key, const PoolFactory& facto
   return std::ref(*inserted.first->second);
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+typename ConnPoolMap<KEY_TYPE, POOL_TYPE>::OptPoolRef
+ConnPoolMap<KEY_TYPE, POOL_TYPE>::findPool(const KEY_TYPE& key) const {
+  auto pool_iter = active_pools_.find(key);
+  if (pool_iter == active_pools_.end()) {
+    return absl::nullopt;
+  }
+  return std::ref(*(pool_iter->second));
+}
+
 template <typename KEY_TYPE, typename POOL_TYPE>
 size_t ConnPoolMap<KEY_TYPE, POOL_TYPE>::size() const {
   return active_pools_.size();
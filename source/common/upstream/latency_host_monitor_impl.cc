@@ -0,0 +1,128 @@
+#include "common/upstream/latency_host_monitor_impl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Upstream {
+
+namespace {
+
+constexpr uint64_t DefaultDecayTimeMs = 10000;
+constexpr uint64_t DefaultLatencyMs = 30;
+
+constexpr double FailurePenaltyFactor = 2;
+// Bounds the penalty of a host which keeps failing, so that its estimate stays finite and decays
+// back once the host recovers.
+constexpr double MaxFailurePenaltyUs = 60 * 1000 * 1000;
+
+// The state before the estimate is first set. Its estimate bits are a NaN, which no update writes.
+constexpr uint64_t NoEstimate = std::numeric_limits<uint64_t>::max();
+
+uint64_t pack(float estimate, uint32_t time) {
+  uint32_t estimate_bits;
+  static_assert(sizeof(estimate_bits) == sizeof(estimate), "float must have 32 bits");
+  memcpy(&estimate_bits, &estimate, sizeof(estimate_bits));
+  return (static_cast<uint64_t>(estimate_bits) << 32) | time;
+}
+
+float unpackEstimate(uint64_t state) {
+  const uint32_t estimate_bits = state >> 32;
+  float estimate;
+  memcpy(&estimate, &estimate_bits, sizeof(estimate));
+  return estimate;
+}
+
+uint32_t unpackTime(uint64_t state) { return static_cast<uint32_t>(state); }
+
+uint32_t toMilliseconds(MonotonicTime time) {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count());
+}
+
+} // namespace
+
+PeakEwmaHostMonitor::PeakEwmaHostMonitor(
+    const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>& config)
+    : decay_time_ms_(config ? PROTOBUF_GET_MS_OR_DEFAULT(config.value(), decay_time,
+                                                         DefaultDecayTimeMs)
+                            : DefaultDecayTimeMs),
+      default_latency_us_(1000 * (config ? PROTOBUF_GET_MS_OR_DEFAULT(config.value(),
+                                                                      default_latency,
+                                                                      DefaultLatencyMs)
+                                         : DefaultLatencyMs)),
+      state_(NoEstimate), last_response_time_us_(default_latency_us_) {}
+
+double PeakEwmaHostMonitor::decay(uint64_t state, uint32_t now) const {
+  // The truncated times are compared by their difference, which stays correct when they wrap
+  // around. The difference is negative if the clock of this thread was read just before the one
+  // of the thread which did the last update.
+  const int32_t elapsed = static_cast<int32_t>(now - unpackTime(state));
+  if (elapsed <= 0) {
+    return 1.0;
+  }
+  return std::exp(-elapsed / decay_time_ms_);
+}
+
+double PeakEwmaHostMonitor::estimate(uint64_t state, uint32_t now) const {
+  const double last_response_time = last_response_time_us_.load(std::memory_order_relaxed);
+  return last_response_time + (unpackEstimate(state) - last_response_time) * decay(state, now);
+}
+
+void PeakEwmaHostMonitor::putResponseTime(std::chrono::microseconds response_time,
+                                          MonotonicTime now) {
+  last_response_time_us_.store(response_time.count(), std::memory_order_relaxed);
+  update(response_time.count(), false, toMilliseconds(now));
+}
+
+void PeakEwmaHostMonitor::putFailure(std::chrono::microseconds elapsed, MonotonicTime now) {
+  update(elapsed.count(), true, toMilliseconds(now));
+}
+
+void PeakEwmaHostMonitor::update(double latency, bool failure, uint32_t now_ms) {
+  uint64_t state = state_.load(std::memory_order_relaxed);
+  uint64_t new_state;
+  do {
+    if (failure) {
+      // A failure counts as at least twice the current estimate, so that the estimate of a host
+      // keeps growing while it fails, even if it fails fast.
+      const double current = state == NoEstimate ? default_latency_us_ : estimate(state, now_ms);
+      latency = std::max(latency, std::min(FailurePenaltyFactor * current, MaxFailurePenaltyUs));
+    }
+    double new_estimate = latency;
+    uint32_t time = now_ms;
+    if (state != NoEstimate) {
+      if (latency < unpackEstimate(state)) {
+        const double weight = decay(state, now_ms);
+        new_estimate = unpackEstimate(state) * weight + latency * (1.0 - weight);
+      }
+      // Keep the later of the two times, so that a thread whose clock was read just before the
+      // one of the last update does not move the time of the estimate backwards.
+      if (static_cast<int32_t>(now_ms - unpackTime(state)) <= 0) {
+        time = unpackTime(state);
+      }
+    }
+    new_state = pack(new_estimate, time);
+  } while (!state_.compare_exchange_weak(state, new_state, std::memory_order_relaxed));
+}
+
+double PeakEwmaHostMonitor::latencyEstimate(MonotonicTime now) {
+  const uint32_t now_ms = toMilliseconds(now);
+  uint64_t state = state_.load(std::memory_order_relaxed);
+  if (state == NoEstimate) {
+    // Start the estimate out at the default latency. If another thread set the estimate first,
+    // the compare-and-swap fails and loads its state instead.
+    const uint64_t initial_state = pack(default_latency_us_, now_ms);
+    if (state_.compare_exchange_strong(state, initial_state, std::memory_order_relaxed)) {
+      state = initial_state;
+    }
+  }
+  return estimate(state, now_ms);
+}
+
+} // namespace Upstream
+} // namespace Envoy
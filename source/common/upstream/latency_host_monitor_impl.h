@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/api/v2/cds.pb.h"
+#include "envoy/common/time.h"
+#include "envoy/upstream/latency_host_monitor.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Null latency monitor, used by hosts of clusters that do not balance load by latency.
+ */
+class LatencyHostMonitorNullImpl : public LatencyHostMonitor {
+public:
+  // Upstream::LatencyHostMonitor
+  void putResponseTime(std::chrono::microseconds, MonotonicTime) override {}
+  void putFailure(std::chrono::microseconds, MonotonicTime) override {}
+  double latencyEstimate(MonotonicTime) override { return 0; }
+};
+
+/**
+ * Peak-sensitive exponentially weighted moving average (peak EWMA) of the response times of a
+ * host. A response time above the estimate replaces it, so that the estimate follows latency spikes
+ * at once, while lower response times pull it down gradually. The weight of past response times
+ * decays with the time elapsed since, not with the number of responses. Between responses, the
+ * estimate decays towards the latest response time, so that a host which had a latency spike gets
+ * requests again after a while, but a host which is slow does not. A failure counts as at least
+ * twice the current estimate. Before the first response, the estimate is a configured default
+ * latency.
+ *
+ * The estimate and the time of its last update are packed into a single atomic word, which is
+ * updated with compare-and-swap. Workers recording response times or reading the estimate
+ * concurrently never block each other.
+ */
+class PeakEwmaHostMonitor : public LatencyHostMonitor {
+public:
+  explicit PeakEwmaHostMonitor(
+      const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>& config);
+
+  // Upstream::LatencyHostMonitor
+  void putResponseTime(std::chrono::microseconds response_time, MonotonicTime now) override;
+  void putFailure(std::chrono::microseconds elapsed, MonotonicTime now) override;
+  double latencyEstimate(MonotonicTime now) override;
+
+private:
+  double decay(uint64_t state, uint32_t now) const;
+  double estimate(uint64_t state, uint32_t now) const;
+  void update(double latency, bool failure, uint32_t now_ms);
+
+  const double decay_time_ms_;
+  const float default_latency_us_;
+  // The estimate in microseconds, as a float, in the upper 32 bits, and the time of its last
+  // update in milliseconds, truncated to 32 bits, in the lower ones.
+  std::atomic<uint64_t> state_;
+  // The latest response time in microseconds, which the estimate decays towards. It is updated
+  // apart from the estimate, as a slightly stale value only delays the decay.
+  std::atomic<float> last_response_time_us_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -775,5 +775,33 @@ HostConstSharedPtr RandomLoadBalancer::chooseHostOnce(LoadBalancerContext* conte
   return hosts_to_use[random_.random() % hosts_to_use.size()];
 }
 
+HostConstSharedPtr PeakEwmaLoadBalancer::chooseHostOnce(LoadBalancerContext* context) {
+  const absl::optional<HostsSource> hosts_source = hostSourceToUse(context);
+  if (!hosts_source) {
+    return nullptr;
+  }
+
+  const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
+  if (hosts_to_use.empty()) {
+    return nullptr;
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  HostSharedPtr candidate_host = nullptr;
+  double candidate_cost = 0;
+  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
+    const HostSharedPtr& sampled_host = hosts_to_use[random_.random() % hosts_to_use.size()];
+    const double sampled_cost = sampled_host->latencyMonitor().latencyEstimate(now) *
+                                (sampled_host->stats().rq_active_.value() + 1) /
+                                sampled_host->weight();
+    if (candidate_host == nullptr || sampled_cost < candidate_cost) {
+      candidate_host = sampled_host;
+      candidate_cost = sampled_cost;
+    }
+  }
+
+  return candidate_host;
+}
+
 } // namespace Upstream
 } // namespace Envoy
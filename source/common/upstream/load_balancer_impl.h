@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "envoy/api/v2/cds.pb.h"
+#include "envoy/common/time.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/upstream/load_balancer.h"
 #include "envoy/upstream/upstream.h"
@@ -476,6 +477,38 @@ public:
   HostConstSharedPtr chooseHostOnce(LoadBalancerContext* context) override;
 };
 
+/**
+ * Peak EWMA load balancer, after the ones of Finagle and Linkerd. Of choice_count random hosts, it
+ * picks the one with the lowest cost. The cost of a host is its latency estimate (see
+ * PeakEwmaHostMonitor) times its number of active requests plus one, divided by its weight. Unlike
+ * the least request load balancer, it sees that a host is slower than others before requests pile
+ * up on it. The latency estimates are shared by all workers, which update them without locking.
+ * New hosts start out with a default latency estimate that decays until the first response, so
+ * that they get an increasing share of the requests.
+ */
+class PeakEwmaLoadBalancer : public ZoneAwareLoadBalancerBase {
+public:
+  PeakEwmaLoadBalancer(
+      const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterStats& stats,
+      Runtime::Loader& runtime, Runtime::RandomGenerator& random, TimeSource& time_source,
+      const envoy::api::v2::Cluster::CommonLbConfig& common_config,
+      const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>& peak_ewma_config)
+      : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
+                                  common_config),
+        time_source_(time_source),
+        choice_count_(
+            peak_ewma_config.has_value()
+                ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(peak_ewma_config.value(), choice_count, 2)
+                : 2) {}
+
+  // Upstream::LoadBalancerBase
+  HostConstSharedPtr chooseHostOnce(LoadBalancerContext* context) override;
+
+private:
+  TimeSource& time_source_;
+  const uint32_t choice_count_;
+};
+
 /**
  * Implementation of LoadBalancerSubsetInfo.
  */
@@ -81,6 +81,7 @@ public:
   Outlier::DetectorHostMonitor& outlierDetector() const override {
     return logical_host_->outlierDetector();
   }
+  LatencyHostMonitor& latencyMonitor() const override { return logical_host_->latencyMonitor(); }
   const HostStats& stats() const override { return logical_host_->stats(); }
   const std::string& hostname() const override { return logical_host_->hostname(); }
   Network::Address::InstanceConstSharedPtr address() const override { return address_; }
@@ -1,11 +1,13 @@
 #include "common/upstream/maglev_lb.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Upstream {
 
 MaglevTable::MaglevTable(const NormalizedHostWeightVector& normalized_host_weights,
                          double max_normalized_weight, uint64_t table_size,
-                         MaglevLoadBalancerStats& stats)
+                         MaglevLoadBalancerStats& stats, bool entry_weights)
     : table_size_(table_size), stats_(stats) {
   // TODO(mattklein123): The Maglev table must have a size that is a prime number for the algorithm
   // to work. Currently, the table size is not user configurable. In the future, if the table size
@@ -31,6 +33,9 @@ MaglevTable::MaglevTable(const NormalizedHostWeightVector& normalized_host_weigh
   }
 
   table_.resize(table_size_);
+  if (entry_weights) {
+    entry_weights_.resize(table_size_);
+  }
 
   // Iterate through the table build entries as many times as it takes to fill up the table.
   uint64_t table_index = 0;
@@ -52,6 +57,9 @@ MaglevTable::MaglevTable(const NormalizedHostWeightVector& normalized_host_weigh
       }
 
       table_[c] = entry.host_;
+      if (entry_weights) {
+        entry_weights_[c] = entry.weight_;
+      }
       entry.next_++;
       entry.count_++;
       table_index++;
@@ -82,6 +90,29 @@ HostConstSharedPtr MaglevTable::chooseHost(uint64_t hash) const {
   return table_[hash % table_size_];
 }
 
+HostConstSharedPtr
+MaglevTable::chooseHost(uint64_t hash, uint32_t max_entries,
+                        const std::function<bool(const Host&, double)>& accept) const {
+  if (table_.empty()) {
+    return nullptr;
+  }
+  ASSERT(entry_weights_.size() == table_size_);
+
+  // Walk the table from the entry of the hash. Consecutive entries of the same host are only
+  // checked once.
+  const uint64_t first = hash % table_size_;
+  const Host* previous_host = nullptr;
+  for (uint64_t i = 0; i < std::min<uint64_t>(max_entries, table_size_); ++i) {
+    const uint64_t index = (first + i) % table_size_;
+    const HostConstSharedPtr& host = table_[index];
+    if (host.get() != previous_host && accept(*host, entry_weights_[index])) {
+      return host;
+    }
+    previous_host = host.get();
+  }
+  return table_[first];
+}
+
 uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
   return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
 }
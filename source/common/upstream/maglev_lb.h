@@ -32,11 +32,16 @@ struct MaglevLoadBalancerStats {
 class MaglevTable : public ThreadAwareLoadBalancerBase::HashingLoadBalancer,
                     Logger::Loggable<Logger::Id::upstream> {
 public:
+  // If entry_weights is set, the weight of the host of each entry is kept for bounded loads.
   MaglevTable(const NormalizedHostWeightVector& normalized_host_weights,
-              double max_normalized_weight, uint64_t table_size, MaglevLoadBalancerStats& stats);
+              double max_normalized_weight, uint64_t table_size, MaglevLoadBalancerStats& stats,
+              bool entry_weights);
 
   // ThreadAwareLoadBalancerBase::HashingLoadBalancer
   HostConstSharedPtr chooseHost(uint64_t hash) const override;
+  HostConstSharedPtr
+  chooseHost(uint64_t hash, uint32_t max_entries,
+             const std::function<bool(const Host&, double)>& accept) const override;
 
   // Recommended table size in section 5.3 of the paper.
   static const uint64_t DefaultTableSize = 65537;
@@ -59,6 +64,9 @@ private:
 
   const uint64_t table_size_;
   std::vector<HostConstSharedPtr> table_;
+  // The normalized weight of the host of each entry of table_, only filled in when loads are
+  // bounded.
+  std::vector<double> entry_weights_;
   MaglevLoadBalancerStats& stats_;
 };
 
@@ -78,9 +86,12 @@ private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double /* min_normalized_weight */, double max_normalized_weight) override {
+                     double /* min_normalized_weight */, double max_normalized_weight,
+                     const HashingLoadBalancerSharedPtr& /* previous_lb */) override {
+    // Every entry of the table may change with any host or weight change, so the table is always
+    // built from scratch. It has a fixed size, which bounds the cost of doing so.
     return std::make_shared<MaglevTable>(normalized_host_weights, max_normalized_weight,
-                                         table_size_, stats_);
+                                         table_size_, stats_, hash_balance_factor_ > 0);
   }
 
   static MaglevLoadBalancerStats generateStats(Stats::Scope& scope);
@@ -28,6 +28,12 @@ public:
    */
   OptPoolRef getPool(ResourcePriority priority, KEY_TYPE key, const PoolFactory& factory);
 
+  /**
+   * Returns an existing pool for the given priority and `key`, without creating one.
+   * @return The pool corresponding to `key`, or `absl::nullopt`.
+   */
+  OptPoolRef findPool(ResourcePriority priority, const KEY_TYPE& key) const;
+
   /**
    * @return the number of pools across all priorities.
    */
@@ -27,6 +27,15 @@ PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::getPool(ResourcePriority priority, KEY
   return conn_pool_maps_[index]->getPool(key, factory);
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+typename PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::OptPoolRef
+PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::findPool(ResourcePriority priority,
+                                                   const KEY_TYPE& key) const {
+  size_t index = static_cast<size_t>(priority);
+  ASSERT(index < conn_pool_maps_.size());
+  return conn_pool_maps_[index]->findPool(key);
+}
+
 template <typename KEY_TYPE, typename POOL_TYPE>
 size_t PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::size() const {
   size_t size = 0;
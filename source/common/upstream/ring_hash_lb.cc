@@ -1,13 +1,16 @@
 #include "common/upstream/ring_hash_lb.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/common/assert.h"
 #include "common/upstream/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -45,6 +48,34 @@ HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h) const {
     return nullptr;
   }
 
+  return ring_[entryIndex(h)].host_;
+}
+
+HostConstSharedPtr
+RingHashLoadBalancer::Ring::chooseHost(
+    uint64_t h, uint32_t max_entries,
+    const std::function<bool(const Host&, double)>& accept) const {
+  if (ring_.empty()) {
+    return nullptr;
+  }
+  ASSERT(entry_weights_.size() == ring_.size());
+
+  // Walk the ring clockwise from the entry of the hash. Consecutive entries of the same host are
+  // only checked once.
+  const uint64_t first = entryIndex(h);
+  const Host* previous_host = nullptr;
+  for (uint64_t i = 0; i < std::min<uint64_t>(max_entries, ring_.size()); ++i) {
+    const uint64_t index = (first + i) % ring_.size();
+    const HostConstSharedPtr& host = ring_[index].host_;
+    if (host.get() != previous_host && accept(*host, entry_weights_[index])) {
+      return host;
+    }
+    previous_host = host.get();
+  }
+  return ring_[first].host_;
+}
+
+uint64_t RingHashLoadBalancer::Ring::entryIndex(uint64_t h) const {
   // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c (ketama_get_server)
   // I've generally kept the variable names to make the code easier to compare.
   // NOTE: The algorithm depends on using signed integers for lowp, midp, and highp. Do not
@@ -55,14 +86,14 @@ HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h) const {
     int64_t midp = (lowp + highp) / 2;
 
     if (midp == static_cast<int64_t>(ring_.size())) {
-      return ring_[0].host_;
+      return 0;
     }
 
     uint64_t midval = ring_[midp].hash_;
     uint64_t midval1 = midp == 0 ? 0 : ring_[midp - 1].hash_;
 
     if (h <= midval && h > midval1) {
-      return ring_[midp].host_;
+      return midp;
     }
 
     if (midval < h) {
@@ -72,7 +103,7 @@ HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h) const {
     }
 
     if (lowp > highp) {
-      return ring_[0].host_;
+      return 0;
     }
   }
 }
@@ -81,7 +112,8 @@ using HashFunction = envoy::api::v2::Cluster_RingHashLbConfig_HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 RingHashLoadBalancerStats& stats)
+                                 RingHashLoadBalancerStats& stats, const Ring* previous_ring,
+                                 bool entry_weights)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -103,10 +135,10 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   const uint64_t ring_size = std::ceil(scale);
   ring_.reserve(ring_size);
 
-  // Populate the hash ring by walking through the (host, weight) pairs in normalized_host_weights,
-  // and generating (scale * weight) hashes for each host. Since these aren't necessarily whole
-  // numbers, we maintain running sums -- current_hashes and target_hashes -- which allows us to
-  // populate the ring in a mostly stable way.
+  // Work out the number of hashes of each host by walking through the (host, weight) pairs in
+  // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
+  // aren't necessarily whole numbers, we maintain running sums -- current_hashes and
+  // target_hashes -- which allows us to populate the ring in a mostly stable way.
   //
   // For example, suppose we have 4 hosts, each with a normalized weight of 0.25, and a scale of
   // 6.0 (because the max_ring_size is 6). That means we want to generate 1.5 hashes per host.
@@ -120,13 +152,51 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-  char hash_key_buffer[196];
+  std::vector<uint64_t> host_hashes;
+  host_hashes.reserve(normalized_host_weights.size());
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
   for (const auto& entry : normalized_host_weights) {
-    const auto& host = entry.first;
+    target_hashes += scale * entry.second;
+    uint64_t i = 0;
+    while (current_hashes < target_hashes) {
+      ++i;
+      ++current_hashes;
+    }
+    host_hashes.push_back(i);
+    if (i > 0) {
+      hashes_per_host_[entry.first.get()] = i;
+    }
+    min_hashes_per_host = std::min(i, min_hashes_per_host);
+    max_hashes_per_host = std::max(i, max_hashes_per_host);
+  }
+
+  // Hash `i` of a host only depends on its address and `i`, so for each host it shares with this
+  // ring, the previous ring already holds the first min(previous hashes, hashes) of them. Only the
+  // remaining hashes of a host are computed here: the ones it gains, which are added to the ring,
+  // and the ones it loses, which are taken out of the previous ring's entries.
+  std::vector<RingEntry> added_entries;
+  if (previous_ring == nullptr) {
+    added_entries.reserve(ring_size);
+  }
+  absl::flat_hash_set<std::pair<const Host*, uint64_t>> removed_hashes;
+  char hash_key_buffer[196];
+  for (size_t index = 0; index < normalized_host_weights.size(); ++index) {
+    const auto& host = normalized_host_weights[index].first;
+    const uint64_t hashes = host_hashes[index];
+    uint64_t previous_hashes = 0;
+    if (previous_ring != nullptr) {
+      const auto it = previous_ring->hashes_per_host_.find(host.get());
+      if (it != previous_ring->hashes_per_host_.end()) {
+        previous_hashes = it->second;
+      }
+    }
+    if (hashes == previous_hashes) {
+      continue;
+    }
+
     const std::string& address_string = host->address()->asString();
     uint64_t offset_start = address_string.size();
 
@@ -142,11 +212,8 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
     memcpy(hash_key_buffer, address_string.c_str(), offset_start);
     hash_key_buffer[offset_start++] = '_';
 
-    // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
-    target_hashes += scale * entry.second;
-    uint64_t i = 0;
-    while (current_hashes < target_hashes) {
+    for (uint64_t i = std::min(hashes, previous_hashes); i < std::max(hashes, previous_hashes);
+         ++i) {
       const uint64_t total_hash_key_len =
           offset_start +
           StringUtil::itoa(hash_key_buffer + offset_start, StringUtil::MIN_ITOA_OUT_LEN, i);
@@ -158,17 +225,47 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
               : HashUtil::xxHash64(hash_key);
 
       ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key.data(), hash);
-      ring_.push_back({hash, host});
-      ++i;
-      ++current_hashes;
+      if (i < hashes) {
+        added_entries.push_back({hash, host});
+      } else {
+        removed_hashes.insert({host.get(), hash});
+      }
     }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+  // The entries kept from the previous ring are already sorted, so only the added ones need to be
+  // sorted before merging both.
+  if (previous_ring != nullptr) {
+    for (const RingEntry& entry : previous_ring->ring_) {
+      const Host* host = entry.host_.get();
+      if (hashes_per_host_.contains(host) &&
+          (removed_hashes.empty() || !removed_hashes.contains(std::make_pair(host, entry.hash_)))) {
+        ring_.push_back(entry);
+      }
+    }
+  }
+  const auto compare = [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
     return lhs.hash_ < rhs.hash_;
-  });
+  };
+  std::sort(added_entries.begin(), added_entries.end(), compare);
+  if (ring_.empty()) {
+    ring_ = std::move(added_entries);
+  } else {
+    const auto kept_entries = ring_.size();
+    ring_.insert(ring_.end(), std::make_move_iterator(added_entries.begin()),
+                 std::make_move_iterator(added_entries.end()));
+    std::inplace_merge(ring_.begin(), ring_.begin() + kept_entries, ring_.end(), compare);
+  }
+  if (entry_weights) {
+    absl::flat_hash_map<const Host*, double> weight_per_host;
+    for (const auto& entry : normalized_host_weights) {
+      weight_per_host[entry.first.get()] = entry.second;
+    }
+    entry_weights_.reserve(ring_.size());
+    for (const RingEntry& entry : ring_) {
+      entry_weights_.push_back(weight_per_host[entry.host_.get()]);
+    }
+  }
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     for (const auto& entry : ring_) {
       ENVOY_LOG(trace, "ring hash: host={} hash={}", entry.host_->address()->asString(),
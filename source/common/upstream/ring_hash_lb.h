@@ -9,6 +9,8 @@
 #include "common/common/logger.h"
 #include "common/upstream/thread_aware_lb_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -55,14 +57,29 @@ private:
   };
 
   struct Ring : public HashingLoadBalancer {
+    // If previous_ring is set, the entries it shares with the new ring are taken from it rather
+    // than hashed and sorted again. It must have been built with the same hash function. If
+    // entry_weights is set, the weight of the host of each entry is kept for bounded loads.
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         RingHashLoadBalancerStats& stats);
+         RingHashLoadBalancerStats& stats, const Ring* previous_ring, bool entry_weights);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostConstSharedPtr chooseHost(uint64_t hash) const override;
+    HostConstSharedPtr
+    chooseHost(uint64_t hash, uint32_t max_entries,
+               const std::function<bool(const Host&, double)>& accept) const override;
+
+    // Index of the entry that a hash maps to.
+    uint64_t entryIndex(uint64_t h) const;
 
     std::vector<RingEntry> ring_;
+    // The normalized weight of the host of each entry of ring_, only filled in when loads are
+    // bounded. Entries taken from a previous ring may have had other weights, so these are kept
+    // apart from them.
+    std::vector<double> entry_weights_;
+    // Number of entries of each host on the ring. Hosts without entries are left out.
+    absl::flat_hash_map<const Host*, uint64_t> hashes_per_host_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -71,9 +88,12 @@ private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double min_normalized_weight, double /* max_normalized_weight */) override {
+                     double min_normalized_weight, double /* max_normalized_weight */,
+                     const HashingLoadBalancerSharedPtr& previous_lb) override {
     return std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                                  max_ring_size_, hash_function_, stats_);
+                                  max_ring_size_, hash_function_, stats_,
+                                  dynamic_cast<const Ring*>(previous_lb.get()),
+                                  hash_balance_factor_ > 0);
   }
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
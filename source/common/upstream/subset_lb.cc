@@ -669,8 +669,10 @@ SubsetLoadBalancer::PrioritySubsetImpl::PrioritySubsetImpl(const SubsetLoadBalan
 
   case LoadBalancerType::OriginalDst:
   case LoadBalancerType::ClusterProvided:
+  case LoadBalancerType::PeakEwma:
     // LoadBalancerType::OriginalDst is blocked in the factory. LoadBalancerType::ClusterProvided
     // is impossible because the subset LB returns a null load balancer from its factory.
+    // LoadBalancerType::PeakEwma cannot be combined with subsets, see ClusterInfoImpl.
     NOT_REACHED_GCOVR_EXCL_LINE;
   }
 
@@ -1,5 +1,6 @@
 #include "common/upstream/thread_aware_lb_impl.h"
 
+#include <cmath>
 #include <memory>
 
 namespace Envoy {
@@ -70,6 +71,9 @@ void normalizeWeights(const HostSet& host_set, bool in_panic,
   }
 }
 
+// See ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHostWithBoundedLoad().
+constexpr uint32_t MaxBoundedLoadEntriesPerHost = 8;
+
 } // namespace
 
 void ThreadAwareLoadBalancerBase::initialize() {
@@ -107,8 +111,24 @@ void ThreadAwareLoadBalancerBase::refresh() {
     double max_normalized_weight = 0.0;
     normalizeWeights(*host_set, per_priority_state->global_panic_, normalized_host_weights,
                      min_normalized_weight, max_normalized_weight);
-    per_priority_state->current_lb_ =
-        createLoadBalancer(normalized_host_weights, min_normalized_weight, max_normalized_weight);
+
+    // Every update rebuilds all priorities, while it usually changes the hosts of only one of
+    // them. The load balancer only depends on the normalized weights, so if these are the same as
+    // last time, the previous one can be shared.
+    HashingLoadBalancerSharedPtr previous_lb;
+    if (per_priority_state_ != nullptr && priority < per_priority_state_->size()) {
+      const auto& previous_state = (*per_priority_state_)[priority];
+      if (previous_state->normalized_host_weights_ == normalized_host_weights) {
+        per_priority_state->current_lb_ = previous_state->current_lb_;
+        per_priority_state->normalized_host_weights_ = std::move(normalized_host_weights);
+        continue;
+      }
+      previous_lb = previous_state->current_lb_;
+    }
+
+    per_priority_state->current_lb_ = createLoadBalancer(
+        normalized_host_weights, min_normalized_weight, max_normalized_weight, previous_lb);
+    per_priority_state->normalized_host_weights_ = std::move(normalized_host_weights);
   }
 
   {
@@ -117,6 +137,7 @@ void ThreadAwareLoadBalancerBase::refresh() {
     factory_->degraded_per_priority_load_ = degraded_per_priority_load;
     factory_->per_priority_state_ = per_priority_state_vector;
   }
+  per_priority_state_ = std::move(per_priority_state_vector);
 }
 
 HostConstSharedPtr
@@ -142,11 +163,37 @@ ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHost(LoadBalancerContext* c
   if (per_priority_state->global_panic_) {
     stats_.lb_healthy_panic_.inc();
   }
+  if (hash_balance_factor_ > 0) {
+    return chooseHostWithBoundedLoad(*per_priority_state, h);
+  }
   return per_priority_state->current_lb_->chooseHost(h);
 }
 
+HostConstSharedPtr ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHostWithBoundedLoad(
+    const PerPriorityState& per_priority_state, uint64_t hash) const {
+  // Consistent hashing with bounded loads (https://arxiv.org/abs/1608.01350). The active request
+  // counts are the ones of all workers, so the bounds hold for the whole cluster. Each host may
+  // have up to hash_balance_factor_ percent of its share of the active requests of the cluster,
+  // which the cluster's gauge keeps a running total of, rounded up. As the hosts of a priority
+  // have at most all of the cluster's active requests, there is always one below its bound. The
+  // entries following the one the hash maps to are tried in turn until one of their hosts is.
+  // Since the entries of a host are spread over the ring or table, a few times the number of
+  // hosts is enough entries to come across all of them.
+  const double total_active = stats_.upstream_rq_active_.value() + 1;
+  const double max_active_per_weight = total_active * hash_balance_factor_ / 100;
+  const uint32_t max_entries =
+      MaxBoundedLoadEntriesPerHost * per_priority_state.normalized_host_weights_.size();
+
+  // If all hosts tried are overloaded, which can only happen briefly while hosts are added or
+  // removed, the request keeps its affinity.
+  return per_priority_state.current_lb_->chooseHost(
+      hash, max_entries, [max_active_per_weight](const Host& host, double weight) {
+        return host.stats().rq_active_.value() + 1 <= std::ceil(max_active_per_weight * weight);
+      });
+}
+
 LoadBalancerPtr ThreadAwareLoadBalancerBase::LoadBalancerFactoryImpl::create() {
-  auto lb = std::make_unique<LoadBalancerImpl>(stats_, random_);
+  auto lb = std::make_unique<LoadBalancerImpl>(stats_, random_, hash_balance_factor_);
 
   // We must protect current_lb_ via a RW lock since it is accessed and written to by multiple
   // threads. All complex processing has already been precalculated however.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "common/upstream/load_balancer_impl.h"
 
 #include "absl/synchronization/mutex.h"
@@ -22,7 +24,24 @@ public:
   class HashingLoadBalancer {
   public:
     virtual ~HashingLoadBalancer() = default;
+
     virtual HostConstSharedPtr chooseHost(uint64_t hash) const PURE;
+
+    /**
+     * Walk the entries from the one the hash maps to onwards, wrapping around, until one's host is
+     * accepted. This is used to find a host that is not overloaded when loads are bounded, and is
+     * only supported by load balancers built while loads are bounded, which keep the weight of the
+     * host of each entry.
+     * @param hash supplies the hash of the request.
+     * @param max_entries supplies the number of entries to look at, at most.
+     * @param accept supplies the predicate a host must satisfy, given the host and its normalized
+     *        weight.
+     * @return the host of the first accepted entry, the host of the entry the hash maps to if no
+     *         entry is accepted, or nullptr if there are no hosts.
+     */
+    virtual HostConstSharedPtr
+    chooseHost(uint64_t hash, uint32_t max_entries,
+               const std::function<bool(const Host&, double)>& accept) const PURE;
   };
   using HashingLoadBalancerSharedPtr = std::shared_ptr<HashingLoadBalancer>;
 
@@ -40,38 +59,52 @@ protected:
                               Runtime::Loader& runtime, Runtime::RandomGenerator& random,
                               const envoy::api::v2::Cluster::CommonLbConfig& common_config)
       : LoadBalancerBase(priority_set, stats, runtime, random, common_config),
-        factory_(new LoadBalancerFactoryImpl(stats, random)) {}
+        hash_balance_factor_(
+            PROTOBUF_GET_WRAPPED_OR_DEFAULT(common_config, hash_balance_factor, 0)),
+        factory_(new LoadBalancerFactoryImpl(stats, random, hash_balance_factor_)) {}
+
+  // Percentage of its share of the active requests a host may have, or 0 if loads are unbounded.
+  const uint32_t hash_balance_factor_;
 
 private:
   struct PerPriorityState {
     std::shared_ptr<HashingLoadBalancer> current_lb_;
     bool global_panic_{};
+    // The weights current_lb_ was built from, used by refresh() to detect unchanged priorities.
+    NormalizedHostWeightVector normalized_host_weights_;
   };
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
 
   struct LoadBalancerImpl : public LoadBalancer {
-    LoadBalancerImpl(ClusterStats& stats, Runtime::RandomGenerator& random)
-        : stats_(stats), random_(random) {}
+    LoadBalancerImpl(ClusterStats& stats, Runtime::RandomGenerator& random,
+                     uint32_t hash_balance_factor)
+        : stats_(stats), random_(random), hash_balance_factor_(hash_balance_factor) {}
 
     // Upstream::LoadBalancer
     HostConstSharedPtr chooseHost(LoadBalancerContext* context) override;
 
+    HostConstSharedPtr chooseHostWithBoundedLoad(const PerPriorityState& per_priority_state,
+                                                 uint64_t hash) const;
+
     ClusterStats& stats_;
     Runtime::RandomGenerator& random_;
+    const uint32_t hash_balance_factor_;
     std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_;
     std::shared_ptr<HealthyLoad> healthy_per_priority_load_;
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_;
   };
 
   struct LoadBalancerFactoryImpl : public LoadBalancerFactory {
-    LoadBalancerFactoryImpl(ClusterStats& stats, Runtime::RandomGenerator& random)
-        : stats_(stats), random_(random) {}
+    LoadBalancerFactoryImpl(ClusterStats& stats, Runtime::RandomGenerator& random,
+                            uint32_t hash_balance_factor)
+        : stats_(stats), random_(random), hash_balance_factor_(hash_balance_factor) {}
 
     // Upstream::LoadBalancerFactory
     LoadBalancerPtr create() override;
 
     ClusterStats& stats_;
     Runtime::RandomGenerator& random_;
+    const uint32_t hash_balance_factor_;
     absl::Mutex mutex_;
     std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_ ABSL_GUARDED_BY(mutex_);
     // This is split out of PerPriorityState so LoadBalancerBase::ChoosePriority can be reused.
@@ -79,12 +112,24 @@ private:
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_ ABSL_GUARDED_BY(mutex_);
   };
 
+  /**
+   * Build the hashing load balancer of a priority.
+   * @param normalized_host_weights supplies the hosts and their weights, which sum up to 1.
+   * @param min_normalized_weight supplies the smallest weight in normalized_host_weights.
+   * @param max_normalized_weight supplies the largest weight in normalized_host_weights.
+   * @param previous_lb supplies the load balancer previously built for the priority, or nullptr.
+   *        Implementations may reuse the parts of it that are still valid. It is only ever a load
+   *        balancer returned by an earlier call.
+   */
   virtual HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double min_normalized_weight, double max_normalized_weight) PURE;
+                     double min_normalized_weight, double max_normalized_weight,
+                     const HashingLoadBalancerSharedPtr& previous_lb) PURE;
   void refresh();
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
+  // The state last published to factory_. Only accessed from the main thread.
+  std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_;
 };
 
 } // namespace Upstream
@@ -593,6 +593,9 @@ ClusterInfoImpl::ClusterInfoImpl(
     : runtime_(runtime), name_(config.name()), type_(config.type()),
       max_requests_per_connection_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_requests_per_connection, 0)),
+      spare_connections_per_host_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, spare_connections_per_host, 0)),
+      pool_warming_(config.pool_warming()),
       connect_timeout_(
           std::chrono::milliseconds(PROTOBUF_GET_MS_REQUIRED(config, connect_timeout))),
       per_connection_buffer_limit_bytes_(
@@ -607,6 +610,7 @@ ClusterInfoImpl::ClusterInfoImpl(
       maintenance_mode_runtime_key_(fmt::format("upstream.maintenance_mode.{}", name_)),
       source_address_(getSourceAddress(config, bind_config)),
       lb_least_request_config_(config.least_request_lb_config()),
+      lb_peak_ewma_config_(config.peak_ewma_lb_config()),
       lb_ring_hash_config_(config.ring_hash_lb_config()),
       lb_original_dst_config_(config.original_dst_lb_config()), added_via_api_(added_via_api),
       lb_subset_(LoadBalancerSubsetInfoImpl(config.lb_subset_config())),
@@ -663,6 +667,15 @@ ClusterInfoImpl::ClusterInfoImpl(
 
     lb_type_ = LoadBalancerType::ClusterProvided;
     break;
+  case envoy::api::v2::Cluster::PEAK_EWMA:
+    if (config.has_lb_subset_config()) {
+      throw EnvoyException(
+          fmt::format("cluster: LB policy {} cannot be combined with lb_subset_config",
+                      envoy::api::v2::Cluster_LbPolicy_Name(config.lb_policy())));
+    }
+
+    lb_type_ = LoadBalancerType::PeakEwma;
+    break;
   default:
     NOT_REACHED_GCOVR_EXCL_LINE;
   }
@@ -682,10 +695,26 @@ ClusterInfoImpl::ClusterInfoImpl(
     }
   }
 
+  if (pool_warming_ != envoy::api::v2::Cluster::NO_POOL_WARMING) {
+    if (spare_connections_per_host_ == 0) {
+      throw EnvoyException(
+          fmt::format("cluster {}: pool_warming requires spare_connections_per_host", name_));
+    }
+    if (pool_warming_ == envoy::api::v2::Cluster::HTTP1_POOL &&
+        (features_ & Features::HTTP2) && !(features_ & Features::USE_DOWNSTREAM_PROTOCOL)) {
+      throw EnvoyException(fmt::format(
+          "cluster {}: pool_warming HTTP1_POOL is not supported by clusters that only use HTTP2",
+          name_));
+    }
+  }
+
   if (config.common_http_protocol_options().has_idle_timeout()) {
     idle_timeout_ = std::chrono::milliseconds(
         DurationUtil::durationToMilliseconds(config.common_http_protocol_options().idle_timeout()));
   }
+  if (config.has_max_http2_connections_per_host()) {
+    max_http2_connections_per_host_ = config.max_http2_connections_per_host().value();
+  }
   if (config.has_eds_cluster_config()) {
     if (config.type() != envoy::api::v2::Cluster::EDS) {
       throw EnvoyException("eds_cluster_config set in a non-EDS cluster");
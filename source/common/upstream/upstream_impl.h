@@ -39,6 +39,7 @@
 #include "common/init/manager_impl.h"
 #include "common/network/utility.h"
 #include "common/stats/isolated_store_impl.h"
+#include "common/upstream/latency_host_monitor_impl.h"
 #include "common/upstream/load_balancer_impl.h"
 #include "common/upstream/outlier_detection_impl.h"
 #include "common/upstream/resource_manager_impl.h"
@@ -90,6 +91,9 @@ public:
         health_check_config.port_value() == 0
             ? dest_address
             : Network::Utility::getAddressWithPort(*dest_address, health_check_config.port_value());
+    if (cluster->lbType() == LoadBalancerType::PeakEwma) {
+      latency_monitor_ = std::make_unique<PeakEwmaHostMonitor>(cluster->lbPeakEwmaConfig());
+    }
   }
 
   // Upstream::HostDescription
@@ -133,6 +137,14 @@ public:
       return *null_outlier_detector;
     }
   }
+  LatencyHostMonitor& latencyMonitor() const override {
+    if (latency_monitor_) {
+      return *latency_monitor_;
+    } else {
+      static LatencyHostMonitorNullImpl* null_latency_monitor = new LatencyHostMonitorNullImpl();
+      return *null_latency_monitor;
+    }
+  }
   const HostStats& stats() const override { return stats_; }
   const std::string& hostname() const override { return hostname_; }
   Network::Address::InstanceConstSharedPtr address() const override { return address_; }
@@ -160,6 +172,7 @@ protected:
   HostStats stats_;
   Outlier::DetectorHostMonitorPtr outlier_detector_;
   HealthCheckHostMonitorPtr health_checker_;
+  LatencyHostMonitorPtr latency_monitor_;
   std::atomic<uint32_t> priority_;
 };
 
@@ -530,6 +543,9 @@ public:
   const absl::optional<std::chrono::milliseconds> idleTimeout() const override {
     return idle_timeout_;
   }
+  const absl::optional<uint32_t> maxHttp2ConnectionsPerHost() const override {
+    return max_http2_connections_per_host_;
+  }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -546,6 +562,10 @@ public:
   lbLeastRequestConfig() const override {
     return lb_least_request_config_;
   }
+  const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>&
+  lbPeakEwmaConfig() const override {
+    return lb_peak_ewma_config_;
+  }
   const absl::optional<envoy::api::v2::Cluster::RingHashLbConfig>&
   lbRingHashConfig() const override {
     return lb_ring_hash_config_;
@@ -561,6 +581,8 @@ public:
   Network::TransportSocketFactory& transportSocketFactory() const override {
     return *transport_socket_factory_;
   }
+  uint32_t spareConnectionsPerHost() const override { return spare_connections_per_host_; }
+  envoy::api::v2::Cluster::PoolWarming poolWarming() const override { return pool_warming_; }
   ClusterStats& stats() const override { return stats_; }
   Stats::Scope& statsScope() const override { return *stats_scope_; }
   ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
@@ -599,8 +621,11 @@ private:
   const std::string name_;
   const envoy::api::v2::Cluster::DiscoveryType type_;
   const uint64_t max_requests_per_connection_;
+  const uint32_t spare_connections_per_host_;
+  const envoy::api::v2::Cluster::PoolWarming pool_warming_;
   const std::chrono::milliseconds connect_timeout_;
   absl::optional<std::chrono::milliseconds> idle_timeout_;
+  absl::optional<uint32_t> max_http2_connections_per_host_;
   const uint32_t per_connection_buffer_limit_bytes_;
   Network::TransportSocketFactoryPtr transport_socket_factory_;
   Stats::ScopePtr stats_scope_;
@@ -615,6 +640,7 @@ private:
   const Network::Address::InstanceConstSharedPtr source_address_;
   LoadBalancerType lb_type_;
   absl::optional<envoy::api::v2::Cluster::LeastRequestLbConfig> lb_least_request_config_;
+  absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig> lb_peak_ewma_config_;
   absl::optional<envoy::api::v2::Cluster::RingHashLbConfig> lb_ring_hash_config_;
   absl::optional<envoy::api::v2::Cluster::OriginalDstLbConfig> lb_original_dst_config_;
   const bool added_via_api_;
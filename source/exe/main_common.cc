@@ -47,8 +47,9 @@ MainCommonBase::MainCommonBase(const OptionsImpl& options, Event::TimeSystem& ti
                                std::unique_ptr<ProcessContext> process_context)
     : options_(options), component_factory_(component_factory), thread_factory_(thread_factory),
       file_system_(file_system), symbol_table_(Stats::SymbolTableCreator::initAndMakeSymbolTable(
-                                     options_.fakeSymbolTableEnabled())),
-      stats_allocator_(*symbol_table_) {
+                                     options_.fakeSymbolTableEnabled(),
+                                     options_.statsSymbolTableShards())),
+      stats_allocator_(*symbol_table_, options_.statsCounterShards()) {
   switch (options_.mode()) {
   case Server::Mode::InitOnly:
   case Server::Mode::Serve: {
@@ -74,7 +75,8 @@ MainCommonBase::MainCommonBase(const OptionsImpl& options, Event::TimeSystem& ti
     // block or not.
     std::set_new_handler([]() { PANIC("out of memory"); });
 
-    stats_store_ = std::make_unique<Stats::ThreadLocalStoreImpl>(stats_allocator_);
+    stats_store_ = std::make_unique<Stats::ThreadLocalStoreImpl>(
+        stats_allocator_, options_.statsLockFreeHistograms());
 
     server_ = std::make_unique<Server::InstanceImpl>(
         options_, time_system, local_address, listener_hooks, *restarter_, *stats_store_,
@@ -68,6 +68,14 @@ public:
   }
   void detectEarlyCloseWhenReadDisabled(bool /*value*/) override { NOT_REACHED_GCOVR_EXCL_LINE; }
   bool readEnabled() const override { return true; }
+  const Network::IoHandle& ioHandle() const override {
+    // QUIC connections share the listener's UDP socket and have no socket of their own.
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
+  void takeOverSocketEvents(SocketEventCb /*cb*/, Buffer::Instance& /*read_data*/,
+                            Buffer::Instance& /*write_data*/) override {
+    NOT_REACHED_GCOVR_EXCL_LINE;
+  }
   const Network::Address::InstanceConstSharedPtr& remoteAddress() const override;
   const Network::Address::InstanceConstSharedPtr& localAddress() const override;
   absl::optional<Network::Connection::UnixDomainSocketPeerCredentials>
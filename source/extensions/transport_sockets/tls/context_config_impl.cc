@@ -10,6 +10,8 @@
 #include "common/secret/sds_api.h"
 #include "common/ssl/certificate_validation_context_config_impl.h"
 
+#include "extensions/transport_sockets/tls/ktls.h"
+
 #include "openssl/ssl.h"
 
 namespace Envoy {
@@ -123,7 +125,11 @@ ContextConfigImpl::ContextConfigImpl(
       min_protocol_version_(tlsVersionFromProto(config.tls_params().tls_minimum_protocol_version(),
                                                 default_min_protocol_version)),
       max_protocol_version_(tlsVersionFromProto(config.tls_params().tls_maximum_protocol_version(),
-                                                default_max_protocol_version)) {
+                                                default_max_protocol_version)),
+      kernel_tls_tx_offload_(config.kernel_tls_tx_offload()) {
+  if (kernel_tls_tx_offload_ && !KernelTls::isSupported()) {
+    throw EnvoyException("kernel_tls_tx_offload is not supported on this platform");
+  }
   if (default_cvc_ && certificate_validation_context_provider_ != nullptr) {
     // We need to validate combined certificate validation context.
     // The default certificate validation context and dynamic certificate validation
@@ -287,6 +293,10 @@ ClientContextConfigImpl::ClientContextConfigImpl(
        config.common_tls_context().tls_certificate_sds_secret_configs().size()) > 1) {
     throw EnvoyException("Multiple TLS certificates are not supported for client contexts");
   }
+  // Renegotiation changes the keys after the handshake, behind the kernel's back.
+  if (allow_renegotiation_ && kernelTlsTxOffload()) {
+    throw EnvoyException("kernel_tls_tx_offload cannot be used with allow_renegotiation");
+  }
 }
 
 const unsigned ServerContextConfigImpl::DEFAULT_MIN_VERSION = TLS1_VERSION;
@@ -51,7 +51,8 @@ bool cbsContainsU16(CBS& cbs, uint16_t n) {
 ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& config,
                          TimeSource& time_source)
     : scope_(scope), stats_(generateStats(scope)), time_source_(time_source),
-      tls_max_version_(config.maxProtocolVersion()), stat_name_set_(scope.symbolTable()),
+      tls_max_version_(config.maxProtocolVersion()),
+      kernel_tls_tx_offload_(config.kernelTlsTxOffload()), stat_name_set_(scope.symbolTable()),
       unknown_ssl_cipher_(stat_name_set_.add("unknown_ssl_cipher")),
       unknown_ssl_curve_(stat_name_set_.add("unknown_ssl_curve")),
       unknown_ssl_algorithm_(stat_name_set_.add("unknown_ssl_algorithm")),
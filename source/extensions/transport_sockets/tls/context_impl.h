@@ -38,7 +38,9 @@ namespace Tls {
   COUNTER(fail_verify_no_cert)                                                                     \
   COUNTER(fail_verify_error)                                                                       \
   COUNTER(fail_verify_san)                                                                         \
-  COUNTER(fail_verify_cert_hash)
+  COUNTER(fail_verify_cert_hash)                                                                   \
+  COUNTER(ktls_tx_offloaded)                                                                       \
+  COUNTER(ktls_tx_unsupported)
 // clang-format on
 
 /**
@@ -76,6 +78,7 @@ public:
   static bool dNSNameMatch(const std::string& dnsName, const char* pattern);
 
   SslStats& stats() { return stats_; }
+  bool kernelTlsTxOffload() const { return kernel_tls_tx_offload_; }
 
   // Ssl::Context
   size_t daysUntilFirstCertExpires() const override;
@@ -171,6 +174,7 @@ protected:
   std::string cert_chain_file_path_;
   TimeSource& time_source_;
   const unsigned tls_max_version_;
+  const bool kernel_tls_tx_offload_;
   mutable Stats::StatNameSet stat_name_set_;
   const Stats::StatName unknown_ssl_cipher_;
   const Stats::StatName unknown_ssl_curve_;
@@ -0,0 +1,186 @@
+#include "extensions/transport_sockets/tls/ktls.h"
+
+#include <cstring>
+#include <vector>
+
+#include "envoy/common/platform.h"
+
+#include "common/api/os_sys_calls_impl.h"
+#include "common/common/assert.h"
+#include "common/common/logger.h"
+
+#include "openssl/crypto.h"
+#include "openssl/nid.h"
+
+#ifdef __linux__
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+#ifdef __linux__
+namespace {
+
+// RFC 5246 section 6.2.1 and 7.2.
+constexpr unsigned char ContentTypeAlert = 21;
+constexpr unsigned char AlertLevelWarning = 1;
+constexpr unsigned char AlertCloseNotify = 0;
+
+void writeSequenceNumber(uint64_t seq, unsigned char* out) {
+  for (int i = 7; i >= 0; i--) {
+    out[i] = seq & 0xff;
+    seq >>= 8;
+  }
+}
+
+template <class CryptoInfo> bool setTxCryptoInfo(int fd, CryptoInfo& info) {
+  const Api::SysCallIntResult result =
+      Api::OsSysCallsSingleton::get().setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (result.rc_ != 0) {
+    ENVOY_LOG_MISC(debug, "kTLS: setting TLS_TX failed: {}", result.errno_);
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool isSupported() { return true; }
+
+bool enableTx(SSL* ssl, int fd) {
+  // TLS 1.3 can rekey and send session tickets after the handshake, which needs BoringSSL to keep
+  // writing to the socket.
+  if (SSL_version(ssl) != TLS1_2_VERSION || SSL_in_false_start(ssl)) {
+    ENVOY_LOG_MISC(debug, "kTLS: unsupported protocol version {}", SSL_get_version(ssl));
+    return false;
+  }
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const int nid = cipher != nullptr ? SSL_CIPHER_get_cipher_nid(cipher) : NID_undef;
+  size_t key_len;
+  size_t iv_len;
+  switch (nid) {
+  case NID_aes_128_gcm:
+    key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    iv_len = TLS_CIPHER_AES_GCM_256_SALT_SIZE;
+    break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  case NID_chacha20_poly1305:
+    key_len = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    iv_len = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+#endif
+  default:
+    ENVOY_LOG_MISC(debug, "kTLS: unsupported cipher {}",
+                   cipher != nullptr ? SSL_CIPHER_get_name(cipher) : "none");
+    return false;
+  }
+
+  // AEAD ciphers have no MAC keys, so the key block is client_write_key, server_write_key,
+  // client_write_IV, server_write_IV (RFC 5246 section 6.3).
+  const size_t key_block_len = SSL_get_key_block_len(ssl);
+  if (key_block_len != 2 * (key_len + iv_len)) {
+    ENVOY_LOG_MISC(debug, "kTLS: unexpected key block length {}", key_block_len);
+    return false;
+  }
+  std::vector<uint8_t> key_block(key_block_len);
+  if (!SSL_generate_key_block(ssl, key_block.data(), key_block_len)) {
+    return false;
+  }
+  const bool server = SSL_is_server(ssl);
+  const uint8_t* key = key_block.data() + (server ? key_len : 0);
+  const uint8_t* iv = key_block.data() + 2 * key_len + (server ? iv_len : 0);
+
+  bool enabled = false;
+  static const char ulp[] = "tls";
+  const Api::SysCallIntResult ulp_result =
+      Api::OsSysCallsSingleton::get().setsockopt(fd, SOL_TCP, TCP_ULP, ulp, sizeof(ulp) - 1);
+  if (ulp_result.rc_ != 0) {
+    // Typically ENOENT when the tls module is not available.
+    ENVOY_LOG_MISC(debug, "kTLS: attaching the tls ULP failed: {}", ulp_result.errno_);
+  } else if (nid == NID_aes_128_gcm) {
+    tls12_crypto_info_aes_gcm_128 info{};
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.key, key, key_len);
+    memcpy(info.salt, iv, iv_len);
+    // BoringSSL uses the record sequence number as the explicit nonce, the kernel keeps counting
+    // from the value given here.
+    writeSequenceNumber(SSL_get_write_sequence(ssl), info.iv);
+    writeSequenceNumber(SSL_get_write_sequence(ssl), info.rec_seq);
+    enabled = setTxCryptoInfo(fd, info);
+  } else if (nid == NID_aes_256_gcm) {
+    tls12_crypto_info_aes_gcm_256 info{};
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+    memcpy(info.key, key, key_len);
+    memcpy(info.salt, iv, iv_len);
+    writeSequenceNumber(SSL_get_write_sequence(ssl), info.iv);
+    writeSequenceNumber(SSL_get_write_sequence(ssl), info.rec_seq);
+    enabled = setTxCryptoInfo(fd, info);
+  }
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  else {
+    ASSERT(nid == NID_chacha20_poly1305);
+    tls12_crypto_info_chacha20_poly1305 info{};
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    memcpy(info.key, key, key_len);
+    memcpy(info.iv, iv, iv_len);
+    writeSequenceNumber(SSL_get_write_sequence(ssl), info.rec_seq);
+    enabled = setTxCryptoInfo(fd, info);
+  }
+#endif
+
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+  return enabled;
+}
+
+bool sendCloseNotify(int fd) {
+  unsigned char alert[] = {AlertLevelWarning, AlertCloseNotify};
+  iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+
+  char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+  *CMSG_DATA(cmsg) = ContentTypeAlert;
+
+  return Api::OsSysCallsSingleton::get().sendmsg(fd, &message, 0).rc_ ==
+         static_cast<ssize_t>(sizeof(alert));
+}
+#else
+bool isSupported() { return false; }
+
+bool enableTx(SSL*, int) { return false; }
+
+bool sendCloseNotify(int) { return false; }
+#endif
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * @return true if the platform can encrypt TLS records in the kernel.
+ */
+bool isSupported();
+
+/**
+ * Hand the transmit keys of a completed TLS 1.2 AES-GCM or ChaCha20-Poly1305 session to the
+ * kernel. On success, plaintext written to fd is framed and encrypted by the kernel and ssl must
+ * not write to the socket anymore: its sequence numbers are no longer in sync with the stream.
+ * Reads are not affected. On failure, nothing has changed for ssl and it can be used as before.
+ * @param ssl supplies the session. Its handshake must be complete.
+ * @param fd supplies the TCP socket the session runs over.
+ * @return true if the kernel took over record encryption for writes.
+ */
+bool enableTx(SSL* ssl, int fd);
+
+/**
+ * Send a close_notify alert on a socket set up with enableTx().
+ * @param fd supplies the socket.
+ * @return true if the alert was written to the socket.
+ */
+bool sendCloseNotify(int fd);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
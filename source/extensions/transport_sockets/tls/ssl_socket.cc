@@ -7,6 +7,7 @@
 #include "common/common/hex.h"
 #include "common/http/headers.h"
 
+#include "extensions/transport_sockets/tls/ktls.h"
 #include "extensions/transport_sockets/tls/utility.h"
 
 #include "absl/strings/str_replace.h"
@@ -176,6 +177,7 @@ PostIoAction SslSocket::doHandshake() {
     ENVOY_CONN_LOG(debug, "handshake complete", callbacks_->connection());
     state_ = SocketState::HandshakeComplete;
     ctx_->logHandshake(ssl_);
+    maybeEnableKernelTlsTx();
     callbacks_->raiseEvent(Network::ConnectionEvent::Connected);
 
     // It's possible that we closed during the handshake callback.
@@ -202,6 +204,22 @@ PostIoAction SslSocket::doHandshake() {
   }
 }
 
+void SslSocket::maybeEnableKernelTlsTx() {
+  if (!ctx_->kernelTlsTxOffload()) {
+    return;
+  }
+  // Nothing has been written with SSL_write() yet, so the handshake is the last data BoringSSL
+  // wrote and its write sequence number is where the kernel picks up.
+  if (KernelTls::enableTx(ssl_, callbacks_->ioHandle().fd())) {
+    ENVOY_CONN_LOG(debug, "TLS record encryption offloaded to the kernel",
+                   callbacks_->connection());
+    kernel_tls_tx_ = true;
+    ctx_->stats().ktls_tx_offloaded_.inc();
+  } else {
+    ctx_->stats().ktls_tx_unsupported_.inc();
+  }
+}
+
 void SslSocket::drainErrorQueue() {
   bool saw_error = false;
   bool saw_counted_error = false;
@@ -238,6 +256,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -286,6 +308,31 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  ASSERT(bytes_to_retry_ == 0);
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    // The kernel frames and encrypts plaintext written to the socket.
+    Api::IoCallUint64Result result = write_buffer.write(callbacks_->ioHandle());
+    if (result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls write returns: {}", callbacks_->connection(), result.rc_);
+      total_bytes_written += result.rc_;
+    } else if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+      break;
+    } else {
+      ENVOY_CONN_LOG(debug, "ktls write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(state_ == SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -294,9 +341,16 @@ void SslSocket::shutdownSsl() {
   ASSERT(state_ != SocketState::PreHandshake);
   if (state_ != SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
-    int rc = SSL_shutdown(ssl_);
-    ENVOY_CONN_LOG(debug, "SSL shutdown: rc={}", callbacks_->connection(), rc);
-    drainErrorQueue();
+    if (kernel_tls_tx_) {
+      // BoringSSL's write state is stale, so the kernel has to send the close_notify alert.
+      const bool sent = KernelTls::sendCloseNotify(callbacks_->ioHandle().fd());
+      ENVOY_CONN_LOG(debug, "SSL shutdown: kernel close_notify sent={}", callbacks_->connection(),
+                     sent);
+    } else {
+      int rc = SSL_shutdown(ssl_);
+      ENVOY_CONN_LOG(debug, "SSL shutdown: rc={}", callbacks_->connection(), rc);
+      drainErrorQueue();
+    }
     state_ = SocketState::ShutdownSent;
   }
 }
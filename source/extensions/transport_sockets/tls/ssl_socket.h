@@ -115,6 +115,8 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  void maybeEnableKernelTlsTx();
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   bool isThreadSafe() const {
@@ -127,6 +129,8 @@ private:
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
   SocketState state_;
+  // Set once the kernel encrypts records for writes; BoringSSL then only reads.
+  bool kernel_tls_tx_{};
 
   SSL* ssl_;
   Ssl::ConnectionInfoConstSharedPtr info_;
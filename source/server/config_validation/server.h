@@ -137,13 +137,20 @@ public:
     // validation mock.
     return nullptr;
   }
+  Network::SocketSharedPtr createWorkerListenSocket(Network::Address::InstanceConstSharedPtr,
+                                                    const Network::Socket::OptionsSharedPtr&,
+                                                    uint32_t) override {
+    // Returned sockets are not currently used so we can return nothing here safely vs. a
+    // validation mock.
+    return nullptr;
+  }
   DrainManagerPtr createDrainManager(envoy::api::v2::Listener::DrainType) override {
     return nullptr;
   }
   uint64_t nextListenerTag() override { return 0; }
 
   // Server::WorkerFactory
-  WorkerPtr createWorker(OverloadManager&, const std::string&) override {
+  WorkerPtr createWorker(uint32_t, OverloadManager&, const std::string&) override {
     // Returned workers are not currently used so we can return nothing here safely vs. a
     // validation mock.
     return nullptr;
@@ -77,6 +77,7 @@ void MainImpl::initialize(const envoy::config::bootstrap::v2::Bootstrap& bootstr
 
   stats_flush_interval_ =
       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(bootstrap, stats_flush_interval, 5000));
+  stats_flush_changed_only_ = bootstrap.stats_flush_changed_only();
 
   const auto& watchdog = bootstrap.watchdog();
   watchdog_miss_timeout_ =
@@ -15,9 +15,10 @@ namespace Envoy {
 namespace Server {
 
 ConnectionHandlerImpl::ConnectionHandlerImpl(Event::Dispatcher& dispatcher,
-                                             const std::string& per_handler_stat_prefix)
+                                             const std::string& per_handler_stat_prefix,
+                                             uint32_t worker_index)
     : dispatcher_(dispatcher), per_handler_stat_prefix_(per_handler_stat_prefix + "."),
-      disable_listeners_(false) {}
+      worker_index_(worker_index), disable_listeners_(false) {}
 
 void ConnectionHandlerImpl::incNumConnections() { ++num_connections_; }
 
@@ -87,6 +88,7 @@ void ConnectionHandlerImpl::ActiveTcpListener::removeConnection(ActiveConnection
   parent_.dispatcher_.deferredDelete(std::move(removed));
   ASSERT(parent_.num_connections_ > 0);
   parent_.num_connections_--;
+  decNumConnections();
 }
 
 ConnectionHandlerImpl::ActiveListenerImplBase::ActiveListenerImplBase(
@@ -107,7 +109,8 @@ ConnectionHandlerImpl::ActiveTcpListener::ActiveTcpListener(ConnectionHandlerImp
                                                             Network::ListenerConfig& config)
     : ActiveTcpListener(
           parent,
-          parent.dispatcher_.createListener(config.socket(), *this, config.bindToPort(),
+          parent.dispatcher_.createListener(config.listenSocket(parent.worker_index_), *this,
+                                            config.bindToPort(),
                                             config.handOffRestoredDestinationConnections()),
           config) {}
 
@@ -115,9 +118,15 @@ ConnectionHandlerImpl::ActiveTcpListener::ActiveTcpListener(ConnectionHandlerImp
                                                             Network::ListenerPtr&& listener,
                                                             Network::ListenerConfig& config)
     : ConnectionHandlerImpl::ActiveListenerImplBase(parent, std::move(listener), config),
-      parent_(parent) {}
+      parent_(parent) {
+  config.connectionBalancer().registerHandler(*this);
+}
 
 ConnectionHandlerImpl::ActiveTcpListener::~ActiveTcpListener() {
+  if (listener_ != nullptr) {
+    config_.connectionBalancer().unregisterHandler(*this);
+  }
+
   // Purge sockets that have not progressed to connections. This should only happen when
   // a listener filter stops iteration and never resumes.
   while (!sockets_.empty()) {
@@ -132,12 +141,34 @@ ConnectionHandlerImpl::ActiveTcpListener::~ActiveTcpListener() {
   parent_.dispatcher_.clearDeferredDeleteList();
 }
 
+void ConnectionHandlerImpl::ActiveTcpListener::destroy() {
+  // A stopped listener no longer accepts, so it must not be handed connections from other workers
+  // either.
+  if (listener_ != nullptr) {
+    config_.connectionBalancer().unregisterHandler(*this);
+  }
+  ActiveListenerImplBase::destroy();
+}
+
 Network::Listener*
 ConnectionHandlerImpl::findListenerByAddress(const Network::Address::Instance& address) {
   Network::ConnectionHandler::ActiveListener* listener = findActiveListenerByAddress(address);
   return listener ? listener->listener() : nullptr;
 }
 
+ConnectionHandlerImpl::ActiveTcpListener*
+ConnectionHandlerImpl::findActiveTcpListenerByTag(uint64_t listener_tag) {
+  // This is a linear operation, the number of listeners is generally small.
+  for (auto& listener : listeners_) {
+    if (listener.second->listenerTag() == listener_tag && listener.second->listener() != nullptr) {
+      // Only tcp listeners take part in connection balancing, so the tag must belong to one.
+      ASSERT(dynamic_cast<ActiveTcpListener*>(listener.second.get()) != nullptr);
+      return static_cast<ActiveTcpListener*>(listener.second.get());
+    }
+  }
+  return nullptr;
+}
+
 Network::ConnectionHandler::ActiveListener*
 ConnectionHandlerImpl::findActiveListenerByAddress(const Network::Address::Instance& address) {
   // This is a linear operation, may need to add a map<address, listener> to improve performance.
@@ -248,11 +279,16 @@ void ConnectionHandlerImpl::ActiveSocket::newConnection() {
     // TODO(sumukhs): Try to avoid dynamic_cast by coming up with a better interface design
     ActiveTcpListener* tcp_listener = dynamic_cast<ActiveTcpListener*>(new_listener);
     ASSERT(tcp_listener != nullptr, "ActiveSocket listener is expected to be tcp");
+    // The connection now belongs to the new listener, move its accounting along with it.
+    listener_.decNumConnections();
+    tcp_listener->incNumConnections();
     // Hands off connections redirected by iptables to the listener associated with the
     // original destination address. Pass 'hand_off_restored_destination_connections' as false to
-    // prevent further redirection.
-    tcp_listener->onAccept(std::move(socket_),
-                           false /* hand_off_restored_destination_connections */);
+    // prevent further redirection, and 'rebalanced' as true since the connection has already been
+    // balanced onto this worker.
+    tcp_listener->onAcceptWorker(std::move(socket_),
+                                 false /* hand_off_restored_destination_connections */,
+                                 true /* rebalanced */);
   } else {
     // Set default transport protocol if none of the listener filters did it.
     if (socket_->detectedTransportProtocol().empty()) {
@@ -266,6 +302,17 @@ void ConnectionHandlerImpl::ActiveSocket::newConnection() {
 
 void ConnectionHandlerImpl::ActiveTcpListener::onAccept(
     Network::ConnectionSocketPtr&& socket, bool hand_off_restored_destination_connections) {
+  onAcceptWorker(std::move(socket), hand_off_restored_destination_connections, false);
+}
+
+void ConnectionHandlerImpl::ActiveTcpListener::onAcceptWorker(
+    Network::ConnectionSocketPtr&& socket, bool hand_off_restored_destination_connections,
+    bool rebalanced) {
+  if (!rebalanced && config_.connectionBalancer().balanceConnection(*this, socket)) {
+    // The socket has been posted to the worker the balancer picked.
+    return;
+  }
+
   auto active_socket = std::make_unique<ActiveSocket>(*this, std::move(socket),
                                                       hand_off_restored_destination_connections);
 
@@ -283,6 +330,10 @@ void ConnectionHandlerImpl::ActiveTcpListener::onAccept(
 
 void ConnectionHandlerImpl::ActiveTcpListener::newConnection(
     Network::ConnectionSocketPtr&& socket) {
+  // The socket was counted when the connection balancer picked this listener. From here on the
+  // count is carried by the active connection, if one gets created.
+  decNumConnections();
+
   // Find matching filter chain.
   const auto filter_chain = config_.filterChainManager().findFilterChain(*socket);
   if (filter_chain == nullptr) {
@@ -308,6 +359,22 @@ void ConnectionHandlerImpl::ActiveTcpListener::newConnection(
   onNewConnection(std::move(new_connection));
 }
 
+void ConnectionHandlerImpl::ActiveTcpListener::post(Network::ConnectionSocketPtr&& socket) {
+  // It is not possible to capture a unique_ptr because the post() API copies the lambda, so we must
+  // bundle the socket inside a shared_ptr that can be captured.
+  auto socket_to_rebalance = std::make_shared<Network::ConnectionSocketPtr>(std::move(socket));
+
+  parent_.dispatcher_.post([socket_to_rebalance, tag = config_.listenerTag(), &parent = parent_]() {
+    // The listener may have been removed or stopped on this worker since the balancer picked it.
+    // In that case the socket is closed when the last reference to it goes away.
+    ActiveTcpListener* listener = parent.findActiveTcpListenerByTag(tag);
+    if (listener != nullptr) {
+      listener->onAcceptWorker(std::move(*socket_to_rebalance),
+                               listener->config_.handOffRestoredDestinationConnections(), true);
+    }
+  });
+}
+
 void ConnectionHandlerImpl::ActiveTcpListener::onNewConnection(
     Network::ConnectionPtr&& new_connection) {
   ENVOY_CONN_LOG(debug, "new connection", *new_connection);
@@ -318,6 +385,7 @@ void ConnectionHandlerImpl::ActiveTcpListener::onNewConnection(
         new ActiveConnection(*this, std::move(new_connection), parent_.dispatcher_.timeSource()));
     active_connection->moveIntoList(std::move(active_connection), connections_);
     parent_.num_connections_++;
+    incNumConnections();
   }
 }
 
@@ -8,6 +8,7 @@
 #include "envoy/common/time.h"
 #include "envoy/event/deferred_deletable.h"
 #include "envoy/network/connection.h"
+#include "envoy/network/connection_balancer.h"
 #include "envoy/network/connection_handler.h"
 #include "envoy/network/filter.h"
 #include "envoy/network/listen_socket.h"
@@ -17,6 +18,7 @@
 #include "envoy/stats/scope.h"
 #include "envoy/stats/timespan.h"
 
+#include "common/common/assert.h"
 #include "common/common/linked_object.h"
 #include "common/common/non_copyable.h"
 
@@ -60,7 +62,14 @@ class ConnectionHandlerImpl : public Network::ConnectionHandler,
                               NonCopyable,
                               Logger::Loggable<Logger::Id::conn_handler> {
 public:
-  ConnectionHandlerImpl(Event::Dispatcher& dispatcher, const std::string& per_handler_stat_prefix);
+  /**
+   * @param dispatcher supplies the dispatcher the handler runs on.
+   * @param per_handler_stat_prefix supplies the prefix of the per-handler listener stats.
+   * @param worker_index supplies the index of the worker owning the handler. This selects the
+   *        listen socket to accept on for listeners configured with reuse_port.
+   */
+  ConnectionHandlerImpl(Event::Dispatcher& dispatcher, const std::string& per_handler_stat_prefix,
+                        uint32_t worker_index);
 
   // Network::ConnectionHandler
   uint64_t numConnections() override { return num_connections_; }
@@ -110,18 +119,48 @@ private:
   /**
    * Wrapper for an active tcp listener owned by this handler.
    */
-  class ActiveTcpListener : public Network::ListenerCallbacks, public ActiveListenerImplBase {
+  class ActiveTcpListener : public Network::ListenerCallbacks,
+                            public ActiveListenerImplBase,
+                            public Network::BalancedConnectionHandler {
   public:
     ActiveTcpListener(ConnectionHandlerImpl& parent, Network::ListenerConfig& config);
     ActiveTcpListener(ConnectionHandlerImpl& parent, Network::ListenerPtr&& listener,
                       Network::ListenerConfig& config);
     ~ActiveTcpListener() override;
 
+    // Network::ConnectionHandler::ActiveListener
+    void destroy() override;
+
     // Network::ListenerCallbacks
     void onAccept(Network::ConnectionSocketPtr&& socket,
                   bool hand_off_restored_destination_connections) override;
     void onNewConnection(Network::ConnectionPtr&& new_connection) override;
 
+    // Network::BalancedConnectionHandler
+    uint64_t numConnections() const override { return num_listener_connections_; }
+    void incNumConnections() override { ++num_listener_connections_; }
+    void post(Network::ConnectionSocketPtr&& socket) override;
+
+    /**
+     * Decrement the number of connections within the listener. Called when a connection counted by
+     * incNumConnections() is closed or leaves the listener.
+     */
+    void decNumConnections() {
+      ASSERT(num_listener_connections_ > 0);
+      --num_listener_connections_;
+    }
+
+    /**
+     * Run the listener filters on a socket accepted by this handler's worker.
+     * @param socket supplies the accepted socket.
+     * @param hand_off_restored_destination_connections see ListenerCallbacks::onAccept().
+     * @param rebalanced is true when the socket has already been through the connection balancer,
+     *        either because another worker posted it here or because it was redirected from
+     *        another listener. Such sockets are never rebalanced again.
+     */
+    void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
+                        bool hand_off_restored_destination_connections, bool rebalanced);
+
     /**
      * Remove and destroy an active connection.
      * @param connection supplies the connection to remove.
@@ -136,8 +175,17 @@ private:
     ConnectionHandlerImpl& parent_;
     std::list<ActiveSocketPtr> sockets_;
     std::list<ActiveConnectionPtr> connections_;
+    // The number of connections currently owned by this listener, including sockets that are still
+    // running listener filters and sockets that have been posted here by the connection balancer.
+    // This is read by the balancer from other workers.
+    std::atomic<uint64_t> num_listener_connections_{};
   };
 
+  /**
+   * @return the active, not stopped, tcp listener with the given tag or nullptr if there is none.
+   */
+  ActiveTcpListener* findActiveTcpListenerByTag(uint64_t listener_tag);
+
   /**
    * Wrapper for an active connection owned by this handler.
    */
@@ -181,6 +229,11 @@ private:
     ~ActiveSocket() override {
       accept_filters_.clear();
       listener_.stats_.downstream_pre_cx_active_.dec();
+      // If the socket is still attached, it never made it to an active connection, which would
+      // otherwise account for it on removal.
+      if (socket_ != nullptr) {
+        listener_.decNumConnections();
+      }
     }
 
     void onTimeout();
@@ -208,6 +261,7 @@ private:
 
   Event::Dispatcher& dispatcher_;
   const std::string per_handler_stat_prefix_;
+  const uint32_t worker_index_;
   std::list<std::pair<Network::Address::InstanceConstSharedPtr,
                       Network::ConnectionHandler::ActiveListenerPtr>>
       listeners_;
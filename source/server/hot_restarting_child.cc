@@ -16,13 +16,15 @@ HotRestartingChild::HotRestartingChild(int base_id, int restart_epoch)
   bindDomainSocket(restart_epoch_, "child");
 }
 
-int HotRestartingChild::duplicateParentListenSocket(const std::string& address) {
+int HotRestartingChild::duplicateParentListenSocket(const std::string& address,
+                                                    uint32_t worker_index) {
   if (restart_epoch_ == 0 || parent_terminated_) {
     return -1;
   }
 
   HotRestartMessage wrapped_request;
   wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_address(address);
+  wrapped_request.mutable_request()->mutable_pass_listen_socket()->set_worker_index(worker_index);
   sendHotRestartMessage(parent_address_, wrapped_request);
 
   std::unique_ptr<HotRestartMessage> wrapped_reply = receiveHotRestartMessage(Blocking::Yes);
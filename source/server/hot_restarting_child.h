@@ -14,7 +14,7 @@ class HotRestartingChild : HotRestartingBase, Logger::Loggable<Logger::Id::main>
 public:
   HotRestartingChild(int base_id, int restart_epoch);
 
-  int duplicateParentListenSocket(const std::string& address);
+  int duplicateParentListenSocket(const std::string& address, uint32_t worker_index);
   std::unique_ptr<envoy::HotRestartMessage> getParentStats();
   void drainParentListeners();
   void sendParentAdminShutdownRequest(time_t& original_start_time);
@@ -94,10 +94,15 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
   wrapped_reply.mutable_reply()->mutable_pass_listen_socket()->set_fd(-1);
   Network::Address::InstanceConstSharedPtr addr =
       Network::Utility::resolveUrl(request.pass_listen_socket().address());
+  const uint32_t worker_index = request.pass_listen_socket().worker_index();
+  if (worker_index >= server_->options().concurrency()) {
+    // The child runs with more workers than we do, so there is no socket to hand over.
+    return wrapped_reply;
+  }
   for (const auto& listener : server_->listenerManager().listeners()) {
     if (*listener.get().socket().localAddress() == *addr) {
       wrapped_reply.mutable_reply()->mutable_pass_listen_socket()->set_fd(
-          listener.get().socket().ioHandle().fd());
+          listener.get().listenSocket(worker_index).ioHandle().fd());
       break;
     }
   }
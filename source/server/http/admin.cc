@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <regex>
 #include <string>
 #include <unordered_map>
@@ -206,6 +207,85 @@ void setHealthFlag(Upstream::Host::HealthFlag flag, const Upstream::Host& host,
     break;
   }
 }
+
+// The number of metrics examined for each chunk of a streamed /stats/prometheus response.
+constexpr uint64_t PrometheusMetricsPerChunk = 1000;
+
+/**
+ * Sends the rest of an admin response a chunk at a time, with each chunk produced in its own
+ * dispatcher callback, so that a large response neither blocks the main thread for long nor has
+ * to be held in memory at once. Chunks are not produced while the downstream connection is above
+ * its write buffer high watermark. The streamer is kept alive by the destroy callback of the
+ * stream and by its scheduled dispatcher callback.
+ */
+class ChunkedResponseStreamer : public Http::DownstreamWatermarkCallbacks,
+                                public std::enable_shared_from_this<ChunkedResponseStreamer> {
+public:
+  // Appends the next chunk to the buffer, and returns whether it was the last one.
+  using NextChunkCb = std::function<bool(Buffer::Instance&)>;
+
+  ChunkedResponseStreamer(Http::StreamDecoderFilterCallbacks& callbacks, NextChunkCb next_chunk)
+      : callbacks_(&callbacks), next_chunk_(std::move(next_chunk)) {}
+
+  /**
+   * Streams the rest of the response once the handler has returned.
+   * @param admin_stream supplies the stream of the request.
+   * @param next_chunk supplies the callback producing the chunks.
+   */
+  static void start(AdminStream& admin_stream, NextChunkCb next_chunk) {
+    auto streamer = std::make_shared<ChunkedResponseStreamer>(
+        admin_stream.getDecoderFilterCallbacks(), std::move(next_chunk));
+    admin_stream.setEndStreamOnComplete(false);
+    admin_stream.addOnDestroyCallback([streamer]() { streamer->callbacks_ = nullptr; });
+    streamer->callbacks_->addDownstreamWatermarkCallbacks(*streamer);
+    streamer->schedule();
+  }
+
+  // Http::DownstreamWatermarkCallbacks
+  void onAboveWriteBufferHighWatermark() override { ++high_watermark_count_; }
+  void onBelowWriteBufferLowWatermark() override {
+    ASSERT(high_watermark_count_ > 0);
+    --high_watermark_count_;
+    schedule();
+  }
+
+private:
+  void schedule() {
+    if (callbacks_ == nullptr || scheduled_ || high_watermark_count_ > 0) {
+      return;
+    }
+    scheduled_ = true;
+    std::shared_ptr<ChunkedResponseStreamer> self = shared_from_this();
+    callbacks_->dispatcher().post([self]() {
+      self->scheduled_ = false;
+      self->sendChunk();
+    });
+  }
+
+  void sendChunk() {
+    // The stream may have been reset since the chunk was scheduled.
+    if (callbacks_ == nullptr) {
+      return;
+    }
+    Buffer::OwnedImpl chunk;
+    if (next_chunk_(chunk)) {
+      callbacks_->removeDownstreamWatermarkCallbacks(*this);
+      callbacks_->encodeData(chunk, true);
+      return;
+    }
+    if (chunk.length() > 0) {
+      callbacks_->encodeData(chunk, false);
+    }
+    schedule();
+  }
+
+  // Cleared when the stream is destroyed.
+  Http::StreamDecoderFilterCallbacks* callbacks_;
+  const NextChunkCb next_chunk_;
+  uint32_t high_watermark_count_{};
+  bool scheduled_{};
+};
+
 } // namespace
 
 AdminFilter::AdminFilter(AdminImpl& parent) : parent_(parent) {}
@@ -751,6 +831,11 @@ Http::Code AdminImpl::handlerStats(absl::string_view url, Http::HeaderMap& respo
                                    Buffer::Instance& response, AdminStream& admin_stream) {
   Http::Code rc = Http::Code::OK;
   const Http::Utility::QueryParams params = Http::Utility::parseQueryString(url);
+  const absl::optional<std::string> format_value = formatParam(params);
+  if (format_value.has_value() && format_value.value() == "prometheus") {
+    // The Prometheus output is not sorted, so it is written without building the map below.
+    return handlerPrometheusStats(url, response_headers, response, admin_stream);
+  }
 
   const bool used_only = params.find("usedonly") != params.end();
   const absl::optional<std::regex> regex = filterParam(params);
@@ -769,14 +854,12 @@ Http::Code AdminImpl::handlerStats(absl::string_view url, Http::HeaderMap& respo
     }
   }
 
-  if (const auto format_value = formatParam(params)) {
+  if (format_value.has_value()) {
     if (format_value.value() == "json") {
       response_headers.insertContentType().value().setReference(
           Http::Headers::get().ContentTypeValues.Json);
       response.add(
           AdminImpl::statsAsJson(all_stats, server_.stats().histograms(), used_only, regex));
-    } else if (format_value.value() == "prometheus") {
-      return handlerPrometheusStats(url, response_headers, response, admin_stream);
     } else {
       response.add("usage: /stats?format=json  or /stats?format=prometheus \n");
       response.add("\n");
@@ -803,13 +886,24 @@ Http::Code AdminImpl::handlerStats(absl::string_view url, Http::HeaderMap& respo
 }
 
 Http::Code AdminImpl::handlerPrometheusStats(absl::string_view path_and_query, Http::HeaderMap&,
-                                             Buffer::Instance& response, AdminStream&) {
+                                             Buffer::Instance& response,
+                                             AdminStream& admin_stream) {
   const Http::Utility::QueryParams params = Http::Utility::parseQueryString(path_and_query);
-  const bool used_only = params.find("usedonly") != params.end();
-  const absl::optional<std::regex> regex = filterParam(params);
-  PrometheusStatsFormatter::statsAsPrometheus(server_.stats().counters(), server_.stats().gauges(),
-                                              server_.stats().histograms(), response, used_only,
-                                              regex);
+  auto writer = std::make_shared<PrometheusStatsFormatter::ChunkedWriter>(
+      server_.stats().counters(), server_.stats().gauges(), server_.stats().histograms(),
+      params.find("usedonly") != params.end(), filterParam(params));
+  // The first chunk is the handler's response, and the rest, if any, are streamed after it. Without
+  // a downstream stream to stream them on, all of the chunks go in the handler's response.
+  bool complete = writer->writeChunk(response, PrometheusMetricsPerChunk);
+  if (!admin_stream.canStreamResponse()) {
+    while (!complete) {
+      complete = writer->writeChunk(response, PrometheusMetricsPerChunk);
+    }
+  } else if (!complete) {
+    ChunkedResponseStreamer::start(admin_stream, [writer](Buffer::Instance& chunk) {
+      return writer->writeChunk(chunk, PrometheusMetricsPerChunk);
+    });
+  }
   return Http::Code::OK;
 }
 
@@ -847,69 +941,115 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     const bool used_only, const absl::optional<std::regex>& regex) {
   std::unordered_set<std::string> metric_type_tracker;
   for (const auto& counter : counters) {
-    if (!shouldShowMetric(*counter, used_only, regex)) {
-      continue;
-    }
-
-    const std::string tags = formattedTags(counter->tags());
-    const std::string metric_name = metricName(counter->tagExtractedName());
-    if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
-      metric_type_tracker.insert(metric_name);
-      response.add(fmt::format("# TYPE {0} counter\n", metric_name));
+    if (shouldShowMetric(*counter, used_only, regex)) {
+      writeMetric(*counter, metric_type_tracker, response);
     }
-    response.add(fmt::format("{0}{{{1}}} {2}\n", metric_name, tags, counter->value()));
   }
 
   for (const auto& gauge : gauges) {
-    if (!shouldShowMetric(*gauge, used_only, regex)) {
-      continue;
-    }
-
-    const std::string tags = formattedTags(gauge->tags());
-    const std::string metric_name = metricName(gauge->tagExtractedName());
-    if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
-      metric_type_tracker.insert(metric_name);
-      response.add(fmt::format("# TYPE {0} gauge\n", metric_name));
+    if (shouldShowMetric(*gauge, used_only, regex)) {
+      writeMetric(*gauge, metric_type_tracker, response);
     }
-    response.add(fmt::format("{0}{{{1}}} {2}\n", metric_name, tags, gauge->value()));
   }
 
   for (const auto& histogram : histograms) {
-    if (!shouldShowMetric(*histogram, used_only, regex)) {
-      continue;
+    if (shouldShowMetric(*histogram, used_only, regex)) {
+      writeMetric(*histogram, metric_type_tracker, response);
     }
+  }
 
-    const std::string tags = formattedTags(histogram->tags());
-    const std::string hist_tags = histogram->tags().empty() ? EMPTY_STRING : (tags + ",");
+  return metric_type_tracker.size();
+}
 
-    const std::string metric_name = metricName(histogram->tagExtractedName());
-    if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
-      metric_type_tracker.insert(metric_name);
-      response.add(fmt::format("# TYPE {0} histogram\n", metric_name));
-    }
+void PrometheusStatsFormatter::writeMetric(const Stats::Counter& counter,
+                                           std::unordered_set<std::string>& metric_type_tracker,
+                                           Buffer::Instance& response) {
+  const std::string tags = formattedTags(counter.tags());
+  const std::string metric_name = metricName(counter.tagExtractedName());
+  if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
+    metric_type_tracker.insert(metric_name);
+    response.add(fmt::format("# TYPE {0} counter\n", metric_name));
+  }
+  response.add(fmt::format("{0}{{{1}}} {2}\n", metric_name, tags, counter.value()));
+}
 
-    const Stats::HistogramStatistics& stats = histogram->cumulativeStatistics();
-    const std::vector<double>& supported_buckets = stats.supportedBuckets();
-    const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
-    for (size_t i = 0; i < supported_buckets.size(); ++i) {
-      double bucket = supported_buckets[i];
-      uint64_t value = computed_buckets[i];
-      // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
-      // doesn't have a specific modifier to format as a fixed-point value only so we use the
-      // 'g' operator which prints the number in general fixed point format or scientific format
-      // with precision 50 to round the number up to 32 significant digits in fixed point format
-      // which should cover pretty much all cases
-      response.add(fmt::format("{0}_bucket{{{1}le=\"{2:.32g}\"}} {3}\n", metric_name, hist_tags,
-                               bucket, value));
-    }
+void PrometheusStatsFormatter::writeMetric(const Stats::Gauge& gauge,
+                                           std::unordered_set<std::string>& metric_type_tracker,
+                                           Buffer::Instance& response) {
+  const std::string tags = formattedTags(gauge.tags());
+  const std::string metric_name = metricName(gauge.tagExtractedName());
+  if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
+    metric_type_tracker.insert(metric_name);
+    response.add(fmt::format("# TYPE {0} gauge\n", metric_name));
+  }
+  response.add(fmt::format("{0}{{{1}}} {2}\n", metric_name, tags, gauge.value()));
+}
 
-    response.add(fmt::format("{0}_bucket{{{1}le=\"+Inf\"}} {2}\n", metric_name, hist_tags,
-                             stats.sampleCount()));
-    response.add(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", metric_name, tags, stats.sampleSum()));
-    response.add(fmt::format("{0}_count{{{1}}} {2}\n", metric_name, tags, stats.sampleCount()));
+void PrometheusStatsFormatter::writeMetric(const Stats::ParentHistogram& histogram,
+                                           std::unordered_set<std::string>& metric_type_tracker,
+                                           Buffer::Instance& response) {
+  const std::string tags = formattedTags(histogram.tags());
+  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+
+  const std::string metric_name = metricName(histogram.tagExtractedName());
+  if (metric_type_tracker.find(metric_name) == metric_type_tracker.end()) {
+    metric_type_tracker.insert(metric_name);
+    response.add(fmt::format("# TYPE {0} histogram\n", metric_name));
   }
 
-  return metric_type_tracker.size();
+  const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
+  const std::vector<double>& supported_buckets = stats.supportedBuckets();
+  const std::vector<uint64_t>& computed_buckets = stats.computedBuckets();
+  for (size_t i = 0; i < supported_buckets.size(); ++i) {
+    double bucket = supported_buckets[i];
+    uint64_t value = computed_buckets[i];
+    // We want to print the bucket in a fixed point (non-scientific) format. The fmt library
+    // doesn't have a specific modifier to format as a fixed-point value only so we use the
+    // 'g' operator which prints the number in general fixed point format or scientific format
+    // with precision 50 to round the number up to 32 significant digits in fixed point format
+    // which should cover pretty much all cases
+    response.add(fmt::format("{0}_bucket{{{1}le=\"{2:.32g}\"}} {3}\n", metric_name, hist_tags,
+                             bucket, value));
+  }
+
+  response.add(fmt::format("{0}_bucket{{{1}le=\"+Inf\"}} {2}\n", metric_name, hist_tags,
+                           stats.sampleCount()));
+  response.add(fmt::format("{0}_sum{{{1}}} {2:.32g}\n", metric_name, tags, stats.sampleSum()));
+  response.add(fmt::format("{0}_count{{{1}}} {2}\n", metric_name, tags, stats.sampleCount()));
+}
+
+PrometheusStatsFormatter::ChunkedWriter::ChunkedWriter(
+    std::vector<Stats::CounterSharedPtr>&& counters, std::vector<Stats::GaugeSharedPtr>&& gauges,
+    std::vector<Stats::ParentHistogramSharedPtr>&& histograms, bool used_only,
+    absl::optional<std::regex>&& regex)
+    : counters_(std::move(counters)), gauges_(std::move(gauges)),
+      histograms_(std::move(histograms)), used_only_(used_only), regex_(std::move(regex)) {}
+
+bool PrometheusStatsFormatter::ChunkedWriter::writeChunk(Buffer::Instance& response,
+                                                         uint64_t max_metrics) {
+  // Metrics are written in the same order as by statsAsPrometheus(), so that the TYPE line of a
+  // metric name shared by several metric types has the type of its first metric.
+  for (; next_counter_ < counters_.size() && max_metrics > 0; ++next_counter_, --max_metrics) {
+    const Stats::Counter& counter = *counters_[next_counter_];
+    if (shouldShowMetric(counter, used_only_, regex_)) {
+      writeMetric(counter, metric_type_tracker_, response);
+    }
+  }
+  for (; next_gauge_ < gauges_.size() && max_metrics > 0; ++next_gauge_, --max_metrics) {
+    const Stats::Gauge& gauge = *gauges_[next_gauge_];
+    if (shouldShowMetric(gauge, used_only_, regex_)) {
+      writeMetric(gauge, metric_type_tracker_, response);
+    }
+  }
+  for (; next_histogram_ < histograms_.size() && max_metrics > 0;
+       ++next_histogram_, --max_metrics) {
+    const Stats::ParentHistogram& histogram = *histograms_[next_histogram_];
+    if (shouldShowMetric(histogram, used_only_, regex_)) {
+      writeMetric(histogram, metric_type_tracker_, response);
+    }
+  }
+  return next_histogram_ == histograms_.size() && next_gauge_ == gauges_.size() &&
+         next_counter_ == counters_.size();
 }
 
 std::string
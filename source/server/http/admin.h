@@ -2,8 +2,10 @@
 
 #include <chrono>
 #include <list>
+#include <regex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -27,6 +29,7 @@
 #include "common/http/date_provider_impl.h"
 #include "common/http/default_server_string.h"
 #include "common/http/utility.h"
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/raw_buffer_socket.h"
 #include "common/router/scoped_config_impl.h"
 #include "common/stats/isolated_store_impl.h"
@@ -313,6 +316,7 @@ private:
     Network::FilterChainFactory& filterChainFactory() override { return parent_; }
     Network::Socket& socket() override { return parent_.mutable_socket(); }
     const Network::Socket& socket() const override { return parent_.mutable_socket(); }
+    Network::Socket& listenSocket(uint32_t) override { return parent_.mutable_socket(); }
     bool bindToPort() override { return true; }
     bool handOffRestoredDestinationConnections() const override { return false; }
     uint32_t perConnectionBufferLimitBytes() const override { return 0; }
@@ -326,11 +330,13 @@ private:
     const Network::ActiveUdpListenerFactory* udpListenerFactory() override {
       NOT_REACHED_GCOVR_EXCL_LINE;
     }
+    Network::ConnectionBalancer& connectionBalancer() override { return connection_balancer_; }
 
     AdminImpl& parent_;
     const std::string name_;
     Stats::ScopePtr scope_;
     Http::ConnectionManagerListenerStats stats_;
+    Network::NopConnectionBalancerImpl connection_balancer_;
   };
   using AdminListenerPtr = std::unique_ptr<AdminListener>;
 
@@ -402,6 +408,7 @@ public:
   void setEndStreamOnComplete(bool end_stream) override { end_stream_on_complete_ = end_stream; }
   void addOnDestroyCallback(std::function<void()> cb) override;
   Http::StreamDecoderFilterCallbacks& getDecoderFilterCallbacks() const override;
+  bool canStreamResponse() const override { return callbacks_ != nullptr; }
   const Buffer::Instance* getRequestBody() const override;
   const Http::HeaderMap& getRequestHeaders() const override;
 
@@ -448,7 +455,54 @@ public:
    */
   static std::string metricName(const std::string& extractedName);
 
+  /**
+   * Writes metrics in the Prometheus format a chunk at a time, so that a large number of metrics
+   * can be streamed to the client rather than formatted into a single response buffer at once.
+   */
+  class ChunkedWriter {
+  public:
+    ChunkedWriter(std::vector<Stats::CounterSharedPtr>&& counters,
+                  std::vector<Stats::GaugeSharedPtr>&& gauges,
+                  std::vector<Stats::ParentHistogramSharedPtr>&& histograms, bool used_only,
+                  absl::optional<std::regex>&& regex);
+
+    /**
+     * Appends the next metrics to the response.
+     * @param response supplies the buffer to append to.
+     * @param max_metrics supplies the maximum number of metrics to examine, including the ones
+     *        that are filtered out, which bounds the work done by a single call.
+     * @return bool whether all metrics have been written.
+     */
+    bool writeChunk(Buffer::Instance& response, uint64_t max_metrics);
+
+    /**
+     * @return uint64_t total number of metric types written so far.
+     */
+    uint64_t numMetricTypes() const { return metric_type_tracker_.size(); }
+
+  private:
+    const std::vector<Stats::CounterSharedPtr> counters_;
+    const std::vector<Stats::GaugeSharedPtr> gauges_;
+    const std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+    const bool used_only_;
+    const absl::optional<std::regex> regex_;
+    std::unordered_set<std::string> metric_type_tracker_;
+    size_t next_counter_{};
+    size_t next_gauge_{};
+    size_t next_histogram_{};
+  };
+
 private:
+  static void writeMetric(const Stats::Counter& counter,
+                          std::unordered_set<std::string>& metric_type_tracker,
+                          Buffer::Instance& response);
+  static void writeMetric(const Stats::Gauge& gauge,
+                          std::unordered_set<std::string>& metric_type_tracker,
+                          Buffer::Instance& response);
+  static void writeMetric(const Stats::ParentHistogram& histogram,
+                          std::unordered_set<std::string>& metric_type_tracker,
+                          Buffer::Instance& response);
+
   /**
    * Take a string and sanitize it according to Prometheus conventions.
    */
@@ -13,6 +13,7 @@
 #include "common/common/empty_string.h"
 #include "common/common/fmt.h"
 #include "common/config/utility.h"
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/io_socket_handle_impl.h"
 #include "common/network/listen_socket_impl.h"
 #include "common/network/resolver_impl.h"
@@ -153,7 +154,7 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
           fmt::format("socket type {} not supported for pipes", toString(socket_type)));
     }
     const std::string addr = fmt::format("unix://{}", address->asString());
-    const int fd = server_.hotRestart().duplicateParentListenSocket(addr);
+    const int fd = server_.hotRestart().duplicateParentListenSocket(addr, 0);
     Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
     if (io_handle->isOpen()) {
       ENVOY_LOG(debug, "obtained socket for address {} from parent", addr);
@@ -166,7 +167,7 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
                                  ? Network::Utility::TCP_SCHEME
                                  : Network::Utility::UDP_SCHEME;
   const std::string addr = absl::StrCat(scheme, address->asString());
-  const int fd = server_.hotRestart().duplicateParentListenSocket(addr);
+  const int fd = server_.hotRestart().duplicateParentListenSocket(addr, 0);
   if (fd != -1) {
     ENVOY_LOG(debug, "obtained socket for address {} from parent", addr);
     Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
@@ -183,6 +184,22 @@ Network::SocketSharedPtr ProdListenerComponentFactory::createListenSocket(
   }
 }
 
+Network::SocketSharedPtr ProdListenerComponentFactory::createWorkerListenSocket(
+    Network::Address::InstanceConstSharedPtr address,
+    const Network::Socket::OptionsSharedPtr& options, uint32_t worker_index) {
+  ASSERT(address->type() == Network::Address::Type::Ip);
+  ASSERT(worker_index > 0);
+
+  const std::string addr = absl::StrCat(Network::Utility::TCP_SCHEME, address->asString());
+  const int fd = server_.hotRestart().duplicateParentListenSocket(addr, worker_index);
+  if (fd != -1) {
+    ENVOY_LOG(debug, "obtained socket for address {} worker {} from parent", addr, worker_index);
+    Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>(fd);
+    return std::make_shared<Network::TcpListenSocket>(std::move(io_handle), address, options);
+  }
+  return std::make_shared<Network::TcpListenSocket>(address, options, true);
+}
+
 DrainManagerPtr
 ProdListenerComponentFactory::createDrainManager(envoy::api::v2::Listener::DrainType drain_type) {
   return DrainManagerPtr{new DrainManagerImpl(server_, drain_type)};
@@ -199,6 +216,7 @@ ListenerImpl::ListenerImpl(const envoy::api::v2::Listener& config, const std::st
       listener_scope_(
           parent_.server_.stats().createScope(fmt::format("listener.{}.", address_->asString()))),
       bind_to_port_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.deprecated_v1(), bind_to_port, true)),
+      reuse_port_(config.reuse_port()),
       hand_off_restored_destination_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_original_dst, false)),
       per_connection_buffer_limit_bytes_(
@@ -223,6 +241,27 @@ ListenerImpl::ListenerImpl(const envoy::api::v2::Listener& config, const std::st
     addListenSocketOptions(
         Network::SocketOptionFactory::buildLiteralOptions(config.socket_options()));
   }
+  if (reuse_port_) {
+    if (socket_type_ != Network::Address::SocketType::Stream ||
+        address_->type() != Network::Address::Type::Ip) {
+      throw EnvoyException(
+          fmt::format("error adding listener '{}': reuse_port is only supported for TCP listeners",
+                      address_->asString()));
+    }
+    addListenSocketOptions(Network::SocketOptionFactory::buildReusePortOptions());
+  }
+  if (config.has_connection_balance_config()) {
+    // Currently exact balance is the only supported type and there are no options.
+    ASSERT(config.connection_balance_config().has_exact_balance());
+    if (socket_type_ != Network::Address::SocketType::Stream) {
+      throw EnvoyException(fmt::format("error adding listener '{}': connection balancing is only "
+                                       "supported for TCP listeners",
+                                       address_->asString()));
+    }
+    connection_balancer_ = std::make_unique<Network::ExactConnectionBalancerImpl>();
+  } else {
+    connection_balancer_ = std::make_unique<Network::NopConnectionBalancerImpl>();
+  }
   if (socket_type_ == Network::Address::SocketType::Datagram) {
     // Needed for recvmsg to return destination address in IP header.
     addListenSocketOptions(Network::SocketOptionFactory::buildIpPacketInfoOptions());
@@ -432,23 +471,52 @@ void ListenerImpl::setSocket(const Network::SocketSharedPtr& socket) {
   ASSERT(!socket_);
   socket_ = socket;
   // Server config validation sets nullptr sockets.
-  if (socket_ && listen_socket_options_) {
-    // 'pre_bind = false' as bind() is never done after this.
-    bool ok = Network::Socket::applyOptions(listen_socket_options_, *socket_,
-                                            envoy::api::v2::core::SocketOption::STATE_BOUND);
-    const std::string message =
-        fmt::format("{}: Setting socket options {}", name_, ok ? "succeeded" : "failed");
-    if (!ok) {
-      ENVOY_LOG(warn, "{}", message);
-      throw EnvoyException(message);
-    } else {
-      ENVOY_LOG(debug, "{}", message);
+  if (socket_) {
+    applyListenSocketOptions(*socket_);
+  }
+}
+
+void ListenerImpl::setWorkerSockets(const std::vector<Network::SocketSharedPtr>& sockets) {
+  ASSERT(worker_sockets_.empty());
+  ASSERT(reuse_port_ || sockets.empty());
+  for (const auto& socket : sockets) {
+    // Server config validation sets nullptr sockets.
+    if (socket) {
+      applyListenSocketOptions(*socket);
     }
+  }
+  worker_sockets_ = sockets;
+}
 
-    // Add the options to the socket_ so that STATE_LISTENING options can be
-    // set in the worker after listen()/evconnlistener_new() is called.
-    socket_->addOptions(listen_socket_options_);
+void ListenerImpl::applyListenSocketOptions(Network::Socket& socket) {
+  if (!listen_socket_options_) {
+    return;
+  }
+
+  // 'pre_bind = false' as bind() is never done after this.
+  bool ok = Network::Socket::applyOptions(listen_socket_options_, socket,
+                                          envoy::api::v2::core::SocketOption::STATE_BOUND);
+  const std::string message =
+      fmt::format("{}: Setting socket options {}", name_, ok ? "succeeded" : "failed");
+  if (!ok) {
+    ENVOY_LOG(warn, "{}", message);
+    throw EnvoyException(message);
+  } else {
+    ENVOY_LOG(debug, "{}", message);
+  }
+
+  // Add the options to the socket so that STATE_LISTENING options can be
+  // set in the worker after listen()/evconnlistener_new() is called.
+  socket.addOptions(listen_socket_options_);
+}
+
+Network::Socket& ListenerImpl::listenSocket(uint32_t worker_index) {
+  // Without reuse_port, or when not binding to the port, all workers share the same socket.
+  if (worker_index == 0 || worker_sockets_.empty()) {
+    return *socket_;
   }
+  ASSERT(worker_index <= worker_sockets_.size());
+  return *worker_sockets_[worker_index - 1];
 }
 
 ListenerManagerImpl::ListenerManagerImpl(Instance& server,
@@ -462,7 +530,7 @@ ListenerManagerImpl::ListenerManagerImpl(Instance& server,
       enable_dispatcher_stats_(enable_dispatcher_stats) {
   for (uint32_t i = 0; i < server.options().concurrency(); i++) {
     workers_.emplace_back(
-        worker_factory.createWorker(server.overloadManager(), fmt::format("worker_{}", i)));
+        worker_factory.createWorker(i, server.overloadManager(), fmt::format("worker_{}", i)));
   }
 }
 
@@ -561,17 +629,32 @@ bool ListenerManagerImpl::addOrUpdateListener(const envoy::api::v2::Listener& co
     throw EnvoyException(message);
   }
 
+  // Likewise the per-worker sockets of a listener using reuse_port are handed over on updates, so
+  // the setting can't be changed for an existing listener.
+  if ((existing_warming_listener != warming_listeners_.end() &&
+       (*existing_warming_listener)->reusePort() != new_listener->reusePort()) ||
+      (existing_active_listener != active_listeners_.end() &&
+       (*existing_active_listener)->reusePort() != new_listener->reusePort())) {
+    const std::string message = fmt::format(
+        "error updating listener: '{}' has a different reuse_port value from existing listener",
+        name);
+    ENVOY_LOG(warn, "{}", message);
+    throw EnvoyException(message);
+  }
+
   bool added = false;
   if (existing_warming_listener != warming_listeners_.end()) {
     // In this case we can just replace inline.
     ASSERT(workers_started_);
     new_listener->debugLog("update warming listener");
     new_listener->setSocket((*existing_warming_listener)->getSocket());
+    new_listener->setWorkerSockets((*existing_warming_listener)->getWorkerSockets());
     *existing_warming_listener = std::move(new_listener);
   } else if (existing_active_listener != active_listeners_.end()) {
     // In this case we have no warming listener, so what we do depends on whether workers
-    // have been started or not. Either way we get the socket from the existing listener.
+    // have been started or not. Either way we get the sockets from the existing listener.
     new_listener->setSocket((*existing_active_listener)->getSocket());
+    new_listener->setWorkerSockets((*existing_active_listener)->getWorkerSockets());
     if (workers_started_) {
       new_listener->debugLog("add warming listener");
       warming_listeners_.emplace_back(std::move(new_listener));
@@ -607,6 +690,14 @@ bool ListenerManagerImpl::addOrUpdateListener(const envoy::api::v2::Listener& co
           return *new_listener->address() == *listener.listener_->socket().localAddress();
         });
     if (existing_draining_listener != draining_listeners_.cend()) {
+      if (existing_draining_listener->listener_->reusePort() != new_listener->reusePort()) {
+        const std::string message =
+            fmt::format("error adding listener: '{}' has a different reuse_port value from "
+                        "draining listener on address '{}'",
+                        name, new_listener->address()->asString());
+        ENVOY_LOG(warn, "{}", message);
+        throw EnvoyException(message);
+      }
       draining_listener_socket = existing_draining_listener->listener_->getSocket();
     }
 
@@ -616,6 +707,20 @@ bool ListenerManagerImpl::addOrUpdateListener(const envoy::api::v2::Listener& co
                                                               new_listener->socketType(),
                                                               new_listener->listenSocketOptions(),
                                                               new_listener->bindToPort()));
+    if (draining_listener_socket) {
+      new_listener->setWorkerSockets(existing_draining_listener->listener_->getWorkerSockets());
+    } else if (new_listener->reusePort() && new_listener->bindToPort() &&
+               new_listener->getSocket() != nullptr) {
+      // Every worker other than the first one gets its own socket, bound to the address that the
+      // first socket resolved so that all of them share the same port.
+      std::vector<Network::SocketSharedPtr> worker_sockets;
+      for (uint32_t i = 1; i < server_.options().concurrency(); i++) {
+        worker_sockets.push_back(
+            factory_.createWorkerListenSocket(new_listener->getSocket()->localAddress(),
+                                              new_listener->listenSocketOptions(), i));
+      }
+      new_listener->setWorkerSockets(worker_sockets);
+    }
     if (workers_started_) {
       new_listener->debugLog("add warming listener");
       warming_listeners_.emplace_back(std::move(new_listener));
@@ -115,6 +115,19 @@ OptionsImpl::OptionsImpl(int argc, const char* const* argv,
   TCLAP::ValueArg<bool> use_fake_symbol_table("", "use-fake-symbol-table",
                                               "Use fake symbol table implementation", false, true,
                                               "bool", cmd);
+  TCLAP::ValueArg<uint32_t> stats_counter_shards(
+      "", "stats-counter-shards",
+      "# of shards to split each counter into, so that threads do not contend to increment it",
+      false, 0, "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> stats_symbol_table_shards(
+      "", "stats-symbol-table-shards",
+      "# of shards to split the stats symbol table into, so that threads do not contend to "
+      "create and free stat names",
+      false, 1, "uint32_t", cmd);
+  TCLAP::SwitchArg stats_lock_free_histograms(
+      "", "stats-lock-free-histograms",
+      "Record histogram values without locking, so that merging them needs no post to workers", cmd,
+      false);
   cmd.setExceptionHandling(false);
   try {
     cmd.parse(argc, argv);
@@ -139,6 +152,14 @@ OptionsImpl::OptionsImpl(int argc, const char* const* argv,
 
   libevent_buffer_enabled_ = use_libevent_buffer.getValue();
   fake_symbol_table_enabled_ = use_fake_symbol_table.getValue();
+  stats_counter_shards_ = stats_counter_shards.getValue();
+  stats_symbol_table_shards_ = stats_symbol_table_shards.getValue();
+  if (fake_symbol_table_enabled_ && stats_symbol_table_shards_ > 1) {
+    // The fake symbol table has no symbols to shard.
+    throw MalformedArgvException(
+        "error: --stats-symbol-table-shards requires --use-fake-symbol-table false");
+  }
+  stats_lock_free_histograms_ = stats_lock_free_histograms.getValue();
   cpuset_threads_ = cpuset_threads.getValue();
 
   log_level_ = default_log_level;
@@ -291,6 +312,9 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_disable_hot_restart(hotRestartDisabled());
   command_line_options->set_enable_mutex_tracing(mutexTracingEnabled());
   command_line_options->set_cpuset_threads(cpusetThreadsEnabled());
+  command_line_options->set_stats_counter_shards(statsCounterShards());
+  command_line_options->set_stats_symbol_table_shards(statsSymbolTableShards());
+  command_line_options->set_stats_lock_free_histograms(statsLockFreeHistograms());
   command_line_options->set_restart_epoch(restartEpoch());
   return command_line_options;
 }
@@ -304,6 +328,7 @@ OptionsImpl::OptionsImpl(const std::string& service_cluster, const std::string&
       file_flush_interval_msec_(10000), drain_time_(600), parent_shutdown_time_(900),
       mode_(Server::Mode::Serve), hot_restart_disabled_(false), signal_handling_enabled_(true),
       mutex_tracing_enabled_(false), cpuset_threads_(false), libevent_buffer_enabled_(false),
-      fake_symbol_table_enabled_(false) {}
+      fake_symbol_table_enabled_(false), stats_counter_shards_(0), stats_symbol_table_shards_(1),
+      stats_lock_free_histograms_(false) {}
 
 } // namespace Envoy
@@ -84,6 +84,15 @@ public:
   void setFakeSymbolTableEnabled(bool fake_symbol_table_enabled) {
     fake_symbol_table_enabled_ = fake_symbol_table_enabled;
   }
+  void setStatsCounterShards(uint32_t stats_counter_shards) {
+    stats_counter_shards_ = stats_counter_shards;
+  }
+  void setStatsSymbolTableShards(uint32_t stats_symbol_table_shards) {
+    stats_symbol_table_shards_ = stats_symbol_table_shards;
+  }
+  void setStatsLockFreeHistograms(bool stats_lock_free_histograms) {
+    stats_lock_free_histograms_ = stats_lock_free_histograms;
+  }
 
   // Server::Options
   uint64_t baseId() const override { return base_id_; }
@@ -121,6 +130,9 @@ public:
   bool mutexTracingEnabled() const override { return mutex_tracing_enabled_; }
   bool libeventBufferEnabled() const override { return libevent_buffer_enabled_; }
   bool fakeSymbolTableEnabled() const override { return fake_symbol_table_enabled_; }
+  uint32_t statsCounterShards() const override { return stats_counter_shards_; }
+  uint32_t statsSymbolTableShards() const override { return stats_symbol_table_shards_; }
+  bool statsLockFreeHistograms() const override { return stats_lock_free_histograms_; }
   Server::CommandLineOptionsPtr toCommandLineOptions() const override;
   void parseComponentLogLevels(const std::string& component_log_levels);
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
@@ -157,6 +169,9 @@ private:
   bool cpuset_threads_;
   bool libevent_buffer_enabled_;
   bool fake_symbol_table_enabled_;
+  uint32_t stats_counter_shards_;
+  uint32_t stats_symbol_table_shards_;
+  bool stats_lock_free_histograms_;
   uint32_t count_;
 };
 
@@ -66,7 +66,7 @@ InstanceImpl::InstanceImpl(const Options& options, Event::TimeSystem& time_syste
                                          : absl::nullopt)),
       dispatcher_(api_->allocateDispatcher()),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
-      handler_(new ConnectionHandlerImpl(*dispatcher_, "main_thread")),
+      handler_(new ConnectionHandlerImpl(*dispatcher_, "main_thread", 0)),
       random_generator_(std::move(random_generator)), listener_component_factory_(*this),
       worker_factory_(thread_local_, *api_, hooks),
       dns_resolver_(dispatcher_->createDnsResolver({})),
@@ -136,34 +136,41 @@ void InstanceImpl::drainListeners() {
 
 void InstanceImpl::failHealthcheck(bool fail) { server_stats_->live_.set(!fail); }
 
-MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store) {
+MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store, bool changed_only) {
   snapped_counters_ = store.counters();
   counters_.reserve(snapped_counters_.size());
   for (const auto& counter : snapped_counters_) {
-    counters_.push_back({counter->latch(), *counter});
+    const uint64_t delta = counter->latch();
+    if (!changed_only || delta != 0) {
+      counters_.push_back({delta, *counter});
+    }
   }
 
   snapped_gauges_ = store.gauges();
   gauges_.reserve(snapped_gauges_.size());
   for (const auto& gauge : snapped_gauges_) {
     ASSERT(gauge->importMode() != Stats::Gauge::ImportMode::Uninitialized);
-    gauges_.push_back(*gauge);
+    if (!changed_only || gauge->latchChanged()) {
+      gauges_.push_back(*gauge);
+    }
   }
 
   snapped_histograms_ = store.histograms();
   histograms_.reserve(snapped_histograms_.size());
   for (const auto& histogram : snapped_histograms_) {
-    histograms_.push_back(*histogram);
+    if (!changed_only || histogram->intervalStatistics().sampleCount() != 0) {
+      histograms_.push_back(*histogram);
+    }
   }
 }
 
-void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks,
-                                       Stats::Store& store) {
+void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
+                                       bool changed_only) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store);
+  MetricSnapshotImpl snapshot(store, changed_only);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -186,6 +193,7 @@ void InstanceImpl::flushStats() {
 }
 
 void InstanceImpl::flushStatsInternal() {
+  Stats::Timespan flush_duration(server_stats_->stats_flush_duration_ms_, timeSource());
   // mergeParentStatsIfAny() does nothing and returns a struct of 0s if there is no parent.
   HotRestart::ServerStatsFromParent parent_stats = restarter_.mergeParentStatsIfAny(stats_store_);
 
@@ -193,6 +201,13 @@ void InstanceImpl::flushStatsInternal() {
   server_stats_->memory_allocated_.set(Memory::Stats::totalCurrentlyAllocated() +
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
+  const uint64_t slice_cache_hits = Memory::Stats::sliceCacheHits();
+  server_stats_->memory_slice_cache_hits_.add(slice_cache_hits - flushed_slice_cache_hits_);
+  flushed_slice_cache_hits_ = slice_cache_hits;
+  const uint64_t slice_cache_misses = Memory::Stats::sliceCacheMisses();
+  server_stats_->memory_slice_cache_misses_.add(slice_cache_misses - flushed_slice_cache_misses_);
+  flushed_slice_cache_misses_ = slice_cache_misses;
+  server_stats_->memory_slice_cache_retained_.set(Memory::Stats::sliceCacheRetainedBytes());
   server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   server_stats_->total_connections_.set(listener_manager_->numConnections() +
                                         parent_stats.parent_connections_);
@@ -200,7 +215,9 @@ void InstanceImpl::flushStatsInternal() {
       sslContextManager().daysUntilFirstCertExpires());
   server_stats_->state_.set(
       enumToInt(Utility::serverState(initManager().state(), healthCheckFailed())));
-  InstanceUtil::flushMetricsToSinks(config_.statsSinks(), stats_store_);
+  InstanceUtil::flushMetricsToSinks(config_.statsSinks(), stats_store_,
+                                    config_.statsFlushChangedOnly());
+  flush_duration.complete();
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(config_.statsFlushInterval());
@@ -52,18 +52,22 @@ namespace Server {
   COUNTER(static_unknown_fields)                                                                   \
   COUNTER(dynamic_unknown_fields)                                                                  \
   COUNTER(debug_assertion_failures)                                                                \
+  COUNTER(memory_slice_cache_hits)                                                                 \
+  COUNTER(memory_slice_cache_misses)                                                               \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, Accumulate)                                                \
   GAUGE(hot_restart_epoch, NeverImport)                                                            \
   GAUGE(live, NeverImport)                                                                         \
   GAUGE(memory_allocated, Accumulate)                                                              \
   GAUGE(memory_heap_size, Accumulate)                                                              \
+  GAUGE(memory_slice_cache_retained, NeverImport)                                                  \
   GAUGE(parent_connections, Accumulate)                                                            \
   GAUGE(state, NeverImport)                                                                        \
   GAUGE(total_connections, Accumulate)                                                             \
   GAUGE(uptime, Accumulate)                                                                        \
   GAUGE(version, NeverImport)                                                                      \
-  HISTOGRAM(initialization_time_ms)
+  HISTOGRAM(initialization_time_ms)                                                                \
+  HISTOGRAM(stats_flush_duration_ms)
 
 struct ServerStats {
   ALL_SERVER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
@@ -105,8 +109,11 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param changed_only supplies whether to only flush the metrics that changed since the last
+   *        flush that did so.
    */
-  static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store);
+  static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
+                                  bool changed_only = false);
 
   /**
    * Load a bootstrap config from either v1 or v2 and perform validation.
@@ -260,6 +267,10 @@ private:
   Configuration::MainImpl config_;
   Network::DnsResolverSharedPtr dns_resolver_;
   Event::TimerPtr stat_flush_timer_;
+  // The process wide slice cache totals as of the last flush, so that the counters are only
+  // incremented by what was added since.
+  uint64_t flushed_slice_cache_hits_{};
+  uint64_t flushed_slice_cache_misses_{};
   LocalInfo::LocalInfoPtr local_info_;
   DrainManagerPtr drain_manager_;
   AccessLog::AccessLogManagerImpl access_log_manager_;
@@ -307,7 +318,13 @@ private:
 //                     copying and probably be a cleaner API in general.
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
-  explicit MetricSnapshotImpl(Stats::Store& store);
+  /**
+   * @param store supplies the store to snapshot. All counters are latched.
+   * @param changed_only supplies whether the snapshot only holds the counters and gauges that
+   *        changed since the last such snapshot and the histograms that had samples in the
+   *        interval, rather than all metrics.
+   */
+  explicit MetricSnapshotImpl(Stats::Store& store, bool changed_only = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -353,7 +353,9 @@ TEST_P(OwnedImplTest, ReserveCommit) {
     // Request a reservation that is too large to fit in the remaining space at the end of
     // the last slice, and allow the buffer to use only one slice. This should result in the
     // creation of a new slice within the buffer.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, 1);
+    const uint64_t one_page_capacity =
+        4096 - sizeof(OwnedSlice) - Memory::BlockCache::HeaderSize;
+    num_reserved = buffer.reserve(one_page_capacity, iovecs, 1);
     const void* slice2 = iovecs[0].mem_;
     EXPECT_EQ(1, num_reserved);
     EXPECT_NE(slice1, slice2);
@@ -361,7 +363,7 @@ TEST_P(OwnedImplTest, ReserveCommit) {
 
     // Request the same size reservation, but allow the buffer to use multiple slices. This
     // should result in the buffer splitting the reservation between its last two slices.
-    num_reserved = buffer.reserve(4096 - sizeof(OwnedSlice), iovecs, NumIovecs);
+    num_reserved = buffer.reserve(one_page_capacity, iovecs, NumIovecs);
     EXPECT_EQ(2, num_reserved);
     EXPECT_EQ(slice1, iovecs[0].mem_);
     EXPECT_EQ(slice2, iovecs[1].mem_);
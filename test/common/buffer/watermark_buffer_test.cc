@@ -71,6 +71,18 @@ TEST_P(WatermarkBufferTest, AddBuffer) {
   EXPECT_EQ(11, buffer_.length());
 }
 
+TEST_P(WatermarkBufferTest, AddBufferFragment) {
+  BufferFragmentImpl first(TEN_BYTES, 10, nullptr);
+  buffer_.addBufferFragment(first);
+  EXPECT_EQ(0, times_high_watermark_called_);
+  BufferFragmentImpl second(TEN_BYTES, 1, nullptr);
+  buffer_.addBufferFragment(second);
+  EXPECT_EQ(1, times_high_watermark_called_);
+  EXPECT_EQ(11, buffer_.length());
+  buffer_.drain(11);
+  EXPECT_EQ(1, times_low_watermark_called_);
+}
+
 TEST_P(WatermarkBufferTest, Prepend) {
   std::string suffix = "World!", prefix = "Hello, ";
 
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/common/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+bool isAligned(const void* p, size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+TEST(MonotonicArenaTest, Empty) {
+  MonotonicArena arena;
+  EXPECT_EQ(0, arena.allocations());
+  EXPECT_EQ(0, arena.bytes());
+}
+
+TEST(MonotonicArenaTest, Alignment) {
+  MonotonicArena arena;
+  void* a = arena.allocate(1, 1);
+  void* b = arena.allocate(8, 8);
+  void* c = arena.allocate(3);
+  EXPECT_TRUE(isAligned(b, 8));
+  EXPECT_TRUE(isAligned(c, alignof(std::max_align_t)));
+  EXPECT_EQ(static_cast<char*>(a) + 8, b);
+  EXPECT_EQ(3, arena.allocations());
+  EXPECT_EQ(static_cast<char*>(c) + 3 - static_cast<char*>(a), arena.bytes());
+}
+
+// Allocations outgrow a heap block and single allocations larger than a heap block get a block of
+// their own. Everything stays valid until the arena is destroyed.
+TEST(MonotonicArenaTest, Blocks) {
+  MonotonicArena arena;
+  std::vector<char*> small;
+  for (int i = 0; i < 1000; i++) {
+    char* p = static_cast<char*>(arena.allocate(24));
+    EXPECT_TRUE(isAligned(p, alignof(std::max_align_t)));
+    memset(p, i & 0xff, 24);
+    small.push_back(p);
+  }
+  char* large = static_cast<char*>(arena.allocate(100000));
+  memset(large, 0xab, 100000);
+  char* after = static_cast<char*>(arena.allocate(24));
+  memset(after, 0xcd, 24);
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(static_cast<char>(i & 0xff), small[i][23]);
+  }
+  EXPECT_EQ(static_cast<char>(0xab), large[99999]);
+  EXPECT_EQ(1002, arena.allocations());
+  EXPECT_GE(arena.bytes(), 1000 * 24 + 100000 + 24);
+}
+
+// Allocations come from the inline block while they fit in it, and then continue on the heap.
+TEST(MonotonicArenaTest, InlineBlock) {
+  InlineMonotonicArena<64> arena;
+  const char* begin = reinterpret_cast<const char*>(&arena);
+  const char* end = begin + sizeof(arena);
+  auto is_inline = [begin, end](const void* p) {
+    return static_cast<const char*>(p) >= begin && static_cast<const char*>(p) < end;
+  };
+
+  EXPECT_TRUE(is_inline(arena.allocate(MonotonicArena::footprint(1))));
+  void* second = arena.allocate(64 - MonotonicArena::footprint(1));
+  EXPECT_TRUE(is_inline(second));
+  void* heap = arena.allocate(1);
+  EXPECT_FALSE(is_inline(heap));
+  EXPECT_TRUE(isAligned(heap, alignof(std::max_align_t)));
+  EXPECT_EQ(3, arena.allocations());
+}
+
+} // namespace
+} // namespace Envoy
@@ -56,6 +56,39 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+envoy::type::matcher::RegexMatcher googleReMatcher(const std::string& regex) {
+  envoy::type::matcher::RegexMatcher matcher;
+  matcher.mutable_google_re2();
+  matcher.set_regex(regex);
+  return matcher;
+}
+
+TEST(GoogleReMatcherSet, Match) {
+  GoogleReMatcherSet set;
+  EXPECT_EQ(0, set.add(googleReMatcher("/foo/.*")));
+  EXPECT_EQ(1, set.add(googleReMatcher("/bar")));
+  EXPECT_EQ(2, set.add(googleReMatcher("/fo+/b.r")));
+  EXPECT_EQ(3, set.size());
+  set.compile();
+
+  std::vector<int> matches;
+  EXPECT_TRUE(set.match("/foo/bar", matches));
+  EXPECT_EQ((std::vector<int>{0, 2}), matches);
+  EXPECT_TRUE(set.match("/bar", matches));
+  EXPECT_EQ((std::vector<int>{1}), matches);
+  // Expressions must match the whole value.
+  EXPECT_TRUE(set.match("/bar/", matches));
+  EXPECT_TRUE(matches.empty());
+  EXPECT_TRUE(set.match("x/foo/bar", matches));
+  EXPECT_TRUE(matches.empty());
+}
+
+TEST(GoogleReMatcherSet, InvalidRegex) {
+  GoogleReMatcherSet set;
+  EXPECT_THROW_WITH_MESSAGE(set.add(googleReMatcher("(+invalid)")), EnvoyException,
+                            "no argument for repetition operator: +");
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
@@ -26,5 +26,10 @@ TEST(ToLowerTableTest, All) {
     table.toLowerCase(input);
     EXPECT_EQ(input, "\x90hello\x90");
   }
+  {
+    std::string input("@AZ[`az{\xc1\xdaX-Forwarded-For");
+    table.toLowerCase(input);
+    EXPECT_EQ(input, "@az[`az{\xc1\xdax-forwarded-for");
+  }
 }
 } // namespace Envoy
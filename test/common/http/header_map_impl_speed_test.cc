@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include "common/http/header_map_impl.h"
 
 #include "benchmark/benchmark.h"
@@ -178,6 +181,29 @@ static void HeaderMapImplRemoveInline(benchmark::State& state) {
 }
 BENCHMARK(HeaderMapImplRemoveInline)->Arg(0)->Arg(1)->Arg(10)->Arg(50);
 
+/**
+ * Measure the speed of creating a HeaderMapImpl, adding state.range(0) headers to it the way a
+ * codec does and destroying it. This is dominated by allocating and freeing the header entries.
+ */
+static void HeaderMapImplAddViaMove(benchmark::State& state) {
+  std::vector<std::string> keys;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    keys.push_back("dummy-key-" + std::to_string(i));
+  }
+  for (auto _ : state) {
+    HeaderMapImpl headers;
+    for (const std::string& key : keys) {
+      HeaderString key_string;
+      key_string.setCopy(key.data(), key.size());
+      HeaderString value_string;
+      value_string.setCopy("abcd", 4);
+      headers.addViaMove(std::move(key_string), std::move(value_string));
+    }
+    benchmark::DoNotOptimize(headers.size());
+  }
+}
+BENCHMARK(HeaderMapImplAddViaMove)->Arg(1)->Arg(10)->Arg(25)->Arg(50);
+
 /**
  * Measure the speed of creating a HeaderMapImpl and populating it with a realistic
  * set of response headers.
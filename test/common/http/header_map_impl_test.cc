@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/http/header_map_impl.h"
 #include "common/http/header_utility.h"
@@ -685,6 +686,63 @@ TEST(HeaderMapImplTest, Equality) {
   EXPECT_FALSE(headers1 == headers2);
 }
 
+// Entries live in arena blocks of growing size and removed entries are reused. Headers must keep
+// their values and order across blocks and reuse.
+TEST(HeaderMapImplTest, ManyHeaders) {
+  HeaderMapImpl headers;
+  for (uint64_t i = 0; i < 200; i++) {
+    headers.addCopy(LowerCaseString("x-header-" + std::to_string(i)), i);
+  }
+  for (uint64_t i = 0; i < 200; i += 2) {
+    headers.remove(LowerCaseString("x-header-" + std::to_string(i)));
+  }
+  for (uint64_t i = 200; i < 300; i++) {
+    headers.addCopy(LowerCaseString("x-header-" + std::to_string(i)), i);
+  }
+  headers.insertPath().value(std::string("/"));
+  EXPECT_EQ(201UL, headers.size());
+
+  std::vector<std::string> keys;
+  headers.iterate(
+      [](const Http::HeaderEntry& header, void* context) -> HeaderMap::Iterate {
+        static_cast<std::vector<std::string>*>(context)->emplace_back(header.key().getStringView());
+        return HeaderMap::Iterate::Continue;
+      },
+      &keys);
+  ASSERT_EQ(201UL, keys.size());
+  EXPECT_EQ(":path", keys[0]);
+  EXPECT_EQ("x-header-1", keys[1]);
+  EXPECT_EQ("x-header-199", keys[100]);
+  EXPECT_EQ("x-header-200", keys[101]);
+  EXPECT_EQ("x-header-299", keys[200]);
+  EXPECT_EQ("151", headers.get(LowerCaseString("x-header-151"))->value().getStringView());
+  EXPECT_EQ("250", headers.get(LowerCaseString("x-header-250"))->value().getStringView());
+  EXPECT_EQ(nullptr, headers.get(LowerCaseString("x-header-150")));
+}
+
+// The slot of a removed entry is handed out to the next added entry, in the first block as well as
+// in later ones.
+TEST(HeaderMapImplTest, RemovedEntrySlotIsReused) {
+  HeaderMapImpl headers;
+  headers.addCopy(LowerCaseString("x-first"), "1");
+  headers.addCopy(LowerCaseString("x-second"), "2");
+  const HeaderEntry* first = headers.get(LowerCaseString("x-first"));
+  headers.remove(LowerCaseString("x-first"));
+  headers.addCopy(LowerCaseString("x-third"), "3");
+  EXPECT_EQ(first, headers.get(LowerCaseString("x-third")));
+
+  for (uint64_t i = 0; i < 20; i++) {
+    headers.addCopy(LowerCaseString("x-header-" + std::to_string(i)), i);
+  }
+  const HeaderEntry* last = headers.get(LowerCaseString("x-header-19"));
+  headers.remove(LowerCaseString("x-header-19"));
+  headers.addCopy(LowerCaseString("x-fourth"), "4");
+  EXPECT_EQ(last, headers.get(LowerCaseString("x-fourth")));
+  EXPECT_EQ("4", headers.get(LowerCaseString("x-fourth"))->value().getStringView());
+  EXPECT_EQ("3", headers.get(LowerCaseString("x-third"))->value().getStringView());
+  EXPECT_EQ(21UL, headers.size());
+}
+
 TEST(HeaderMapImplTest, LargeCharInHeader) {
   HeaderMapImpl headers;
   LowerCaseString static_key("\x90hello");
@@ -475,6 +475,20 @@ TEST(HeaderIsValidTest, ValidHeaderValuesAreAccepted) {
   EXPECT_TRUE(HeaderUtility::headerIsValid("Some Other Value"));
 }
 
+// Values are checked several bytes at a time. Invalid characters must be found at any offset and
+// only HTAB, SP, VCHAR and obs-text accepted.
+TEST(HeaderIsValidTest, LongHeaderValues) {
+  const std::string valid = "Mozilla/5.0 (X11; Linux x86_64)\t\x80\xff~!";
+  EXPECT_TRUE(HeaderUtility::headerIsValid(valid));
+  for (size_t offset = 0; offset < valid.size(); offset++) {
+    for (const char c : {'\0', '\n', '\r', '\x1f', '\x7f'}) {
+      std::string invalid = valid;
+      invalid[offset] = c;
+      EXPECT_FALSE(HeaderUtility::headerIsValid(invalid)) << offset << " " << int(c);
+    }
+  }
+}
+
 TEST(HeaderAddTest, HeaderAdd) {
   TestHeaderMapImpl headers{{"myheader1", "123value"}};
   TestHeaderMapImpl headers_to_add{{"myheader2", "456value"}};
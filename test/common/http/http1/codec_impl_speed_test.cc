@@ -0,0 +1,123 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/common/macros.h"
+#include "common/http/header_map_impl.h"
+#include "common/http/header_utility.h"
+#include "common/http/http1/codec_impl.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+/**
+ * Answers every request with an empty 200 response as soon as its headers are decoded, so that
+ * the codec is ready for the next request.
+ */
+class RespondingServerCallbacks : public ServerConnectionCallbacks, public StreamDecoder {
+public:
+  // Http::ServerConnectionCallbacks
+  StreamDecoder& newStream(StreamEncoder& response_encoder, bool) override {
+    response_encoder_ = &response_encoder;
+    return *this;
+  }
+  void onGoAway() override {}
+
+  // Http::StreamDecoder
+  void decode100ContinueHeaders(HeaderMapPtr&&) override {}
+  void decodeHeaders(HeaderMapPtr&& headers, bool end_stream) override {
+    benchmark::DoNotOptimize(headers->size());
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeData(Buffer::Instance& data, bool end_stream) override {
+    data.drain(data.length());
+    if (end_stream) {
+      respond();
+    }
+  }
+  void decodeTrailers(HeaderMapPtr&&) override {}
+  void decodeMetadata(MetadataMapPtr&&) override {}
+
+private:
+  void respond() {
+    HeaderMapImpl response_headers{{Headers::get().Status, "200"}};
+    response_encoder_->encodeHeaders(response_headers, true);
+  }
+
+  StreamEncoder* response_encoder_{};
+};
+
+const std::string& browserRequest() {
+  CONSTRUCT_ON_FIRST_USE(
+      std::string,
+      "GET /static/js/application.bundle.min.js?version=20191017 HTTP/1.1\r\n"
+      "Host: www.example.com\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:69.0) Gecko/20100101 Firefox/69.0\r\n"
+      "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+      "Accept-Language: en-US,en;q=0.5\r\n"
+      "Accept-Encoding: gzip, deflate, br\r\n"
+      "Referer: https://www.example.com/products/catalog/index.html\r\n"
+      "Cookie: session=0123456789abcdef0123456789abcdef; preferences=theme%3Ddark%26lang%3Den\r\n"
+      "Connection: keep-alive\r\n"
+      "Upgrade-Insecure-Requests: 1\r\n"
+      "Cache-Control: max-age=0\r\n"
+      "\r\n");
+}
+
+/**
+ * Measure decoding a typical browser GET request through the HTTP/1 server codec, including
+ * header name lower casing and value validation.
+ */
+void BM_ServerDecodeRequest(benchmark::State& state) {
+  testing::NiceMock<Network::MockConnection> connection;
+  Stats::IsolatedStoreImpl stats;
+  RespondingServerCallbacks callbacks;
+  ServerConnectionImpl codec(connection, stats, callbacks, Http1Settings(),
+                             DEFAULT_MAX_REQUEST_HEADERS_KB);
+  const std::string& request = browserRequest();
+
+  for (auto _ : state) {
+    Buffer::OwnedImpl buffer(request);
+    codec.dispatch(buffer);
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(BM_ServerDecodeRequest);
+
+/**
+ * Measure header value validation on its own, for values of state.range(0) bytes.
+ */
+void BM_HeaderIsValid(benchmark::State& state) {
+  const std::string value(state.range(0), 'a');
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HeaderUtility::headerIsValid(value));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(BM_HeaderIsValid)->Arg(16)->Arg(128)->Arg(1024);
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
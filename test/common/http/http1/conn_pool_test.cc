@@ -325,6 +325,79 @@ TEST_F(Http1ConnPoolImplTest, MultipleRequestAndResponse) {
   dispatcher_.clearDeferredDeleteList();
 }
 
+/**
+ * Test that spare connections are opened before the first request and replaced as soon as
+ * requests take them.
+ */
+TEST_F(Http1ConnPoolImplTest, SpareConnections) {
+  ON_CALL(*cluster_, spareConnectionsPerHost()).WillByDefault(Return(1));
+  // Mock timers are handed out newest first, and the warm up timer is created last.
+  NiceMock<Event::MockTimer>* warm_up_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*warm_up_timer, enableTimer(std::chrono::milliseconds(0), _));
+  ConnPoolImplForTest conn_pool(dispatcher_, cluster_,
+                                new NiceMock<Event::MockTimer>(&dispatcher_));
+
+  conn_pool.expectClientCreate();
+  warm_up_timer->invokeCallback();
+  EXPECT_EQ(1U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_CALL(*conn_pool.test_clients_[0].connect_timer_, disableTimer());
+  conn_pool.test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  // The request does not wait for a connection, and a new spare connection is opened.
+  NiceMock<Http::MockStreamDecoder> outer_decoder;
+  ConnPoolCallbacks callbacks;
+  NiceMock<Http::MockStreamEncoder> request_encoder;
+  Http::StreamDecoder* inner_decoder;
+  EXPECT_CALL(*conn_pool.test_clients_[0].codec_, newStream(_))
+      .WillOnce(DoAll(SaveArgAddress(&inner_decoder), ReturnRef(request_encoder)));
+  EXPECT_CALL(callbacks.pool_ready_, ready());
+  conn_pool.expectClientCreate();
+  EXPECT_EQ(nullptr, conn_pool.newStream(outer_decoder, callbacks));
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_total_.value());
+
+  callbacks.outer_encoder_->encodeHeaders(TestHeaderMapImpl{}, true);
+  inner_decoder->decodeHeaders(HeaderMapPtr{new TestHeaderMapImpl{{":status", "200"}}}, true);
+
+  // Cause the connections to go away. The spare connection that is still connecting makes up for
+  // the closed one.
+  EXPECT_CALL(conn_pool, onClientDestroy()).Times(2);
+  conn_pool.test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  conn_pool.test_clients_[1].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+}
+
+/**
+ * Test that a spare connection closed by the upstream is replaced right away, while a failed
+ * connection attempt is left for the next request to retry.
+ */
+TEST_F(Http1ConnPoolImplTest, SpareConnectionReplacedOnRemoteClose) {
+  ON_CALL(*cluster_, spareConnectionsPerHost()).WillByDefault(Return(1));
+  // Mock timers are handed out newest first, and the warm up timer is created last.
+  NiceMock<Event::MockTimer>* warm_up_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  ConnPoolImplForTest conn_pool(dispatcher_, cluster_,
+                                new NiceMock<Event::MockTimer>(&dispatcher_));
+
+  conn_pool.expectClientCreate();
+  warm_up_timer->invokeCallback();
+  EXPECT_CALL(*conn_pool.test_clients_[0].connect_timer_, disableTimer());
+  conn_pool.test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  EXPECT_CALL(conn_pool, onClientDestroy());
+  conn_pool.expectClientCreate();
+  conn_pool.test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+
+  // The closed client is gone from test_clients_, so the replacement is the first one now.
+  EXPECT_CALL(conn_pool, onClientDestroy());
+  conn_pool.test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_EQ(1U, cluster_->stats_.upstream_cx_connect_fail_.value());
+}
+
 /**
  * Test when we overflow max pending requests.
  */
@@ -882,6 +955,23 @@ TEST_F(Http1ConnPoolImplTest, PendingRequestIsConsideredActive) {
   EXPECT_EQ(1U, cluster_->stats_.upstream_cx_destroy_remote_.value());
 }
 
+// Show that only connections without a request in progress are usable for new requests.
+TEST_F(Http1ConnPoolImplTest, ReadyConnectionIsUsable) {
+  EXPECT_FALSE(conn_pool_.hasUsableConnection());
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r1.startRequest();
+  EXPECT_FALSE(conn_pool_.hasUsableConnection());
+
+  r1.completeResponse(false);
+  EXPECT_TRUE(conn_pool_.hasUsableConnection());
+
+  conn_pool_.drainConnections();
+  EXPECT_CALL(conn_pool_, onClientDestroy());
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_FALSE(conn_pool_.hasUsableConnection());
+}
+
 } // namespace
 } // namespace Http1
 } // namespace Http
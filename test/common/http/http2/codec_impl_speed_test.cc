@@ -0,0 +1,152 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/http/header_map_impl.h"
+#include "common/http/http2/codec_impl.h"
+#include "common/stats/isolated_store_impl.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+/**
+ * Discards everything decoded on a stream.
+ */
+class NullStreamDecoder : public StreamDecoder {
+public:
+  // Http::StreamDecoder
+  void decode100ContinueHeaders(HeaderMapPtr&&) override {}
+  void decodeHeaders(HeaderMapPtr&& headers, bool) override {
+    benchmark::DoNotOptimize(headers->size());
+  }
+  void decodeData(Buffer::Instance& data, bool) override { data.drain(data.length()); }
+  void decodeTrailers(HeaderMapPtr&& trailers) override {
+    benchmark::DoNotOptimize(trailers->size());
+  }
+  void decodeMetadata(MetadataMapPtr&&) override {}
+};
+
+/**
+ * Answers every unary gRPC request with response headers, a message and trailers as soon as the
+ * request is complete.
+ */
+class GrpcServerCallbacks : public ServerConnectionCallbacks, public NullStreamDecoder {
+public:
+  // Http::ServerConnectionCallbacks
+  StreamDecoder& newStream(StreamEncoder& response_encoder, bool) override {
+    response_encoder_ = &response_encoder;
+    return *this;
+  }
+  void onGoAway() override {}
+
+  // Http::StreamDecoder
+  void decodeData(Buffer::Instance& data, bool end_stream) override {
+    data.drain(data.length());
+    if (end_stream) {
+      response_encoder_->encodeHeaders(response_headers_, false);
+      Buffer::OwnedImpl message(std::string(64, 'a'));
+      response_encoder_->encodeData(message, false);
+      response_encoder_->encodeTrailers(response_trailers_);
+    }
+  }
+
+private:
+  const HeaderMapImpl response_headers_{
+      {Headers::get().Status, "200"},
+      {Headers::get().ContentType, "application/grpc"},
+      {Headers::get().GrpcAcceptEncoding, "identity,deflate,gzip"},
+      {Headers::get().Server, "envoy"},
+      {Headers::get().Date, "Fri, 18 Oct 2019 12:00:00 GMT"}};
+  const HeaderMapImpl response_trailers_{{Headers::get().GrpcStatus, "0"},
+                                         {Headers::get().GrpcMessage, ""}};
+  StreamEncoder* response_encoder_{};
+};
+
+class NullConnectionCallbacks : public ConnectionCallbacks {
+public:
+  // Http::ConnectionCallbacks
+  void onGoAway() override {}
+};
+
+/**
+ * Measure unary gRPC calls over one HTTP/2 connection, encoding and decoding the request and
+ * response headers, a message in each direction and the response trailers.
+ */
+void BM_GrpcUnaryCall(benchmark::State& state) {
+  Stats::IsolatedStoreImpl stats;
+  NiceMock<Network::MockConnection> client_connection;
+  NiceMock<Network::MockConnection> server_connection;
+  NullConnectionCallbacks client_callbacks;
+  GrpcServerCallbacks server_callbacks;
+  ClientConnectionImpl client(client_connection, client_callbacks, stats, Http2Settings(),
+                              DEFAULT_MAX_REQUEST_HEADERS_KB);
+  ServerConnectionImpl server(server_connection, server_callbacks, stats, Http2Settings(),
+                              DEFAULT_MAX_REQUEST_HEADERS_KB);
+
+  // Writes are queued and pumped to the peer after each call, so that neither codec is dispatched
+  // from within its peer's send path.
+  Buffer::OwnedImpl to_server;
+  Buffer::OwnedImpl to_client;
+  ON_CALL(client_connection, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) { to_server.move(data); }));
+  ON_CALL(server_connection, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) { to_client.move(data); }));
+  auto pump = [&]() {
+    while (to_server.length() > 0 || to_client.length() > 0) {
+      if (to_server.length() > 0) {
+        server.dispatch(to_server);
+      }
+      if (to_client.length() > 0) {
+        client.dispatch(to_client);
+      }
+    }
+  };
+
+  const HeaderMapImpl request_headers{
+      {Headers::get().Method, "POST"},
+      {Headers::get().Scheme, "http"},
+      {Headers::get().Path, "/helloworld.Greeter/SayHello"},
+      {Headers::get().Host, "greeter.example.com"},
+      {Headers::get().ContentType, "application/grpc"},
+      {Headers::get().TE, "trailers"},
+      {Headers::get().GrpcTimeout, "1S"},
+      {Headers::get().GrpcAcceptEncoding, "identity,deflate,gzip"},
+      {Headers::get().UserAgent, "grpc-c++/1.24.0 grpc-c/8.0.0 (linux; chttp2; ganges)"}};
+  NullStreamDecoder response_decoder;
+
+  for (auto _ : state) {
+    StreamEncoder& request_encoder = client.newStream(response_decoder);
+    request_encoder.encodeHeaders(request_headers, false);
+    Buffer::OwnedImpl message(std::string(64, 'a'));
+    request_encoder.encodeData(message, true);
+    pump();
+  }
+}
+BENCHMARK(BM_GrpcUnaryCall);
+
+} // namespace
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "envoy/http/codec.h"
 #include "envoy/stats/scope.h"
@@ -44,14 +45,33 @@ public:
       if (!dispatching_) {
         while (buffer_.length() > 0) {
           dispatching_ = true;
+          dispatched_slices_.resize(buffer_.getRawSlices(nullptr, 0));
+          buffer_.getRawSlices(dispatched_slices_.data(), dispatched_slices_.size());
           connection.dispatch(buffer_);
           dispatching_ = false;
         }
       }
     }
 
+    // Whether data references the memory of the input of the dispatch() in progress.
+    bool referencesInput(const Buffer::Instance& data) const {
+      std::vector<Buffer::RawSlice> slices(data.getRawSlices(nullptr, 0));
+      data.getRawSlices(slices.data(), slices.size());
+      for (const Buffer::RawSlice& slice : slices) {
+        const char* mem = static_cast<const char*>(slice.mem_);
+        for (const Buffer::RawSlice& input : dispatched_slices_) {
+          const char* input_mem = static_cast<const char*>(input.mem_);
+          if (mem >= input_mem && mem + slice.len_ <= input_mem + input.len_) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
     bool dispatching_{};
     Buffer::OwnedImpl buffer_;
+    std::vector<Buffer::RawSlice> dispatched_slices_;
   };
 
   Http2CodecImplTestFixture(Http2SettingsTuple client_settings, Http2SettingsTuple server_settings)
@@ -99,6 +119,7 @@ public:
     setting.initial_stream_window_size_ = ::testing::get<2>(tp);
     setting.initial_connection_window_size_ = ::testing::get<3>(tp);
     setting.allow_metadata_ = allow_metadata_;
+    setting.zero_copy_data_frames_ = zero_copy_data_frames_;
     setting.stream_error_on_invalid_http_messaging_ = stream_error_on_invalid_http_messaging_;
     setting.max_outbound_frames_ = max_outbound_frames_;
     setting.max_outbound_control_frames_ = max_outbound_control_frames_;
@@ -131,6 +152,7 @@ public:
   const Http2SettingsTuple client_settings_;
   const Http2SettingsTuple server_settings_;
   bool allow_metadata_ = false;
+  bool zero_copy_data_frames_ = false;
   bool stream_error_on_invalid_http_messaging_ = false;
   Stats::IsolatedStoreImpl stats_store_;
   Http2Settings client_http2settings_;
@@ -549,6 +571,39 @@ TEST_P(Http2CodecImplTest, TrailingHeadersLargeBody) {
   response_encoder_->encodeTrailers(TestHeaderMapImpl{{"trailing", "header"}});
 }
 
+// With zero copy enabled, large DATA frame payloads reference the dispatched input and stay valid
+// after dispatch() returns, while small ones are copied.
+TEST_P(Http2CodecImplTest, ZeroCopyDataFrames) {
+  zero_copy_data_frames_ = true;
+  initialize();
+
+  TestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  request_encoder_->encodeHeaders(request_headers, false);
+
+  Buffer::OwnedImpl received;
+  bool referenced = false;
+  EXPECT_CALL(request_decoder_, decodeData(_, _))
+      .Times(AtLeast(2))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data, bool) {
+        referenced |= server_wrapper_.referencesInput(data);
+        received.move(data);
+      }));
+  Buffer::OwnedImpl small("hello");
+  request_encoder_->encodeData(small, false);
+  EXPECT_FALSE(referenced);
+  std::string body;
+  for (uint32_t i = 0; i < 256 * 1024; i++) {
+    body.push_back(static_cast<char>(i % 251));
+  }
+  Buffer::OwnedImpl large(body);
+  request_encoder_->encodeData(large, true);
+
+  EXPECT_TRUE(referenced);
+  EXPECT_EQ("hello" + body, received.toString());
+}
+
 TEST_P(Http2CodecImplTest, SmallMetadataVecTest) {
   allow_metadata_ = true;
   initialize();
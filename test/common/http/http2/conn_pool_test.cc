@@ -767,6 +767,22 @@ TEST_F(Http2ConnPoolImplTest, DrainedConnectionsNotActive) {
 
   closeClient(0);
 }
+
+// Show that new requests use the primary connection from when it is created until it closes.
+TEST_F(Http2ConnPoolImplTest, PrimaryConnectionUsableUntilClosed) {
+  EXPECT_FALSE(pool_.hasUsableConnection());
+
+  expectClientCreate();
+  ActiveTestRequest r1(*this, 0, false);
+  EXPECT_TRUE(pool_.hasUsableConnection());
+
+  expectClientConnect(0, r1);
+  completeRequest(r1);
+  EXPECT_TRUE(pool_.hasUsableConnection());
+
+  closeClient(0);
+  EXPECT_FALSE(pool_.hasUsableConnection());
+}
 } // namespace Http2
 } // namespace Http
 } // namespace Envoy
@@ -0,0 +1,89 @@
+#include <cstring>
+#include <thread>
+
+#include "common/memory/block_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+constexpr size_t OnePageBlock = BlockCache::PageSize - BlockCache::HeaderSize;
+
+class BlockCacheTest : public testing::Test {
+protected:
+  // Each test runs on a fresh thread so that it starts with an empty thread cache and its
+  // counters are published when the thread exits.
+  template <class Fn> void runOnThread(Fn fn) {
+    std::thread thread(fn);
+    thread.join();
+  }
+};
+
+TEST_F(BlockCacheTest, ReusesReleasedBlock) {
+  const uint64_t hits = BlockCache::hits();
+  const uint64_t misses = BlockCache::misses();
+  runOnThread([] {
+    void* first = BlockCache::allocate(OnePageBlock);
+    memset(first, 'a', OnePageBlock);
+    BlockCache::release(first);
+    void* second = BlockCache::allocate(OnePageBlock);
+    EXPECT_EQ(first, second);
+    BlockCache::release(second);
+  });
+  EXPECT_EQ(hits + 1, BlockCache::hits());
+  EXPECT_EQ(misses + 1, BlockCache::misses());
+}
+
+TEST_F(BlockCacheTest, SizeClassesAreSeparate) {
+  runOnThread([] {
+    void* one_page = BlockCache::allocate(OnePageBlock);
+    BlockCache::release(one_page);
+    void* two_pages = BlockCache::allocate(OnePageBlock + BlockCache::PageSize);
+    EXPECT_NE(one_page, two_pages);
+    BlockCache::release(two_pages);
+  });
+}
+
+TEST_F(BlockCacheTest, UncacheableSizes) {
+  const uint64_t misses = BlockCache::misses();
+  runOnThread([] {
+    // Neither a partial page nor a block above the size limit goes through the cache.
+    void* small = BlockCache::allocate(100);
+    BlockCache::release(small);
+    void* large = BlockCache::allocate(BlockCache::PageSize * (BlockCache::MaxCachedPages + 1) -
+                                       BlockCache::HeaderSize);
+    BlockCache::release(large);
+    BlockCache::release(nullptr);
+  });
+  EXPECT_EQ(misses, BlockCache::misses());
+}
+
+TEST_F(BlockCacheTest, RetainedBytesAreBounded) {
+  constexpr size_t MaxCachedBlocks = BlockCache::MaxCachedBytesPerThread / BlockCache::PageSize;
+  constexpr size_t NumBlocks = MaxCachedBlocks + 10;
+  const uint64_t hits = BlockCache::hits();
+  const uint64_t misses = BlockCache::misses();
+  const uint64_t retained = BlockCache::retainedBytes();
+  runOnThread([] {
+    void* blocks[NumBlocks];
+    for (int round = 0; round < 2; round++) {
+      for (void*& block : blocks) {
+        block = BlockCache::allocate(OnePageBlock);
+      }
+      for (void* block : blocks) {
+        BlockCache::release(block);
+      }
+    }
+  });
+  // The second round only finds the blocks that fit in the cache.
+  EXPECT_EQ(hits + MaxCachedBlocks, BlockCache::hits());
+  EXPECT_EQ(misses + NumBlocks + 10, BlockCache::misses());
+  // Everything cached by the thread is freed when it exits.
+  EXPECT_EQ(retained, BlockCache::retainedBytes());
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,83 @@
+#include "common/network/connection_balancer_impl.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+TEST(NopConnectionBalancerImplTest, KeepsCurrentHandler) {
+  NopConnectionBalancerImpl balancer;
+  MockBalancedConnectionHandler handler;
+  ConnectionSocketPtr socket = std::make_unique<NiceMock<MockConnectionSocket>>();
+
+  EXPECT_CALL(handler, incNumConnections());
+  EXPECT_CALL(handler, post_(_)).Times(0);
+  EXPECT_FALSE(balancer.balanceConnection(handler, socket));
+  EXPECT_NE(nullptr, socket);
+}
+
+TEST(ExactConnectionBalancerImplTest, BalanceToLeastLoadedHandler) {
+  ExactConnectionBalancerImpl balancer;
+  MockBalancedConnectionHandler handler1;
+  MockBalancedConnectionHandler handler2;
+  balancer.registerHandler(handler1);
+  balancer.registerHandler(handler2);
+
+  // handler1 has fewer connections so the socket stays where it was accepted.
+  {
+    ConnectionSocketPtr socket = std::make_unique<NiceMock<MockConnectionSocket>>();
+    EXPECT_CALL(handler1, numConnections()).WillRepeatedly(Return(1));
+    EXPECT_CALL(handler2, numConnections()).WillRepeatedly(Return(2));
+    EXPECT_CALL(handler1, incNumConnections());
+    EXPECT_CALL(handler1, post_(_)).Times(0);
+    EXPECT_FALSE(balancer.balanceConnection(handler1, socket));
+    EXPECT_NE(nullptr, socket);
+  }
+
+  // handler2 has fewer connections so the socket is posted to it.
+  {
+    ConnectionSocketPtr socket = std::make_unique<NiceMock<MockConnectionSocket>>();
+    ConnectionSocket* raw_socket = socket.get();
+    EXPECT_CALL(handler1, numConnections()).WillRepeatedly(Return(3));
+    EXPECT_CALL(handler2, numConnections()).WillRepeatedly(Return(2));
+    EXPECT_CALL(handler2, incNumConnections());
+    EXPECT_CALL(handler2, post_(_)).WillOnce(Invoke([raw_socket](ConnectionSocketPtr& posted) {
+      EXPECT_EQ(raw_socket, posted.get());
+    }));
+    EXPECT_TRUE(balancer.balanceConnection(handler1, socket));
+  }
+
+  // On a tie the current handler wins, avoiding a needless transfer.
+  {
+    ConnectionSocketPtr socket = std::make_unique<NiceMock<MockConnectionSocket>>();
+    EXPECT_CALL(handler1, numConnections()).WillRepeatedly(Return(2));
+    EXPECT_CALL(handler2, numConnections()).WillRepeatedly(Return(2));
+    EXPECT_CALL(handler2, incNumConnections());
+    EXPECT_CALL(handler1, post_(_)).Times(0);
+    EXPECT_FALSE(balancer.balanceConnection(handler2, socket));
+  }
+
+  // Once unregistered, a handler is no longer a balancing target.
+  balancer.unregisterHandler(handler2);
+  {
+    ConnectionSocketPtr socket = std::make_unique<NiceMock<MockConnectionSocket>>();
+    EXPECT_CALL(handler1, numConnections()).WillRepeatedly(Return(5));
+    EXPECT_CALL(handler2, numConnections()).Times(0);
+    EXPECT_CALL(handler1, incNumConnections());
+    EXPECT_FALSE(balancer.balanceConnection(handler1, socket));
+  }
+  balancer.unregisterHandler(handler1);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
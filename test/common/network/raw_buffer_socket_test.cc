@@ -0,0 +1,110 @@
+#include <list>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/network/io_socket_error_impl.h"
+#include "common/network/io_socket_handle_impl.h"
+#include "common/network/raw_buffer_socket.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+// An IoHandle whose writev() returns scripted byte counts, and EAGAIN once they run out.
+class ScriptedWriteIoHandle : public IoSocketHandleImpl {
+public:
+  explicit ScriptedWriteIoHandle(std::list<uint64_t> write_sizes)
+      : write_sizes_(std::move(write_sizes)) {}
+
+  Api::IoCallUint64Result writev(const Buffer::RawSlice*, uint64_t) override {
+    ++writev_calls_;
+    if (write_sizes_.empty()) {
+      return Api::IoCallUint64Result(0, Api::IoErrorPtr(IoSocketError::getIoSocketEagainInstance(),
+                                                        IoSocketError::deleteIoError));
+    }
+    const uint64_t size = write_sizes_.front();
+    write_sizes_.pop_front();
+    return Api::IoCallUint64Result(size, Api::IoErrorPtr(nullptr, IoSocketError::deleteIoError));
+  }
+
+  std::list<uint64_t> write_sizes_;
+  uint32_t writev_calls_{};
+};
+
+class RawBufferSocketWriteTest : public testing::Test {
+public:
+  IoResult doWrite(ScriptedWriteIoHandle& io_handle, Buffer::Instance& buffer) {
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle));
+    socket_.setTransportSocketCallbacks(callbacks_);
+    return socket_.doWrite(buffer, false);
+  }
+
+  NiceMock<MockTransportSocketCallbacks> callbacks_;
+  RawBufferSocket socket_;
+};
+
+// A write that stops inside a slice is not followed by a writev() that could only fail.
+TEST_F(RawBufferSocketWriteTest, ShortWriteSkipsEagainWrite) {
+  ScriptedWriteIoHandle io_handle({40});
+  Buffer::OwnedImpl buffer(std::string(100, 'a'));
+
+  IoResult result = doWrite(io_handle, buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(40, result.bytes_processed_);
+  EXPECT_EQ(60, buffer.length());
+  EXPECT_EQ(1, io_handle.writev_calls_);
+}
+
+// A write that stops on a slice boundary may have been limited by the number of slices, so the
+// writes go on until EAGAIN.
+TEST_F(RawBufferSocketWriteTest, WriteOnSliceBoundaryContinues) {
+  ScriptedWriteIoHandle io_handle({3});
+  Buffer::OwnedImpl buffer;
+  Buffer::BufferFragmentImpl first("abc", 3, nullptr);
+  Buffer::BufferFragmentImpl second("defgh", 5, nullptr);
+  buffer.addBufferFragment(first);
+  buffer.addBufferFragment(second);
+
+  IoResult result = doWrite(io_handle, buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(3, result.bytes_processed_);
+  EXPECT_EQ("defgh", buffer.toString());
+  EXPECT_EQ(2, io_handle.writev_calls_);
+}
+
+// A write of the whole buffer needs no further writev().
+TEST_F(RawBufferSocketWriteTest, CompleteWrite) {
+  ScriptedWriteIoHandle io_handle({100});
+  Buffer::OwnedImpl buffer(std::string(100, 'a'));
+
+  IoResult result = doWrite(io_handle, buffer);
+  EXPECT_EQ(PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(100, result.bytes_processed_);
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_EQ(1, io_handle.writev_calls_);
+}
+
+TEST(RawBufferSocketTest, EndsInsideSlice) {
+  char data[8];
+  Buffer::RawSlice slices[2] = {{data, 3}, {data + 3, 5}};
+
+  EXPECT_FALSE(RawBufferSocket::endsInsideSlice(0, slices, 2));
+  EXPECT_TRUE(RawBufferSocket::endsInsideSlice(1, slices, 2));
+  // A write that stops on a slice boundary may have been limited by the iovec count.
+  EXPECT_FALSE(RawBufferSocket::endsInsideSlice(3, slices, 2));
+  EXPECT_TRUE(RawBufferSocket::endsInsideSlice(7, slices, 2));
+  EXPECT_FALSE(RawBufferSocket::endsInsideSlice(8, slices, 2));
+  EXPECT_FALSE(RawBufferSocket::endsInsideSlice(12, slices, 2));
+  EXPECT_FALSE(RawBufferSocket::endsInsideSlice(1, slices, 0));
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
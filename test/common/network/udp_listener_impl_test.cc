@@ -17,6 +17,7 @@
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -84,16 +85,29 @@ protected:
               client_socket_->localAddress()->ip()->addressAsString());
 
     EXPECT_EQ(*data.local_address_, *send_to_addr_);
-    EXPECT_EQ(time_system_.monotonicTime(), data.receive_time_);
-    // Advance time so that next onData() should have different received time.
+    // Packets read by the same recvmmsg() call share the receive time of the first one.
+    if (data.receive_time_ != last_receive_time_) {
+      EXPECT_EQ(time_system_.monotonicTime(), data.receive_time_);
+      last_receive_time_ = data.receive_time_;
+    }
+    // Advance time so that the next read should have a different received time.
     time_system_.sleep(std::chrono::milliseconds(100));
   }
 
+  void sendPackets(const std::vector<std::string>& payloads) {
+    for (const std::string& payload : payloads) {
+      Buffer::RawSlice slice{const_cast<char*>(payload.c_str()), payload.length()};
+      auto send_rc = client_socket_->ioHandle().sendto(slice, 0, *send_to_addr_);
+      ASSERT_EQ(send_rc.rc_, payload.length());
+    }
+  }
+
   SocketPtr server_socket_;
   SocketPtr client_socket_;
   Address::InstanceConstSharedPtr send_to_addr_;
   MockUdpListenerCallbacks listener_callbacks_;
   std::unique_ptr<UdpListenerImpl> listener_;
+  MonotonicTime last_receive_time_;
 };
 
 INSTANTIATE_TEST_SUITE_P(IpVersions, UdpListenerImplTest,
@@ -347,6 +361,112 @@ TEST_P(UdpListenerImplTest, UdpListenerRecvMsgError) {
   dispatcher_->run(Event::Dispatcher::RunType::Block);
 }
 
+/**
+ * Tests UDP listener's error callback when packets are read in batches.
+ */
+TEST_P(UdpListenerImplTest, UdpListenerRecvMmsgError) {
+  client_socket_ = createClientSocket(false);
+
+  const std::string first("first");
+  const void* void_pointer = static_cast<const void*>(first.c_str());
+  Buffer::RawSlice first_slice{const_cast<void*>(void_pointer), first.length()};
+
+  auto send_rc = client_socket_->ioHandle().sendto(first_slice, 0, *send_to_addr_);
+  ASSERT_EQ(send_rc.rc_, first.length());
+
+  EXPECT_CALL(listener_callbacks_, onData_(_)).Times(0);
+  EXPECT_CALL(listener_callbacks_, onWriteReady_(_));
+  EXPECT_CALL(listener_callbacks_, onReceiveError_(_, _))
+      .WillOnce(Invoke([&](const UdpListenerCallbacks::ErrorCode& err_code,
+                           Api::IoError::IoErrorCode err) -> void {
+        ASSERT_EQ(UdpListenerCallbacks::ErrorCode::SyscallError, err_code);
+        ASSERT_EQ(Api::IoError::IoErrorCode::NoSupport, err);
+
+        dispatcher_->exit();
+      }));
+  // Inject mocked OsSysCalls implementation to mock a batched read failure.
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsMmsg()).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+  EXPECT_CALL(os_sys_calls, recvmmsg(_, _, 16, MSG_WAITFORONE, nullptr))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOTSUP}));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+}
+
+#if defined(__linux__)
+/**
+ * Tests that a batch of packets which doesn't fill recvmmsg() is read with a single call, without
+ * a further call that could only return EAGAIN.
+ */
+TEST_P(UdpListenerImplTest, UdpListenerRecvMmsgPartialBatch) {
+  client_socket_ = createClientSocket(false);
+  const std::vector<std::string> payloads{"first", "second", "third"};
+  sendPackets(payloads);
+
+  std::vector<std::string> received;
+  EXPECT_CALL(listener_callbacks_, onData_(_))
+      .Times(payloads.size())
+      .WillRepeatedly(Invoke([&](const UdpRecvData& data) -> void {
+        validateRecvCallbackParams(data);
+        received.push_back(data.buffer_->toString());
+        if (received.size() == payloads.size()) {
+          dispatcher_->exit();
+        }
+      }));
+  EXPECT_CALL(listener_callbacks_, onWriteReady_(_));
+  // Inject mocked OsSysCalls implementation which forwards to the real recvmmsg().
+  Api::OsSysCallsImpl real_os_sys_calls;
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsMmsg()).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+  EXPECT_CALL(os_sys_calls, recvmmsg(_, _, 16, MSG_WAITFORONE, nullptr))
+      .WillOnce(Invoke(&real_os_sys_calls, &Api::OsSysCallsImpl::recvmmsg));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(payloads, received);
+}
+
+/**
+ * Tests that reading goes on after a batch of packets which fills recvmmsg().
+ */
+TEST_P(UdpListenerImplTest, UdpListenerRecvMmsgFullBatch) {
+  client_socket_ = createClientSocket(false);
+  std::vector<std::string> payloads;
+  for (uint32_t i = 0; i < 17; ++i) {
+    payloads.push_back(absl::StrCat("packet", i));
+  }
+  sendPackets(payloads);
+
+  std::vector<std::string> received;
+  EXPECT_CALL(listener_callbacks_, onData_(_))
+      .Times(payloads.size())
+      .WillRepeatedly(Invoke([&](const UdpRecvData& data) -> void {
+        validateRecvCallbackParams(data);
+        received.push_back(data.buffer_->toString());
+        if (received.size() == payloads.size()) {
+          dispatcher_->exit();
+        }
+      }));
+  EXPECT_CALL(listener_callbacks_, onWriteReady_(_));
+  // Inject mocked OsSysCalls implementation which forwards to the real recvmmsg().
+  Api::OsSysCallsImpl real_os_sys_calls;
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  EXPECT_CALL(os_sys_calls, supportsMmsg()).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls, recvmsg(_, _, _)).Times(0);
+  // The first call fills the batch and the second one reads the remaining packet.
+  EXPECT_CALL(os_sys_calls, recvmmsg(_, _, 16, MSG_WAITFORONE, nullptr))
+      .Times(2)
+      .WillRepeatedly(Invoke(&real_os_sys_calls, &Api::OsSysCallsImpl::recvmmsg));
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(payloads, received);
+}
+#endif
+
 /**
  * Tests UDP listener for sending datagrams to destination.
  *  1. Setup a udp listener and client socket
@@ -0,0 +1,93 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "envoy/api/v2/rds.pb.h"
+
+#include "common/router/config_impl.h"
+
+#include "test/mocks/server/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::NiceMock;
+using testing::ReturnRef;
+
+/**
+ * Build a virtual host with num_routes routes. Each route matches requests for a different
+ * service either by prefix or, when use_regex is set, by an equivalent regular expression,
+ * which cannot be indexed and therefore has to be evaluated one by one.
+ */
+envoy::api::v2::RouteConfiguration genRouteConfig(size_t num_routes, bool use_regex) {
+  envoy::api::v2::RouteConfiguration route_config;
+  auto* vhost = route_config.add_virtual_hosts();
+  vhost->set_name("default");
+  vhost->add_domains("*");
+  for (size_t i = 0; i < num_routes; i++) {
+    auto* route = vhost->add_routes();
+    const std::string service = absl::StrCat("/service_", i, "/");
+    if (use_regex) {
+      route->mutable_match()->mutable_safe_regex()->mutable_google_re2();
+      route->mutable_match()->mutable_safe_regex()->set_regex(absl::StrCat(service, ".*"));
+    } else if (i % 2 == 0) {
+      route->mutable_match()->set_prefix(service);
+    } else {
+      route->mutable_match()->set_path(absl::StrCat(service, "method"));
+    }
+    route->mutable_route()->set_cluster(absl::StrCat("cluster_", i));
+  }
+  return route_config;
+}
+
+/**
+ * Measure the route lookup for the last route of a virtual host with state.range(0) routes. The
+ * whole table has to be searched, which is the worst case for first-match evaluation.
+ */
+void routeLookup(benchmark::State& state, bool use_regex) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  const size_t num_routes = state.range(0);
+  ConfigImpl config(genRouteConfig(num_routes, use_regex), factory_context, false);
+  const size_t last = num_routes - 1;
+  Http::TestHeaderMapImpl headers{
+      {":authority", "www.lyft.com"},
+      {":path", absl::StrCat("/service_", last, "/method")},
+      {":method", "GET"},
+      {"x-forwarded-proto", "http"}};
+
+  for (auto _ : state) {
+    RouteConstSharedPtr route = config.route(headers, 0);
+    RELEASE_ASSERT(route != nullptr &&
+                       route->routeEntry()->clusterName() == absl::StrCat("cluster_", last),
+                   "");
+  }
+}
+
+void BM_RouteLookupIndexed(benchmark::State& state) { routeLookup(state, false); }
+BENCHMARK(BM_RouteLookupIndexed)->Arg(10)->Arg(100)->Arg(1000)->Arg(4000);
+
+void BM_RouteLookupRegex(benchmark::State& state) { routeLookup(state, true); }
+BENCHMARK(BM_RouteLookupRegex)->Arg(10)->Arg(100)->Arg(1000)->Arg(4000);
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
+
+// Boilerplate main(), which discovers benchmarks in the same file and runs them.
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
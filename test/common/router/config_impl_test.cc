@@ -786,6 +786,88 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Routes are looked up through an index over their path criteria. The first route in
+// configuration order must still win, whatever mix of path specifiers and extra conditions is used.
+TEST_F(RouteMatcherTest, FirstMatchAcrossPathSpecifiers) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: www
+    domains: ["*"]
+    routes:
+      - match:
+          prefix: "/api/"
+          headers:
+            - name: x-canary
+              present_match: true
+        route: { cluster: "canary" }
+      - match:
+          safe_regex:
+            google_re2: {}
+            regex: "/api/v1/users/\\d+"
+        route: { cluster: "user_regex" }
+      - match: { path: "/api/v1/users/list" }
+        route: { cluster: "list_exact" }
+      - match: { prefix: "/api/v1" }
+        route: { cluster: "api_v1" }
+      - match: { prefix: "/API/V2", case_sensitive: false }
+        route: { cluster: "api_v2" }
+      - match: { path: "/Exact", case_sensitive: false }
+        route: { cluster: "exact_ci" }
+      - match: { prefix: "/api/v1/users/list" }
+        route: { cluster: "unreachable" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  TestConfigImpl config(parseRouteConfigurationFromV2Yaml(yaml), factory_context_, true);
+  auto cluster = [&config](const std::string& path) {
+    return config.route(genHeaders("www.lyft.com", path, "GET"), 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("user_regex", cluster("/api/v1/users/12"));
+  {
+    Http::TestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v1/users/12", "GET");
+    headers.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  EXPECT_EQ("list_exact", cluster("/api/v1/users/list?page=2"));
+  EXPECT_EQ("api_v1", cluster("/api/v1/users/listing"));
+  EXPECT_EQ("api_v1", cluster("/api/v1"));
+  EXPECT_EQ("api_v2", cluster("/api/v2/x"));
+  EXPECT_EQ("exact_ci", cluster("/EXACT?q"));
+  EXPECT_EQ("default", cluster("/exactly"));
+  EXPECT_EQ("default", cluster("/api/v"));
+}
+
+// Requests without a :path, or to a virtual host without routes, do not reach the path index.
+TEST_F(RouteMatcherTest, NoPathOrNoRoutes) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: empty
+    domains: ["empty.com"]
+  - name: www
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  TestConfigImpl config(parseRouteConfigurationFromV2Yaml(yaml), factory_context_, true);
+  EXPECT_EQ(nullptr, config.route(genHeaders("empty.com", "/", "GET"), 0));
+  {
+    Http::TestHeaderMapImpl headers = genHeaders("empty.com", "/", "GET");
+    headers.remove(":path");
+    EXPECT_EQ(nullptr, config.route(headers, 0));
+  }
+  {
+    Http::TestHeaderMapImpl headers = genHeaders("www.lyft.com", "/", "GET");
+    headers.remove(":path");
+    EXPECT_EQ(nullptr, config.route(headers, 0));
+  }
+  EXPECT_EQ("default",
+            config.route(genHeaders("www.lyft.com", "/", "GET"), 0)->routeEntry()->clusterName());
+}
+
 // When deprecating regex: this test can be removed.
 TEST_F(RouteMatcherTest, DEPRECATED_FEATURE_TEST(TestRoutesWithInvalidRegexLegacy)) {
   std::string invalid_route = R"EOF(
@@ -0,0 +1,109 @@
+#include "common/router/path_match_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+PathMatchIndex::Candidates candidates(const PathMatchIndex& index, absl::string_view path) {
+  PathMatchIndex::Candidates result;
+  index.candidates(path, result);
+  return result;
+}
+
+TEST(PathMatchIndexTest, Empty) {
+  PathMatchIndex index;
+  EXPECT_THAT(candidates(index, "/"), IsEmpty());
+  EXPECT_THAT(candidates(index, ""), IsEmpty());
+}
+
+TEST(PathMatchIndexTest, Prefixes) {
+  PathMatchIndex index;
+  index.addPrefix("/foo/bar", true, 0);
+  index.addPrefix("/foo", true, 1);
+  index.addPrefix("/fob", true, 2);
+  index.addPrefix("/", true, 3);
+  index.addPrefix("", true, 4);
+  index.addPrefix("/foo", true, 5);
+
+  EXPECT_THAT(candidates(index, "/foo/bar/baz"), ElementsAre(0, 1, 3, 4, 5));
+  EXPECT_THAT(candidates(index, "/foo/ba"), ElementsAre(1, 3, 4, 5));
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(1, 3, 4, 5));
+  EXPECT_THAT(candidates(index, "/fob?x"), ElementsAre(2, 3, 4));
+  EXPECT_THAT(candidates(index, "/fo"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates(index, "/FOO"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates(index, ""), ElementsAre(4));
+}
+
+TEST(PathMatchIndexTest, PrefixesIgnoreCase) {
+  PathMatchIndex index;
+  index.addPrefix("/Foo", false, 0);
+  index.addPrefix("/foo/BAR", true, 1);
+  index.addPrefix("/FOO/bar", false, 2);
+
+  EXPECT_THAT(candidates(index, "/foo/bar"), ElementsAre(0, 2));
+  EXPECT_THAT(candidates(index, "/FOO/BAR"), ElementsAre(0, 2));
+  EXPECT_THAT(candidates(index, "/foo/BAR"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(candidates(index, "/fo"), IsEmpty());
+}
+
+// Exact paths are compared without the query string, prefixes with it.
+TEST(PathMatchIndexTest, Paths) {
+  PathMatchIndex index;
+  index.addPath("/foo", true, 0);
+  index.addPath("/Bar", false, 1);
+  index.addPrefix("/foo?a", true, 2);
+  index.addPath("/foo", true, 3);
+
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(0, 3));
+  EXPECT_THAT(candidates(index, "/foo?a=b"), ElementsAre(0, 2, 3));
+  EXPECT_THAT(candidates(index, "/foo/"), IsEmpty());
+  EXPECT_THAT(candidates(index, "/FOO"), IsEmpty());
+  EXPECT_THAT(candidates(index, "/bar?x"), ElementsAre(1));
+  EXPECT_THAT(candidates(index, "/BAR"), ElementsAre(1));
+}
+
+TEST(PathMatchIndexTest, UnindexedRoutesAreAlwaysCandidates) {
+  PathMatchIndex index;
+  index.addUnindexed(0);
+  index.addPrefix("/a", true, 1);
+  index.addUnindexed(2);
+  index.addPath("/a", true, 3);
+  index.addUnindexed(4);
+
+  EXPECT_THAT(candidates(index, "/a"), ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_THAT(candidates(index, "/b"), ElementsAre(0, 2, 4));
+}
+
+envoy::type::matcher::RegexMatcher googleReMatcher(const std::string& regex) {
+  envoy::type::matcher::RegexMatcher matcher;
+  matcher.mutable_google_re2();
+  matcher.set_regex(regex);
+  return matcher;
+}
+
+// Regexes are matched against the path without the query string, all in one pass.
+TEST(PathMatchIndexTest, Regexes) {
+  PathMatchIndex index;
+  index.addRegex(googleReMatcher("/users/\\d+"), 0);
+  index.addPrefix("/users", true, 1);
+  index.addRegex(googleReMatcher("/users/.*"), 2);
+  index.addUnindexed(3);
+  index.addRegex(googleReMatcher(".*/list"), 4);
+  index.compile();
+
+  EXPECT_THAT(candidates(index, "/users/12?x=1"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(candidates(index, "/users/list"), ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(candidates(index, "/users"), ElementsAre(1, 3));
+  EXPECT_THAT(candidates(index, "/groups/list"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates(index, "/groups?/list"), ElementsAre(3));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -3502,6 +3502,97 @@ TEST_F(RouterTest, UpstreamTimingSingleRequest) {
             std::chrono::milliseconds(32));
 }
 
+// Verify that the response time is fed to the latency monitor of the upstream host when the
+// cluster uses peak EWMA load balancing.
+TEST_F(RouterTest, PeakEwmaResponseTime) {
+  cm_.thread_local_cluster_.cluster_.info_->lb_type_ = Upstream::LoadBalancerType::PeakEwma;
+  NiceMock<Http::MockStreamEncoder> encoder;
+  Http::StreamDecoder* response_decoder = nullptr;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder& decoder, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        response_decoder = &decoder;
+        callbacks.onPoolReady(encoder, cm_.conn_pool_.host_, upstream_stream_info_);
+        return nullptr;
+      }));
+  expectResponseTimerCreate();
+
+  Http::TestHeaderMapImpl headers{};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, false);
+
+  test_time_.sleep(std::chrono::milliseconds(32));
+  Buffer::OwnedImpl data;
+  router_.decodeData(data, true);
+
+  Http::HeaderMapPtr response_headers(new Http::TestHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), false);
+  test_time_.sleep(std::chrono::milliseconds(43));
+
+  EXPECT_CALL(cm_.conn_pool_.host_->latency_monitor_,
+              putResponseTime(std::chrono::microseconds(75000), _));
+  response_decoder->decodeData(data, true);
+}
+
+// Verify that an upstream reset is fed to the latency monitor as a failure, with the time since
+// the request was sent.
+TEST_F(RouterTest, PeakEwmaReset) {
+  cm_.thread_local_cluster_.cluster_.info_->lb_type_ = Upstream::LoadBalancerType::PeakEwma;
+  NiceMock<Http::MockStreamEncoder> encoder;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolReady(encoder, cm_.conn_pool_.host_, upstream_stream_info_);
+        return nullptr;
+      }));
+  expectResponseTimerCreate();
+
+  Http::TestHeaderMapImpl headers{};
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+  test_time_.sleep(std::chrono::milliseconds(20));
+
+  EXPECT_CALL(cm_.conn_pool_.host_->latency_monitor_,
+              putFailure(std::chrono::microseconds(20000), _));
+  EXPECT_CALL(cm_.conn_pool_.host_->latency_monitor_, putResponseTime(_, _)).Times(0);
+  encoder.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+}
+
+// Verify that a connection failure is fed to the latency monitor as a failure at once, while a
+// circuit breaker overflow is not fed to it.
+TEST_F(RouterTest, PeakEwmaPoolFailure) {
+  cm_.thread_local_cluster_.cluster_.info_->lb_type_ = Upstream::LoadBalancerType::PeakEwma;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolFailure(Http::ConnectionPool::PoolFailureReason::ConnectionFailure,
+                                absl::string_view(), cm_.conn_pool_.host_);
+        return nullptr;
+      }));
+  EXPECT_CALL(cm_.conn_pool_.host_->latency_monitor_,
+              putFailure(std::chrono::microseconds(0), _));
+
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+}
+
+TEST_F(RouterTest, PeakEwmaOverflow) {
+  cm_.thread_local_cluster_.cluster_.info_->lb_type_ = Upstream::LoadBalancerType::PeakEwma;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolFailure(Http::ConnectionPool::PoolFailureReason::Overflow,
+                                absl::string_view(), cm_.conn_pool_.host_);
+        return nullptr;
+      }));
+  EXPECT_CALL(cm_.conn_pool_.host_->latency_monitor_, putFailure(_, _)).Times(0);
+
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+}
+
 // Verify that upstream timing information is set into the StreamInfo when a
 // retry occurs (and not before).
 TEST_F(RouterTest, UpstreamTimingRetry) {
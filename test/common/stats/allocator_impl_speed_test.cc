@@ -0,0 +1,77 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// NOLINT(namespace-envoy)
+
+#include <vector>
+
+#include "common/common/thread.h"
+#include "common/stats/allocator_impl.h"
+#include "common/stats/symbol_table_creator.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "benchmark/benchmark.h"
+
+// Measures threads incrementing the same counter, as workers do with the request totals of a
+// listener or cluster. Each iteration has every thread increment the counter 100,000 times.
+// state.range(0) is the number of counter shards, and state.range(1) the number of threads.
+static void BM_CounterIncContended(benchmark::State& state) {
+  const uint32_t counter_shards = state.range(0);
+  const uint32_t num_threads = state.range(1);
+  Envoy::Stats::SymbolTablePtr symbol_table =
+      Envoy::Stats::SymbolTableCreator::makeSymbolTable();
+  Envoy::Stats::AllocatorImpl alloc(*symbol_table, counter_shards);
+  Envoy::Stats::StatNamePool pool(*symbol_table);
+  Envoy::Stats::CounterSharedPtr counter =
+      alloc.makeCounter(pool.add("cluster.backend.upstream_rq_total"), "", {});
+
+  for (auto _ : state) {
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    for (uint32_t i = 0; i < num_threads; ++i) {
+      threads.push_back(Envoy::Thread::threadFactoryForTest().createThread([&counter]() {
+        for (uint32_t j = 0; j < 100000; ++j) {
+          counter->inc();
+        }
+      }));
+    }
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+  benchmark::DoNotOptimize(counter->value());
+}
+BENCHMARK(BM_CounterIncContended)
+    ->Args({0, 1})
+    ->Args({0, 4})
+    ->Args({0, 16})
+    ->Args({16, 1})
+    ->Args({16, 4})
+    ->Args({16, 16})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Measures reading a counter, which has to sum its shards.
+static void BM_CounterValue(benchmark::State& state) {
+  Envoy::Stats::SymbolTablePtr symbol_table =
+      Envoy::Stats::SymbolTableCreator::makeSymbolTable();
+  Envoy::Stats::AllocatorImpl alloc(*symbol_table, state.range(0));
+  Envoy::Stats::StatNamePool pool(*symbol_table);
+  Envoy::Stats::CounterSharedPtr counter =
+      alloc.makeCounter(pool.add("cluster.backend.upstream_rq_total"), "", {});
+  counter->inc();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(counter->value());
+  }
+}
+BENCHMARK(BM_CounterValue)->Arg(0)->Arg(16)->Arg(64);
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -1,9 +1,12 @@
 #include <string>
+#include <vector>
 
+#include "common/common/thread.h"
 #include "common/stats/allocator_impl.h"
 #include "common/stats/symbol_table_creator.h"
 
 #include "test/test_common/logging.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "gtest/gtest.h"
 
@@ -75,6 +78,102 @@ TEST_F(AllocatorImplTest, GaugesWithSameName) {
   EXPECT_EQ(0, g2->value());
 }
 
+TEST_F(AllocatorImplTest, GaugeLatchChanged) {
+  GaugeSharedPtr g = alloc_.makeGauge(makeStat("gauge.name"), "", std::vector<Tag>(),
+                                      Gauge::ImportMode::Accumulate);
+  // New gauges count as changed once.
+  EXPECT_TRUE(g->latchChanged());
+  EXPECT_FALSE(g->latchChanged());
+
+  g->inc();
+  EXPECT_TRUE(g->latchChanged());
+  EXPECT_FALSE(g->latchChanged());
+  g->dec();
+  EXPECT_TRUE(g->latchChanged());
+
+  // Setting a gauge to its current value is not a change.
+  g->set(0);
+  EXPECT_FALSE(g->latchChanged());
+  EXPECT_TRUE(g->used());
+  g->set(5);
+  EXPECT_TRUE(g->latchChanged());
+  EXPECT_FALSE(g->latchChanged());
+  EXPECT_EQ(Gauge::ImportMode::Accumulate, g->importMode());
+}
+
+TEST_F(AllocatorImplTest, ShardedCounters) {
+  AllocatorImpl alloc(*symbol_table_, 3);
+  StatName counter_name = makeStat("counter.name");
+  CounterSharedPtr c1 = alloc.makeCounter(counter_name, "", std::vector<Tag>());
+  CounterSharedPtr c2 = alloc.makeCounter(counter_name, "", std::vector<Tag>());
+  EXPECT_EQ(c1.get(), c2.get());
+  EXPECT_FALSE(c1->used());
+  EXPECT_EQ(0, c1->value());
+
+  c1->inc();
+  c2->add(4);
+  EXPECT_TRUE(c1->used());
+  EXPECT_EQ(5, c1->value());
+  EXPECT_EQ(5, c1->latch());
+  EXPECT_EQ(0, c1->latch());
+
+  // Resetting the value does not change the increments to latch.
+  c1->add(2);
+  c1->reset();
+  EXPECT_EQ(0, c1->value());
+  c1->inc();
+  EXPECT_EQ(1, c1->value());
+  EXPECT_EQ(3, c1->latch());
+
+  // The slot of a freed counter is zeroed before it is reused.
+  c1.reset();
+  c2.reset();
+  CounterSharedPtr c3 = alloc.makeCounter(makeStat("other.counter"), "", std::vector<Tag>());
+  EXPECT_EQ(0, c3->value());
+  EXPECT_EQ(0, c3->latch());
+}
+
+TEST_F(AllocatorImplTest, ShardedCountersManyThreads) {
+  AllocatorImpl alloc(*symbol_table_, 4);
+  CounterSharedPtr counter = alloc.makeCounter(makeStat("counter.name"), "", std::vector<Tag>());
+
+  // More threads than shards, so that some threads share a shard.
+  constexpr uint32_t num_threads = 10;
+  constexpr uint32_t num_increments = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&counter]() {
+      for (uint32_t j = 0; j < num_increments; ++j) {
+        counter->inc();
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  EXPECT_EQ(num_threads * num_increments, counter->value());
+  EXPECT_EQ(num_threads * num_increments, counter->latch());
+}
+
+TEST(CounterShardsTest, SlotsSpanChunks) {
+  CounterShards shards(5);
+  EXPECT_EQ(8, shards.numShards());
+
+  std::vector<uint32_t> slots;
+  for (uint32_t i = 0; i < CounterShards::SlotsPerChunk + 1; ++i) {
+    slots.push_back(shards.allocateSlot().value());
+    shards.add(slots.back(), i);
+  }
+  for (uint32_t i = 0; i < slots.size(); ++i) {
+    EXPECT_EQ(i, shards.sum(slots[i]));
+  }
+
+  shards.freeSlot(slots[1]);
+  EXPECT_EQ(slots[1], shards.allocateSlot().value());
+  EXPECT_EQ(0, shards.sum(slots[1]));
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -0,0 +1,60 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// NOLINT(namespace-envoy)
+
+#include "common/stats/histogram_buckets.h"
+
+#include "benchmark/benchmark.h"
+#include "circllhist.h"
+
+// Measures recording request latencies in microseconds into a circllhist, as the histograms of
+// each thread do by default.
+static void BM_CircllhistRecord(benchmark::State& state) {
+  histogram_t* histogram = hist_alloc();
+  uint64_t value = 0;
+  for (auto _ : state) {
+    hist_insert_intscale(histogram, value, 0, 1);
+    value = (value + 7919) % 1000000;
+  }
+  hist_free(histogram);
+}
+BENCHMARK(BM_CircllhistRecord);
+
+// Measures recording the same values into lock-free buckets.
+static void BM_HistogramBucketsRecord(benchmark::State& state) {
+  Envoy::Stats::HistogramBuckets buckets;
+  uint64_t value = 0;
+  for (auto _ : state) {
+    buckets.recordValue(value);
+    value = (value + 7919) % 1000000;
+  }
+}
+BENCHMARK(BM_HistogramBucketsRecord);
+
+// Measures merging the buckets into a histogram, as is done for each thread on every stats flush.
+static void BM_HistogramBucketsMerge(benchmark::State& state) {
+  Envoy::Stats::HistogramBuckets buckets;
+  histogram_t* histogram = hist_alloc();
+  uint64_t value = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (uint32_t i = 0; i < 1000; ++i) {
+      buckets.recordValue(value);
+      value = (value + 7919) % 1000000;
+    }
+    state.ResumeTiming();
+    buckets.mergeNew(histogram);
+  }
+  hist_free(histogram);
+}
+BENCHMARK(BM_HistogramBucketsMerge);
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+}
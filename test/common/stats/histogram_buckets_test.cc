@@ -0,0 +1,91 @@
+#include <vector>
+
+#include "common/common/thread.h"
+#include "common/stats/histogram_buckets.h"
+#include "common/stats/histogram_impl.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+class HistogramBucketsTest : public testing::Test {
+public:
+  HistogramBucketsTest() : expected_(hist_alloc()), merged_(hist_alloc()) {}
+
+  ~HistogramBucketsTest() override {
+    hist_free(expected_);
+    hist_free(merged_);
+  }
+
+  void recordValue(uint64_t value) {
+    buckets_.recordValue(value);
+    hist_insert_intscale(expected_, value, 0, 1);
+  }
+
+  void expectSameStatistics() {
+    HistogramStatisticsImpl expected_statistics(expected_);
+    HistogramStatisticsImpl merged_statistics(merged_);
+    EXPECT_EQ(expected_statistics.sampleCount(), merged_statistics.sampleCount());
+    EXPECT_EQ(expected_statistics.quantileSummary(), merged_statistics.quantileSummary());
+    EXPECT_EQ(expected_statistics.bucketSummary(), merged_statistics.bucketSummary());
+  }
+
+  HistogramBuckets buckets_;
+  histogram_t* expected_;
+  histogram_t* merged_;
+};
+
+// Values land in the same buckets as when inserted into a circllhist directly.
+TEST_F(HistogramBucketsTest, SameBucketsAsCircllhist) {
+  for (uint64_t value : std::vector<uint64_t>{0, 0, 1, 7, 9, 10, 15, 99, 100, 101, 123, 999, 1000,
+                                              1999, 12345, 250000, 3600000, 1ULL << 40,
+                                              (1ULL << 62) + 12345}) {
+    recordValue(value);
+  }
+  buckets_.mergeNew(merged_);
+  expectSameStatistics();
+}
+
+TEST_F(HistogramBucketsTest, MergeNewValuesOnly) {
+  recordValue(5);
+  recordValue(50);
+  buckets_.mergeNew(merged_);
+  expectSameStatistics();
+
+  // Merging again adds nothing.
+  buckets_.mergeNew(merged_);
+  expectSameStatistics();
+
+  hist_clear(expected_);
+  hist_clear(merged_);
+  recordValue(0);
+  recordValue(50);
+  recordValue(500);
+  buckets_.mergeNew(merged_);
+  expectSameStatistics();
+}
+
+// Values recorded while merging from another thread are merged exactly once.
+TEST_F(HistogramBucketsTest, MergeWhileRecording) {
+  const uint64_t num_values = 100000;
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([this, num_values]() {
+    for (uint64_t i = 0; i < num_values; ++i) {
+      buckets_.recordValue(i % 2000);
+    }
+  });
+  for (uint32_t i = 0; i < 100; ++i) {
+    buckets_.mergeNew(merged_);
+  }
+  thread->join();
+  buckets_.mergeNew(merged_);
+
+  EXPECT_EQ(num_values, hist_sample_count(merged_));
+}
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
@@ -21,13 +21,15 @@ namespace Stats {
 // of SymbolTable, which we'll do with a test parameterized on this enum.
 //
 // Note that some of the tests cover behavior that is specific to the real
-// SymbolTableImpl, and thus early-exit when the param is Fake.
+// SymbolTableImpl, and thus early-exit when the param is Fake. The real
+// implementation is also tested split into shards.
 //
 // TODO(jmarantz): un-parameterize this test once SymbolTable is fully deployed
 // and FakeSymbolTableImpl can be deleted.
 enum class SymbolTableType {
   Real,
   Fake,
+  Sharded,
 };
 
 class StatNameTest : public testing::TestWithParam<SymbolTableType> {
@@ -40,12 +42,18 @@ protected:
       table_ = std::move(table);
       break;
     }
-    case SymbolTableType::Fake:
+    case SymbolTableType::Fake: {
       auto table = std::make_unique<FakeSymbolTableImpl>();
       fake_symbol_table_ = table.get();
       table_ = std::move(table);
       break;
     }
+    case SymbolTableType::Sharded:
+      auto table = std::make_unique<SymbolTableImpl>(8);
+      real_symbol_table_ = table.get();
+      table_ = std::move(table);
+      break;
+    }
     pool_ = std::make_unique<StatNamePool>(*table_);
   }
 
@@ -63,6 +71,7 @@ protected:
     return real_symbol_table_->decodeSymbolVec(symbol_vec);
   }
   Symbol monotonicCounter() { return real_symbol_table_->monotonicCounter(); }
+  uint32_t tokenShard(absl::string_view token) { return real_symbol_table_->tokenShard(token); }
   std::string encodeDecode(absl::string_view stat_name) {
     return table_->toString(makeStat(stat_name));
   }
@@ -76,7 +85,8 @@ protected:
 };
 
 INSTANTIATE_TEST_SUITE_P(StatNameTest, StatNameTest,
-                         testing::ValuesIn({SymbolTableType::Real, SymbolTableType::Fake}));
+                         testing::ValuesIn({SymbolTableType::Real, SymbolTableType::Fake,
+                                            SymbolTableType::Sharded}));
 
 TEST_P(StatNameTest, AllocFree) { encodeDecode("hello.world"); }
 
@@ -182,7 +192,9 @@ TEST_P(StatNameTest, TestSameValueOnPartialFree) {
 }
 
 TEST_P(StatNameTest, FreePoolTest) {
-  if (GetParam() == SymbolTableType::Fake) {
+  // Each shard has a free pool of its own, so different strings do not
+  // necessarily recycle the same symbols when sharded.
+  if (GetParam() != SymbolTableType::Real) {
     return;
   }
 
@@ -220,6 +232,33 @@ TEST_P(StatNameTest, FreePoolTest) {
   EXPECT_EQ(table_->numSymbols(), 6);
 }
 
+TEST_P(StatNameTest, ShardedSymbols) {
+  if (GetParam() != SymbolTableType::Sharded) {
+    return;
+  }
+
+  // The symbols of each token carry its shard in their low-order bits.
+  const std::vector<std::string> tokens = {"cluster", "backend", "upstream_rq_total", "a", "b",
+                                           "c",       "d",       "e",                 "f", "g"};
+  StatName stat_name = makeStat(absl::StrJoin(tokens, "."));
+  EXPECT_EQ(absl::StrJoin(tokens, "."), table_->toString(stat_name));
+  const SymbolVec symbols = getSymbols(stat_name);
+  ASSERT_EQ(tokens.size(), symbols.size());
+  for (uint32_t i = 0; i < tokens.size(); ++i) {
+    EXPECT_EQ(tokenShard(tokens[i]), symbols[i] % 8) << tokens[i];
+  }
+  EXPECT_EQ(tokens.size(), table_->numSymbols());
+
+  // Freed symbols are reused within their shard, so cycling through new tokens
+  // takes at most one more symbol per shard.
+  const Symbol counter = monotonicCounter();
+  for (int i = 0; i < 100; ++i) {
+    StatNameStorage storage(absl::StrCat("token", i), *table_);
+    storage.free(*table_);
+  }
+  EXPECT_LE(monotonicCounter(), counter + 8);
+}
+
 TEST_P(StatNameTest, TestShrinkingExpectation) {
   // We expect that as we free stat names, the memory used to store those underlying symbols will
   // be freed.
@@ -588,6 +627,15 @@ TEST_P(StatNameTest, SupportsAbslHash) {
   }));
 }
 
+TEST(SymbolTableTest, NumShards) {
+  EXPECT_EQ(1, SymbolTableImpl().numShards());
+  EXPECT_EQ(1, SymbolTableImpl(0).numShards());
+  EXPECT_EQ(1, SymbolTableImpl(1).numShards());
+  EXPECT_EQ(8, SymbolTableImpl(5).numShards());
+  EXPECT_EQ(16, SymbolTableImpl(16).numShards());
+  EXPECT_EQ(SymbolTableImpl::MaxShards, SymbolTableImpl(1000).numShards());
+}
+
 // Tests the memory savings realized from using symbol tables with 1k
 // clusters. This test shows the memory drops from almost 8M to less than
 // 2M. Note that only SymbolTableImpl is tested for memory consumption,
@@ -9,6 +9,7 @@
 
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "benchmark/benchmark.h"
 
@@ -54,6 +55,41 @@ static void BM_CreateRace(benchmark::State& state) {
 }
 BENCHMARK(BM_CreateRace);
 
+// Measures threads encoding and freeing names that differ in some of their tokens, as workers do
+// when creating stats with dynamic names, e.g. from CDS cluster names or header values. Each
+// iteration has every thread encode and free 10,000 names. state.range(0) is the number of shards
+// of the symbol table, and state.range(1) the number of threads.
+static void BM_EncodeFreeContended(benchmark::State& state) {
+  const uint32_t num_shards = state.range(0);
+  const uint32_t num_threads = state.range(1);
+  Envoy::Stats::SymbolTableImpl table(num_shards);
+
+  for (auto _ : state) {
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    for (uint32_t i = 0; i < num_threads; ++i) {
+      threads.push_back(Envoy::Thread::threadFactoryForTest().createThread([&table, i]() {
+        for (uint32_t j = 0; j < 10000; ++j) {
+          Envoy::Stats::StatNameStorage name(
+              absl::StrCat("cluster.backend_", j % 100, ".upstream_rq_", i, ".total"), table);
+          name.free(table);
+        }
+      }));
+    }
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+}
+BENCHMARK(BM_EncodeFreeContended)
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->Args({1, 16})
+    ->Args({16, 1})
+    ->Args({16, 4})
+    ->Args({16, 16})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 int main(int argc, char** argv) {
   Envoy::Thread::MutexBasicLockable lock;
   Envoy::Logger::Context logger_context(spdlog::level::warn,
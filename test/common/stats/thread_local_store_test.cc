@@ -81,7 +81,7 @@ public:
   HistogramTest() : symbol_table_(SymbolTableCreator::makeSymbolTable()), alloc_(*symbol_table_) {}
 
   void SetUp() override {
-    store_ = std::make_unique<ThreadLocalStoreImpl>(alloc_);
+    store_ = std::make_unique<ThreadLocalStoreImpl>(alloc_, lock_free_histograms_);
     store_->addSink(sink_);
     store_->initializeThreading(main_thread_dispatcher_, tls_);
   }
@@ -171,12 +171,18 @@ public:
   NiceMock<ThreadLocal::MockInstance> tls_;
   AllocatorImpl alloc_;
   MockSink sink_;
+  bool lock_free_histograms_{};
   std::unique_ptr<ThreadLocalStoreImpl> store_;
   InSequence s;
   std::vector<uint64_t> h1_cumulative_values_, h2_cumulative_values_, h1_interval_values_,
       h2_interval_values_;
 };
 
+class LockFreeHistogramTest : public HistogramTest {
+public:
+  LockFreeHistogramTest() { lock_free_histograms_ = true; }
+};
+
 TEST_F(StatsThreadLocalStoreTest, NoTls) {
   InSequence s;
 
@@ -1042,6 +1048,28 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+TEST_F(LockFreeHistogramTest, MultiHistogramMultipleMerges) {
+  Histogram& h1 = store_->histogram("h1");
+  Histogram& h2 = store_->histogram("h2");
+
+  // The histograms are merged without a post to the threads recording to them.
+  EXPECT_CALL(tls_, runOnAllThreads(_, _)).Times(0);
+
+  expectCallAndAccumulate(h1, 0);
+  expectCallAndAccumulate(h1, 7);
+  expectCallAndAccumulate(h1, 43);
+  expectCallAndAccumulate(h2, 415);
+  EXPECT_EQ(2, validateMerge());
+
+  // Only the values recorded since the previous merge are in the interval statistics.
+  expectCallAndAccumulate(h1, 2201);
+  expectCallAndAccumulate(h2, 1234567);
+  expectCallAndAccumulate(h2, 1234567);
+  EXPECT_EQ(2, validateMerge());
+
+  EXPECT_EQ(2, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopePtr scope1 = store_->createScope("scope1.");
 
@@ -438,6 +438,73 @@ TEST_F(TcpConnPoolImplTest, MultipleRequestAndResponse) {
   dispatcher_.clearDeferredDeleteList();
 }
 
+/**
+ * Test that spare connections are replaced as soon as requests take them.
+ */
+TEST_F(TcpConnPoolImplTest, SpareConnections) {
+  ActiveTestConn c1(*this, 0, ActiveTestConn::Type::CreateConnection);
+  EXPECT_CALL(conn_pool_, onConnReleasedForTest());
+  c1.releaseConn();
+
+  // Taking the idle connection opens a spare one in its place.
+  ON_CALL(*cluster_, spareConnectionsPerHost()).WillByDefault(Return(1));
+  conn_pool_.expectConnCreate();
+  ActiveTestConn c2(*this, 0, ActiveTestConn::Type::Immediate);
+  EXPECT_EQ(1U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_total_.value());
+
+  // Once connected, the spare connection is handed to the next request without waiting.
+  EXPECT_CALL(*conn_pool_.test_conns_[1].connect_timer_, disableTimer());
+  conn_pool_.test_conns_[1].connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  conn_pool_.expectConnCreate();
+  ActiveTestConn c3(*this, 1, ActiveTestConn::Type::Immediate);
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_EQ(3U, cluster_->stats_.upstream_cx_total_.value());
+
+  // Cause the connections to go away.
+  EXPECT_CALL(conn_pool_, onConnReleasedForTest()).Times(2);
+  c2.releaseConn();
+  c3.releaseConn();
+  EXPECT_CALL(conn_pool_, onConnDestroyedForTest()).Times(3);
+  conn_pool_.test_conns_[2].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  conn_pool_.test_conns_[1].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  conn_pool_.test_conns_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that a new pool opens its spare connections before the first request, and that a spare
+ * connection closed by the upstream is replaced right away while a failed connection attempt is
+ * not.
+ */
+TEST_F(TcpConnPoolImplTest, SpareConnectionsWarmUpAndReplace) {
+  ON_CALL(*cluster_, spareConnectionsPerHost()).WillByDefault(Return(1));
+  // Mock timers are handed out newest first, and the warm up timer is created last.
+  NiceMock<Event::MockTimer>* warm_up_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*warm_up_timer, enableTimer(std::chrono::milliseconds(0), _));
+  ConnPoolImplForTest conn_pool(dispatcher_, cluster_,
+                                new NiceMock<Event::MockTimer>(&dispatcher_));
+
+  conn_pool.expectConnCreate();
+  warm_up_timer->invokeCallback();
+  EXPECT_EQ(1U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_CALL(*conn_pool.test_conns_[0].connect_timer_, disableTimer());
+  conn_pool.test_conns_[0].connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  EXPECT_CALL(conn_pool, onConnDestroyedForTest());
+  conn_pool.expectConnCreate();
+  conn_pool.test_conns_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+
+  // The closed connection is gone from test_conns_, so the replacement is the first one now.
+  EXPECT_CALL(conn_pool, onConnDestroyedForTest());
+  conn_pool.test_conns_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+  EXPECT_EQ(2U, cluster_->stats_.upstream_cx_spare_total_.value());
+  EXPECT_EQ(1U, cluster_->stats_.upstream_cx_connect_fail_.value());
+}
+
 /**
  * Tests ConnectionState assignment, lookup and destruction.
  */
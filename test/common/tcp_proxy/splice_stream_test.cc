@@ -0,0 +1,183 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+#include "common/tcp_proxy/splice_stream.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+class SpliceStreamTest : public testing::Test {
+public:
+  void SetUp() override {
+    if (!SpliceStream::isSupported()) {
+      return;
+    }
+    // The stream moves data from src_[1] to dst_[0]; the test talks to src_[0] and dst_[1].
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, src_));
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, dst_));
+    for (int fd : {src_[0], src_[1], dst_[0], dst_[1]}) {
+      ASSERT_EQ(0, fcntl(fd, F_SETFL, O_NONBLOCK));
+    }
+    stream_ = SpliceStream::create(src_[1], dst_[0], 0);
+    ASSERT_NE(nullptr, stream_);
+  }
+
+  void TearDown() override {
+    stream_.reset();
+    if (SpliceStream::isSupported()) {
+      for (int fd : {src_[0], src_[1], dst_[0], dst_[1]}) {
+        close(fd);
+      }
+    }
+  }
+
+  void writeSource(const std::string& data) {
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), write(src_[0], data.data(), data.size()));
+  }
+
+  std::string readDestination() {
+    std::string result;
+    char buf[4096];
+    ssize_t rc;
+    while ((rc = read(dst_[1], buf, sizeof(buf))) > 0) {
+      result.append(buf, rc);
+    }
+    return result;
+  }
+
+  int src_[2];
+  int dst_[2];
+  SpliceStreamPtr stream_;
+};
+
+TEST_F(SpliceStreamTest, MovesData) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  writeSource("hello");
+  SpliceStream::Result result = stream_->transfer(true);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_EQ(5, result.bytes_read_);
+  EXPECT_EQ(5, result.bytes_written_);
+  EXPECT_EQ("hello", readDestination());
+
+  // Nothing to read.
+  result = stream_->transfer(true);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_EQ(0, result.bytes_read_);
+  EXPECT_EQ(0, result.bytes_written_);
+}
+
+TEST_F(SpliceStreamTest, PendingDataGoesFirst) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  Buffer::OwnedImpl pending("before");
+  stream_->addPending(pending);
+  EXPECT_EQ(0, pending.length());
+  writeSource("after");
+
+  SpliceStream::Result result = stream_->transfer(true);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_EQ(5, result.bytes_read_);
+  EXPECT_EQ(11, result.bytes_written_);
+  EXPECT_EQ("beforeafter", readDestination());
+}
+
+TEST_F(SpliceStreamTest, EndStream) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  writeSource("bye");
+  ASSERT_EQ(0, shutdown(src_[0], SHUT_WR));
+  SpliceStream::Result result = stream_->transfer(true);
+  EXPECT_EQ(SpliceStream::Status::EndStream, result.status_);
+  EXPECT_EQ(3, result.bytes_written_);
+  EXPECT_TRUE(stream_->endStream());
+  EXPECT_EQ("bye", readDestination());
+  // The half close is passed on to the destination.
+  char c;
+  EXPECT_EQ(0, read(dst_[1], &c, 1));
+}
+
+// Without reading from the source, only the data already read is written.
+TEST_F(SpliceStreamTest, SourceNotRead) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  Buffer::OwnedImpl pending("first");
+  stream_->addPending(pending);
+  writeSource("later");
+  SpliceStream::Result result = stream_->transfer(false);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_EQ(0, result.bytes_read_);
+  EXPECT_EQ(5, result.bytes_written_);
+  EXPECT_EQ("first", readDestination());
+
+  result = stream_->transfer(true);
+  EXPECT_EQ(5, result.bytes_read_);
+  EXPECT_EQ("later", readDestination());
+}
+
+// Once the destination stops draining, the stream stops reading from the source when the pipe is
+// full and resumes where it left off.
+TEST_F(SpliceStreamTest, BlockedDestination) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  const std::string chunk(16 * 1024, 'a');
+  uint64_t total_written = 0;
+  uint64_t total_read = 0;
+  SpliceStream::Result result;
+  // Fill the destination socket buffer and the pipe.
+  do {
+    ssize_t rc = write(src_[0], chunk.data(), chunk.size());
+    result = stream_->transfer(true);
+    total_read += result.bytes_read_;
+    total_written += result.bytes_written_;
+    if (rc < 0) {
+      break;
+    }
+  } while (true);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_GT(total_read, total_written);
+
+  std::string received = readDestination();
+  do {
+    result = stream_->transfer(true);
+    total_read += result.bytes_read_;
+    total_written += result.bytes_written_;
+    received += readDestination();
+  } while (result.bytes_read_ > 0 || result.bytes_written_ > 0);
+  EXPECT_EQ(SpliceStream::Status::Open, result.status_);
+  EXPECT_EQ(total_read, total_written);
+  EXPECT_EQ(total_written, received.size());
+}
+
+TEST_F(SpliceStreamTest, Error) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  // Writing to a socket whose peer is gone fails with EPIPE.
+  close(dst_[1]);
+  dst_[1] = socket(AF_UNIX, SOCK_STREAM, 0);
+  writeSource("lost");
+  EXPECT_EQ(SpliceStream::Status::Error, stream_->transfer(true).status_);
+}
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
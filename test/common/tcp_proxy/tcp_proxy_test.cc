@@ -1,3 +1,7 @@
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -7,6 +11,7 @@
 #include "common/buffer/buffer_impl.h"
 #include "common/config/filter_json.h"
 #include "common/network/address_impl.h"
+#include "common/network/io_socket_handle_impl.h"
 #include "common/network/transport_socket_options_impl.h"
 #include "common/network/upstream_server_name.h"
 #include "common/router/metadatamatchcriteria_impl.h"
@@ -528,6 +533,133 @@ TEST_F(TcpProxyTest, HalfCloseProxy) {
   upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Tests that with use_splice data moves between the sockets directly, is accounted for, follows
+// the read state of the connections, and that half closes are proxied.
+TEST_F(TcpProxyTest, SpliceProxy) {
+  if (!SpliceStream::isSupported()) {
+    return;
+  }
+
+  envoy::config::filter::network::tcp_proxy::v2::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  setup(1, config);
+
+  // The first socket of each pair backs the proxied connection, the second one is its peer.
+  int downstream_fds[2];
+  int upstream_fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, downstream_fds));
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, upstream_fds));
+  for (int fd : {downstream_fds[0], downstream_fds[1], upstream_fds[0], upstream_fds[1]}) {
+    ASSERT_EQ(0, fcntl(fd, F_SETFL, O_NONBLOCK));
+  }
+  Network::IoSocketHandleImpl downstream_io(downstream_fds[0]);
+  Network::IoSocketHandleImpl downstream_peer(downstream_fds[1]);
+  Network::IoSocketHandleImpl upstream_io(upstream_fds[0]);
+  Network::IoSocketHandleImpl upstream_peer(upstream_fds[1]);
+  ON_CALL(filter_callbacks_.connection_, ioHandle()).WillByDefault(ReturnRef(downstream_io));
+  ON_CALL(*upstream_connections_.at(0), ioHandle()).WillByDefault(ReturnRef(upstream_io));
+
+  auto peer_write = [](int fd, const std::string& data) {
+    EXPECT_EQ(static_cast<ssize_t>(data.size()), write(fd, data.data(), data.size()));
+  };
+  auto peer_read = [](int fd) {
+    char buf[64];
+    const ssize_t rc = read(fd, buf, sizeof(buf));
+    return rc > 0 ? std::string(buf, rc) : std::string();
+  };
+
+  auto peer_read_eof = [](int fd) {
+    char c;
+    return read(fd, &c, 1) == 0;
+  };
+  ON_CALL(filter_callbacks_.connection_, readEnabled()).WillByDefault(Return(true));
+  ON_CALL(*upstream_connections_.at(0), readEnabled()).WillByDefault(Return(true));
+
+  // Data the connections buffered before splicing started is sent first: what was written to a
+  // connection, then what its peer connection had read.
+  Network::Connection::SocketEventCb downstream_cb;
+  Network::Connection::SocketEventCb upstream_cb;
+  EXPECT_CALL(filter_callbacks_.connection_, takeOverSocketEvents(_, _, _))
+      .WillOnce(Invoke([&](Network::Connection::SocketEventCb cb, Buffer::Instance& read_data,
+                           Buffer::Instance& write_data) {
+        downstream_cb = cb;
+        read_data.add("hello");
+        write_data.add("early ");
+      }));
+  EXPECT_CALL(*upstream_connections_.at(0), takeOverSocketEvents(_, _, _))
+      .WillOnce(Invoke([&](Network::Connection::SocketEventCb cb, Buffer::Instance& read_data,
+                           Buffer::Instance& write_data) {
+        upstream_cb = cb;
+        read_data.add("reply");
+        write_data.add("hi ");
+      }));
+  EXPECT_CALL(filter_callbacks_.connection_, close(_)).Times(0);
+  raiseEventUpstreamConnected(0);
+  ASSERT_NE(nullptr, downstream_cb);
+  ASSERT_NE(nullptr, upstream_cb);
+
+  // The connections are no longer written to.
+  EXPECT_CALL(filter_callbacks_.connection_, write(_, _)).Times(0);
+  EXPECT_CALL(*upstream_connections_.at(0), write(_, _)).Times(0);
+  downstream_cb(Event::FileReadyType::Write);
+  EXPECT_EQ("hi hello", peer_read(upstream_fds[1]));
+  EXPECT_EQ("early reply", peer_read(downstream_fds[1]));
+
+  peer_write(downstream_fds[1], "more");
+  downstream_cb(Event::FileReadyType::Read);
+  EXPECT_EQ("more", peer_read(upstream_fds[1]));
+
+  peer_write(upstream_fds[1], "world");
+  upstream_cb(Event::FileReadyType::Read);
+  EXPECT_EQ("world", peer_read(downstream_fds[1]));
+
+  EXPECT_EQ(9, filter_->getStreamInfo().bytesReceived());
+  EXPECT_EQ(16, filter_->getStreamInfo().bytesSent());
+
+  // A read disabled connection is not spliced from.
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(true))
+      .WillOnce(Invoke([&](bool) {
+        ON_CALL(*upstream_connections_.at(0), readEnabled()).WillByDefault(Return(false));
+      }));
+  filter_callbacks_.connection_.runHighWatermarkCallbacks();
+  peer_write(upstream_fds[1], "later");
+  upstream_cb(Event::FileReadyType::Write);
+  EXPECT_EQ("", peer_read(downstream_fds[1]));
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(false)).WillOnce(Invoke([&](bool) {
+    ON_CALL(*upstream_connections_.at(0), readEnabled()).WillByDefault(Return(true));
+  }));
+  filter_callbacks_.connection_.runLowWatermarkCallbacks();
+  upstream_cb(Event::FileReadyType::Read);
+  EXPECT_EQ("later", peer_read(downstream_fds[1]));
+
+  // Half closes are passed on to the peer socket.
+  ASSERT_EQ(0, shutdown(downstream_fds[1], SHUT_WR));
+  downstream_cb(Event::FileReadyType::Read);
+  EXPECT_TRUE(peer_read_eof(upstream_fds[1]));
+
+  // Once both directions are done, the connections are closed.
+  ASSERT_EQ(0, shutdown(upstream_fds[1], SHUT_WR));
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::FlushWrite));
+  upstream_cb(Event::FileReadyType::Read);
+  EXPECT_TRUE(peer_read_eof(downstream_fds[1]));
+}
+
+// Tests that use_splice falls back to regular proxying for TLS connections.
+TEST_F(TcpProxyTest, SpliceSkippedForTls) {
+  envoy::config::filter::network::tcp_proxy::v2::TcpProxy config = defaultConfig();
+  config.set_use_splice(true);
+  auto connection_info = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  EXPECT_CALL(filter_callbacks_.connection_, ssl()).WillRepeatedly(Return(connection_info));
+  setup(1, config);
+
+  EXPECT_CALL(filter_callbacks_.connection_, takeOverSocketEvents(_, _, _)).Times(0);
+  raiseEventUpstreamConnected(0);
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+}
+
 // Test that downstream is closed after an upstream LocalClose.
 TEST_F(TcpProxyTest, UpstreamLocalDisconnect) {
   setup(1);
@@ -234,7 +234,8 @@ public:
         *api_, http_context_);
   }
 
-  void createWithLocalClusterUpdate(const bool enable_merge_window = true) {
+  void createWithLocalClusterUpdate(const bool enable_merge_window = true,
+                                    const bool merge_membership_updates = false) {
     std::string yaml = R"EOF(
   static_resources:
     clusters:
@@ -260,6 +261,9 @@ public:
   )EOF";
 
     yaml += enable_merge_window ? merge_window_enabled : merge_window_disabled;
+    if (merge_membership_updates) {
+      yaml += "      merge_membership_updates: true\n";
+    }
 
     const auto& bootstrap = parseBootstrapFromV2Yaml(yaml);
 
@@ -343,6 +347,105 @@ TEST_F(ClusterManagerImplTest, MultipleProtocolClusterFail) {
       "'protocol_selection' values");
 }
 
+TEST_F(ClusterManagerImplTest, PoolWarmingWithoutSpareConnectionsFail) {
+  const std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      lb_policy: ROUND_ROBIN
+      pool_warming: TCP_POOL
+  )EOF";
+  EXPECT_THROW_WITH_MESSAGE(create(parseBootstrapFromV2Yaml(yaml)), EnvoyException,
+                            "cluster cluster_1: pool_warming requires spare_connections_per_host");
+}
+
+TEST_F(ClusterManagerImplTest, Http1PoolWarmingWithHttp2Fail) {
+  const std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      lb_policy: ROUND_ROBIN
+      http2_protocol_options: {}
+      spare_connections_per_host: 1
+      pool_warming: HTTP1_POOL
+  )EOF";
+  EXPECT_THROW_WITH_MESSAGE(
+      create(parseBootstrapFromV2Yaml(yaml)), EnvoyException,
+      "cluster cluster_1: pool_warming HTTP1_POOL is not supported by clusters that only use "
+      "HTTP2");
+}
+
+// With pool_warming, the pool of that type is created for healthy hosts as they are added so that
+// it can open its spare connections before the first request.
+TEST_F(ClusterManagerImplTest, PoolWarming) {
+  const std::string yaml = R"EOF(
+static_resources:
+  clusters:
+  - name: http_cluster
+    connect_timeout: 0.250s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    spare_connections_per_host: 2
+    pool_warming: HTTP1_POOL
+    load_assignment:
+      endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11001
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.2
+                  port_value: 11001
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.3
+                  port_value: 11001
+            health_status: UNHEALTHY
+  - name: tcp_cluster
+    connect_timeout: 0.250s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    spare_connections_per_host: 1
+    pool_warming: TCP_POOL
+    load_assignment:
+      endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11002
+  )EOF";
+
+  // Only the healthy hosts get a pool, and only of the type that the cluster warms.
+  EXPECT_CALL(factory_, allocateConnPool_(_, _))
+      .Times(2)
+      .WillRepeatedly(ReturnNew<Http::ConnectionPool::MockInstance>());
+  Tcp::ConnectionPool::MockInstance* tcp_cp = new Tcp::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateTcpConnPool_(_)).WillOnce(Return(tcp_cp));
+  create(parseBootstrapFromV2Yaml(yaml));
+
+  // Requests and connections use the pools created up front.
+  Http::ConnectionPool::Instance* cp1 = cluster_manager_->httpConnPoolForCluster(
+      "http_cluster", ResourcePriority::Default, Http::Protocol::Http11, nullptr);
+  Http::ConnectionPool::Instance* cp2 = cluster_manager_->httpConnPoolForCluster(
+      "http_cluster", ResourcePriority::Default, Http::Protocol::Http11, nullptr);
+  EXPECT_NE(nullptr, cp1);
+  EXPECT_NE(nullptr, cp2);
+  EXPECT_NE(cp1, cp2);
+  EXPECT_EQ(tcp_cp, cluster_manager_->tcpConnPoolForCluster(
+                        "tcp_cluster", ResourcePriority::Default, nullptr, nullptr));
+
+  factory_.tls_.shutdownThread();
+}
+
 TEST_F(ClusterManagerImplTest, MultipleHealthCheckFail) {
   const std::string yaml = R"EOF(
  static_resources:
@@ -1989,6 +2092,162 @@ TEST_F(ClusterManagerImplTest, DynamicHostRemove) {
   factory_.tls_.shutdownThread();
 }
 
+// Hosts that other workers already hold max_http2_connections_per_host HTTP/2 connections to are
+// skipped unless this worker already has an HTTP/2 connection to them.
+TEST_F(ClusterManagerImplTest, MaxHttp2ConnectionsPerHost) {
+  const std::string yaml = R"EOF(
+static_resources:
+  clusters:
+  - name: cluster_1
+    connect_timeout: 0.250s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    http2_protocol_options: {}
+    max_http2_connections_per_host: 1
+    load_assignment:
+      endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11001
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.2
+                  port_value: 11001
+  )EOF";
+
+  create(parseBootstrapFromV2Yaml(yaml));
+  auto counter = [this](const std::string& name) {
+    return factory_.stats_.counter("cluster." + name).value();
+  };
+  const HostVector& hosts =
+      cluster_manager_->get("cluster_1")->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(2, hosts.size());
+  hosts[0]->stats().cx_http2_active_.inc();
+  // Connections of other protocols do not count towards the limit.
+  hosts[1]->stats().cx_active_.inc();
+
+  // An HTTP/1.1 pool for the host at the limit does not make it usable for HTTP/2.
+  Http::ConnectionPool::MockInstance* http1_cp = new Http::ConnectionPool::MockInstance();
+  Http::ConnectionPool::MockInstance* http1_cp2 = new Http::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateConnPool_(_, _))
+      .WillOnce(Return(http1_cp))
+      .WillOnce(Return(http1_cp2));
+  cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                           Http::Protocol::Http11, nullptr);
+  cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                           Http::Protocol::Http11, nullptr);
+
+  // Whichever host round robin starts with, at least one of the two requests first gets the host
+  // at the limit and has to choose again.
+  Http::ConnectionPool::MockInstance* cp = new Http::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateConnPool_(HostConstSharedPtr(hosts[1]), _)).WillOnce(Return(cp));
+  EXPECT_EQ(cp, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                         Http::Protocol::Http2, nullptr));
+  EXPECT_EQ(cp, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                         Http::Protocol::Http2, nullptr));
+  EXPECT_LE(1UL, counter("cluster_1.upstream_cx_http2_per_host_reselect"));
+
+  // Once every host is at the limit, the host this worker has an HTTP/2 connection to is still
+  // chosen.
+  ON_CALL(*cp, hasUsableConnection()).WillByDefault(Return(true));
+  hosts[1]->stats().cx_http2_active_.inc();
+  EXPECT_EQ(cp, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                         Http::Protocol::Http2, nullptr));
+  EXPECT_EQ(0UL, counter("cluster_1.upstream_cx_http2_per_host_overflow"));
+
+  // Once its connection has closed, the pool no longer makes the host at the limit usable, and the
+  // other host is chosen instead.
+  ON_CALL(*cp, hasUsableConnection()).WillByDefault(Return(false));
+  hosts[0]->stats().cx_http2_active_.dec();
+  const uint64_t reselections = counter("cluster_1.upstream_cx_http2_per_host_reselect");
+  Http::ConnectionPool::MockInstance* cp2 = new Http::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateConnPool_(HostConstSharedPtr(hosts[0]), _)).WillOnce(Return(cp2));
+  EXPECT_EQ(cp2, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                          Http::Protocol::Http2, nullptr));
+  EXPECT_EQ(cp2, cluster_manager_->httpConnPoolForCluster("cluster_1", ResourcePriority::Default,
+                                                          Http::Protocol::Http2, nullptr));
+  EXPECT_LT(reselections, counter("cluster_1.upstream_cx_http2_per_host_reselect"));
+  EXPECT_EQ(0UL, counter("cluster_1.upstream_cx_http2_per_host_overflow"));
+
+  factory_.tls_.shutdownThread();
+}
+
+// A host at the limit is used without asking the load balancer again when it is the only host the
+// load balancer can choose, and with hash based load balancers.
+TEST_F(ClusterManagerImplTest, MaxHttp2ConnectionsPerHostNoOtherHost) {
+  const std::string yaml = R"EOF(
+static_resources:
+  clusters:
+  - name: round_robin
+    connect_timeout: 0.250s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    http2_protocol_options: {}
+    max_http2_connections_per_host: 1
+    load_assignment:
+      endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11001
+  - name: ring_hash
+    connect_timeout: 0.250s
+    type: STATIC
+    lb_policy: RING_HASH
+    http2_protocol_options: {}
+    max_http2_connections_per_host: 1
+    load_assignment:
+      endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11002
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.2
+                  port_value: 11002
+  )EOF";
+
+  create(parseBootstrapFromV2Yaml(yaml));
+  auto counter = [this](const std::string& name) {
+    return factory_.stats_.counter("cluster." + name).value();
+  };
+  for (const char* cluster : {"round_robin", "ring_hash"}) {
+    for (const HostSharedPtr& host :
+         cluster_manager_->get(cluster)->prioritySet().hostSetsPerPriority()[0]->hosts()) {
+      host->stats().cx_http2_active_.inc();
+    }
+  }
+
+  // The only host of the round robin cluster comes up again when the load balancer is asked for
+  // another one.
+  Http::ConnectionPool::MockInstance* cp = new Http::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateConnPool_(_, _)).WillOnce(Return(cp));
+  EXPECT_EQ(cp, cluster_manager_->httpConnPoolForCluster("round_robin", ResourcePriority::Default,
+                                                         Http::Protocol::Http2, nullptr));
+  EXPECT_EQ(0UL, counter("round_robin.upstream_cx_http2_per_host_reselect"));
+  EXPECT_EQ(1UL, counter("round_robin.upstream_cx_http2_per_host_overflow"));
+
+  Http::ConnectionPool::MockInstance* ring_hash_cp = new Http::ConnectionPool::MockInstance();
+  EXPECT_CALL(factory_, allocateConnPool_(_, _)).WillOnce(Return(ring_hash_cp));
+  EXPECT_EQ(ring_hash_cp,
+            cluster_manager_->httpConnPoolForCluster("ring_hash", ResourcePriority::Default,
+                                                     Http::Protocol::Http2, nullptr));
+  EXPECT_EQ(0UL, counter("ring_hash.upstream_cx_http2_per_host_reselect"));
+  EXPECT_EQ(0UL, counter("ring_hash.upstream_cx_http2_per_host_overflow"));
+
+  factory_.tls_.shutdownThread();
+}
+
 TEST_F(ClusterManagerImplTest, DynamicHostRemoveWithTls) {
   const std::string yaml = R"EOF(
   static_resources:
@@ -2544,6 +2803,52 @@ TEST_F(ClusterManagerImplTest, MergedUpdates) {
   EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.update_merge_cancelled").value());
 }
 
+// Tests that with merge_membership_updates, hosts that are added and removed within the window are
+// delivered in one update, and that a host that is added and removed again never reaches the
+// workers.
+TEST_F(ClusterManagerImplTest, MergedMembershipUpdates) {
+  createWithLocalClusterUpdate(true, true);
+
+  Event::MockTimer* timer = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  Cluster& cluster = cluster_manager_->activeClusters().begin()->second;
+  HostVectorSharedPtr hosts(
+      new HostVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts()));
+  HostsPerLocalitySharedPtr hosts_per_locality = std::make_shared<HostsPerLocalityImpl>();
+  const HostSharedPtr removed_host = (*hosts)[0];
+  const HostSharedPtr new_host1 = makeTestHost(cluster.info(), "tcp://127.0.0.1:11003");
+  const HostSharedPtr new_host2 = makeTestHost(cluster.info(), "tcp://127.0.0.1:11004");
+
+  EXPECT_CALL(local_cluster_update_, post(_, _, _))
+      .WillOnce(Invoke([&](uint32_t priority, const HostVector& hosts_added,
+                           const HostVector& hosts_removed) -> void {
+        EXPECT_EQ(0, priority);
+        EXPECT_EQ(HostVector{new_host1}, hosts_added);
+        EXPECT_EQ(HostVector{removed_host}, hosts_removed);
+      }));
+  // Removed hosts are drained as soon as they are removed, and again once the workers see the
+  // merged removal.
+  EXPECT_CALL(local_hosts_removed_, post(HostVector{removed_host})).Times(2);
+  EXPECT_CALL(local_hosts_removed_, post(HostVector{new_host2}));
+
+  const auto update = [&](const HostVector& hosts_added, const HostVector& hosts_removed) {
+    cluster.prioritySet().updateHosts(
+        0,
+        updateHostsParams(hosts, hosts_per_locality,
+                          std::make_shared<const HealthyHostVector>(*hosts), hosts_per_locality),
+        {}, hosts_added, hosts_removed, absl::nullopt);
+  };
+  update({}, {removed_host});
+  update({new_host1, new_host2}, {});
+  update({}, {new_host2});
+  EXPECT_EQ(0, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_EQ(0, factory_.stats_.counter("cluster_manager.cluster_updated_via_merge").value());
+
+  timer->invokeCallback();
+  EXPECT_EQ(0, factory_.stats_.counter("cluster_manager.cluster_updated").value());
+  EXPECT_EQ(1, factory_.stats_.counter("cluster_manager.cluster_updated_via_merge").value());
+  EXPECT_EQ(0, factory_.stats_.counter("cluster_manager.update_merge_cancelled").value());
+}
+
 // Tests that mergeable updates outside of a window get applied immediately.
 TEST_F(ClusterManagerImplTest, MergedUpdatesOutOfWindow) {
   createWithLocalClusterUpdate();
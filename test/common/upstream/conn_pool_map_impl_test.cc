@@ -131,6 +131,18 @@ TEST_F(ConnPoolMapImplTest, TestMultipleOfSameKeyReturnsOriginal) {
   EXPECT_EQ(test_map->size(), 2);
 }
 
+TEST_F(ConnPoolMapImplTest, TestFindPoolDoesNotCreate) {
+  TestMapPtr test_map = makeTestMap();
+
+  EXPECT_FALSE(test_map->findPool(1).has_value());
+  EXPECT_EQ(test_map->size(), 0);
+
+  TestMap::OptPoolRef pool = test_map->getPool(1, getBasicFactory());
+  EXPECT_EQ(&(pool.value().get()), &(test_map->findPool(1).value().get()));
+  EXPECT_FALSE(test_map->findPool(2).has_value());
+  EXPECT_EQ(test_map->size(), 1);
+}
+
 TEST_F(ConnPoolMapImplTest, TestEmptyClerWorks) {
   TestMapPtr test_map = makeTestMap();
 
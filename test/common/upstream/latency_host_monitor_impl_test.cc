@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cmath>
+
+#include "common/upstream/latency_host_monitor_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class PeakEwmaHostMonitorTest : public testing::Test {
+public:
+  MonotonicTime at(uint64_t ms) { return start_ + std::chrono::milliseconds(ms); }
+
+  const MonotonicTime start_{std::chrono::hours(1)};
+};
+
+TEST_F(PeakEwmaHostMonitorTest, DefaultLatency) {
+  PeakEwmaHostMonitor monitor(absl::nullopt);
+
+  // The estimate is 30ms until the first response.
+  EXPECT_DOUBLE_EQ(30000, monitor.latencyEstimate(at(0)));
+  EXPECT_DOUBLE_EQ(30000, monitor.latencyEstimate(at(10000)));
+}
+
+TEST_F(PeakEwmaHostMonitorTest, ConfiguredDefaultLatency) {
+  envoy::api::v2::Cluster::PeakEwmaLbConfig config;
+  config.mutable_decay_time()->set_seconds(1);
+  config.mutable_default_latency()->set_nanos(100000000);
+  PeakEwmaHostMonitor monitor(config);
+
+  EXPECT_DOUBLE_EQ(100000, monitor.latencyEstimate(at(0)));
+  EXPECT_DOUBLE_EQ(100000, monitor.latencyEstimate(at(1000)));
+}
+
+TEST_F(PeakEwmaHostMonitorTest, PeakReplacesEstimate) {
+  PeakEwmaHostMonitor monitor(absl::nullopt);
+
+  // The first response time replaces the default latency, even if lower.
+  monitor.putResponseTime(std::chrono::milliseconds(5), at(0));
+  EXPECT_DOUBLE_EQ(5000, monitor.latencyEstimate(at(0)));
+
+  monitor.putResponseTime(std::chrono::milliseconds(50), at(1));
+  EXPECT_DOUBLE_EQ(50000, monitor.latencyEstimate(at(1)));
+}
+
+TEST_F(PeakEwmaHostMonitorTest, LowerResponseTimesAreAveraged) {
+  envoy::api::v2::Cluster::PeakEwmaLbConfig config;
+  config.mutable_decay_time()->set_seconds(1);
+  PeakEwmaHostMonitor monitor(config);
+
+  monitor.putResponseTime(std::chrono::milliseconds(100), at(0));
+  monitor.putResponseTime(std::chrono::milliseconds(10), at(1000));
+  const double expected = 100000 * std::exp(-1) + 10000 * (1 - std::exp(-1));
+  EXPECT_NEAR(expected, monitor.latencyEstimate(at(1000)), 0.01);
+
+  // Responses at the same time as the last update do not move the estimate.
+  monitor.putResponseTime(std::chrono::milliseconds(10), at(1000));
+  EXPECT_NEAR(expected, monitor.latencyEstimate(at(1000)), 0.01);
+}
+
+TEST_F(PeakEwmaHostMonitorTest, DecaysTowardsLatestResponseTime) {
+  envoy::api::v2::Cluster::PeakEwmaLbConfig config;
+  config.mutable_decay_time()->set_seconds(1);
+  PeakEwmaHostMonitor monitor(config);
+
+  monitor.putResponseTime(std::chrono::milliseconds(100), at(0));
+  EXPECT_NEAR(100000, monitor.latencyEstimate(at(1000)), 0.01);
+
+  monitor.putResponseTime(std::chrono::milliseconds(10), at(1000));
+  const double estimate = 100000 * std::exp(-1) + 10000 * (1 - std::exp(-1));
+  EXPECT_NEAR(10000 + (estimate - 10000) * std::exp(-1), monitor.latencyEstimate(at(2000)), 0.01);
+  EXPECT_NEAR(10000, monitor.latencyEstimate(at(100000)), 0.01);
+}
+
+TEST_F(PeakEwmaHostMonitorTest, ClockBehindLastUpdate) {
+  PeakEwmaHostMonitor monitor(absl::nullopt);
+
+  // A worker whose clock was read just before the one of the last update sees no decay.
+  monitor.putResponseTime(std::chrono::milliseconds(20), at(1000));
+  EXPECT_DOUBLE_EQ(20000, monitor.latencyEstimate(at(999)));
+  monitor.putResponseTime(std::chrono::milliseconds(10), at(999));
+  EXPECT_DOUBLE_EQ(20000, monitor.latencyEstimate(at(999)));
+
+  // Nor does it move the time of the estimate backwards.
+  EXPECT_NEAR(10000 + 10000 * std::exp(-1), monitor.latencyEstimate(at(11000)), 0.01);
+}
+
+TEST_F(PeakEwmaHostMonitorTest, Failures) {
+  PeakEwmaHostMonitor monitor(absl::nullopt);
+
+  // A failure before any response counts as twice the default latency.
+  monitor.putFailure(std::chrono::microseconds(0), at(0));
+  EXPECT_DOUBLE_EQ(60000, monitor.latencyEstimate(at(0)));
+
+  // Fast failures double the estimate, slow ones count as their elapsed time.
+  monitor.putResponseTime(std::chrono::milliseconds(10), at(10000000));
+  EXPECT_DOUBLE_EQ(10000, monitor.latencyEstimate(at(10000000)));
+  monitor.putFailure(std::chrono::milliseconds(1), at(10000000));
+  EXPECT_DOUBLE_EQ(20000, monitor.latencyEstimate(at(10000000)));
+  monitor.putFailure(std::chrono::milliseconds(100), at(10000000));
+  EXPECT_DOUBLE_EQ(100000, monitor.latencyEstimate(at(10000000)));
+
+  // The estimate decays back towards the latest response time.
+  EXPECT_NEAR(10000 + 90000 * std::exp(-1), monitor.latencyEstimate(at(10010000)), 0.01);
+
+  // The penalty of a host which keeps failing is bounded.
+  for (uint32_t i = 0; i < 200; ++i) {
+    monitor.putFailure(std::chrono::microseconds(0), at(20000000));
+  }
+  EXPECT_DOUBLE_EQ(60000000, monitor.latencyEstimate(at(20000000)));
+}
+
+TEST(LatencyHostMonitorNullImplTest, All) {
+  LatencyHostMonitorNullImpl monitor;
+  monitor.putResponseTime(std::chrono::milliseconds(20), MonotonicTime());
+  monitor.putFailure(std::chrono::milliseconds(20), MonotonicTime());
+  EXPECT_EQ(0, monitor.latencyEstimate(MonotonicTime()));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
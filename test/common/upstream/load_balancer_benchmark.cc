@@ -115,8 +115,12 @@ public:
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint32_t hash_balance_factor = 0)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
+    if (hash_balance_factor > 0) {
+      common_config_.mutable_hash_balance_factor()->set_value(hash_balance_factor);
+    }
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, stats_store_, runtime_,
                                                       random_, common_config_);
   }
@@ -167,6 +171,67 @@ BENCHMARK(BM_MaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(benchmark::kMillisecond);
 
+// Replaces the hosts_to_churn oldest hosts of the tester with new ones, in a single update.
+void churnHosts(BaseTester& tester, uint64_t hosts_to_churn, uint64_t& next_host) {
+  HostVector hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+  const HostVector hosts_removed(hosts.begin(), hosts.begin() + hosts_to_churn);
+  HostVector hosts_added;
+  for (uint64_t i = 0; i < hosts_to_churn; i++, next_host++) {
+    const uint64_t host = next_host % 65536;
+    hosts_added.push_back(
+        makeTestHost(tester.info_, fmt::format("tcp://10.1.{}.{}:6379", host / 256, host % 256)));
+  }
+  hosts.erase(hosts.begin(), hosts.begin() + hosts_to_churn);
+  hosts.insert(hosts.end(), hosts_added.begin(), hosts_added.end());
+
+  HostVectorConstSharedPtr updated_hosts = std::make_shared<HostVector>(hosts);
+  HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({hosts});
+  tester.priority_set_.updateHosts(0,
+                                   HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality),
+                                   {}, hosts_added, hosts_removed, absl::nullopt);
+}
+
+void BM_RingHashLoadBalancerHostChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+  const uint64_t hosts_to_churn = state.range(2);
+  RingHashTester tester(num_hosts, min_ring_size);
+  tester.ring_hash_lb_->initialize();
+  uint64_t next_host = 0;
+
+  // Each update rebuilds the ring from the previous one.
+  for (auto _ : state) {
+    churnHosts(tester, hosts_to_churn, next_host);
+  }
+}
+BENCHMARK(BM_RingHashLoadBalancerHostChurn)
+    ->Args({100, 65536, 1})
+    ->Args({500, 65536, 1})
+    ->Args({500, 256000, 1})
+    ->Args({500, 256000, 10})
+    ->Args({500, 256000, 100})
+    ->Args({500, 1048576, 1})
+    ->Args({500, 1048576, 10})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MaglevLoadBalancerHostChurn(benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t hosts_to_churn = state.range(1);
+  MaglevTester tester(num_hosts);
+  tester.maglev_lb_->initialize();
+  uint64_t next_host = 0;
+
+  for (auto _ : state) {
+    churnHosts(tester, hosts_to_churn, next_host);
+  }
+}
+BENCHMARK(BM_MaglevLoadBalancerHostChurn)
+    ->Args({100, 1})
+    ->Args({500, 1})
+    ->Args({500, 10})
+    ->Args({500, 100})
+    ->Unit(benchmark::kMillisecond);
+
 class TestLoadBalancerContext : public LoadBalancerContextBase {
 public:
   // Upstream::LoadBalancerContext
@@ -267,6 +332,41 @@ BENCHMARK(BM_MaglevLoadBalancerChooseHost)
     ->Args({500, 100000})
     ->Unit(benchmark::kMillisecond);
 
+void BM_MaglevLoadBalancerChooseHostBoundedLoad(benchmark::State& state) {
+  for (auto _ : state) {
+    // Do not time the creation of the table.
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t keys_to_simulate = state.range(1);
+    MaglevTester tester(num_hosts, 0, 0, 125);
+    tester.maglev_lb_->initialize();
+    LoadBalancerPtr lb = tester.maglev_lb_->factory()->create();
+    std::unordered_map<std::string, uint64_t> hit_counter;
+    TestLoadBalancerContext context;
+    state.ResumeTiming();
+
+    // Every request stays active, as the connection pools would count it, so that hosts reach
+    // their bounds and requests go past them.
+    for (uint64_t i = 0; i < keys_to_simulate; i++) {
+      context.hash_key_ = hashInt(i);
+      HostConstSharedPtr host = lb->chooseHost(&context);
+      host->stats().rq_active_.inc();
+      tester.stats_.upstream_rq_active_.inc();
+      hit_counter[host->address()->asString()] += 1;
+    }
+
+    // Do not time computation of mean, standard deviation, and relative standard deviation.
+    state.PauseTiming();
+    computeHitStats(state, hit_counter);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_MaglevLoadBalancerChooseHostBoundedLoad)
+    ->Args({100, 100000})
+    ->Args({200, 100000})
+    ->Args({500, 100000})
+    ->Unit(benchmark::kMillisecond);
+
 void BM_RingHashLoadBalancerHostLoss(benchmark::State& state) {
   for (auto _ : state) {
     const uint64_t num_hosts = state.range(0);
@@ -11,6 +11,7 @@
 #include "test/common/upstream/utility.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/upstream/mocks.h"
+#include "test/test_common/simulated_time_system.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -1480,6 +1481,112 @@ TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceCallbacks) {
 INSTANTIATE_TEST_SUITE_P(PrimaryOrFailover, LeastRequestLoadBalancerTest,
                          ::testing::Values(true, false));
 
+class PeakEwmaLoadBalancerTest : public LoadBalancerTestBase {
+public:
+  PeakEwmaLoadBalancerTest() { info_->lb_type_ = LoadBalancerType::PeakEwma; }
+
+  void init(const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>& config) {
+    lb_ = std::make_unique<PeakEwmaLoadBalancer>(priority_set_, nullptr, stats_, runtime_, random_,
+                                                 time_system_, common_config_, config);
+  }
+
+  void putResponseTime(size_t host_index, uint64_t ms) {
+    hostSet().healthy_hosts_[host_index]->latencyMonitor().putResponseTime(
+        std::chrono::milliseconds(ms), time_system_.monotonicTime());
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  std::unique_ptr<PeakEwmaLoadBalancer> lb_;
+};
+
+TEST_P(PeakEwmaLoadBalancerTest, NoHosts) {
+  init(absl::nullopt);
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr));
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, Latency) {
+  init(absl::nullopt);
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  putResponseTime(0, 10);
+  putResponseTime(1, 20);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
+
+  // A latency spike is seen at once.
+  putResponseTime(0, 30);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, ActiveRequestsAndWeight) {
+  init(absl::nullopt);
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  // Both hosts have a cost of 10ms.
+  putResponseTime(0, 10);
+  putResponseTime(1, 20);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+
+  // The cost of hosts[1] doubles with one active request.
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, NewHostDefaultLatency) {
+  envoy::api::v2::Cluster::PeakEwmaLbConfig config;
+  config.mutable_default_latency()->set_seconds(1);
+  init(config);
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  putResponseTime(0, 100);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
+
+  // Without responses, the default latency of hosts[1] decays below the latency of hosts[0].
+  time_system_.sleep(std::chrono::seconds(30));
+  putResponseTime(0, 100);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, ChoiceCount) {
+  envoy::api::v2::Cluster::PeakEwmaLbConfig config;
+  config.mutable_choice_count()->set_value(3);
+  init(config);
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81"),
+                              makeTestHost(info_, "tcp://127.0.0.1:82")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  putResponseTime(0, 30);
+  putResponseTime(1, 20);
+  putResponseTime(2, 10);
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(2))
+      .WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_->chooseHost(nullptr));
+}
+
+INSTANTIATE_TEST_SUITE_P(PrimaryOrFailover, PeakEwmaLoadBalancerTest,
+                         ::testing::Values(true, false));
+
 class RandomLoadBalancerTest : public LoadBalancerTestBase {
 public:
   void init() {
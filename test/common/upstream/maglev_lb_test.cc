@@ -79,6 +79,49 @@ TEST_F(MaglevLoadBalancerTest, Basic) {
   }
 }
 
+// With bounded loads, requests for overloaded hosts go to the host of the next table entry that is
+// not overloaded.
+TEST_F(MaglevLoadBalancerTest, BoundedLoad) {
+  host_set_.hosts_ = {
+      makeTestHost(info_, "tcp://127.0.0.1:90"), makeTestHost(info_, "tcp://127.0.0.1:91"),
+      makeTestHost(info_, "tcp://127.0.0.1:92"), makeTestHost(info_, "tcp://127.0.0.1:93"),
+      makeTestHost(info_, "tcp://127.0.0.1:94"), makeTestHost(info_, "tcp://127.0.0.1:95")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  common_config_.mutable_hash_balance_factor()->set_value(101);
+  init(7);
+
+  // Same table as in the Basic test. Each host may have one active request, including the one
+  // being balanced, so :92 and :94 are overloaded.
+  host_set_.hosts_[2]->stats().rq_active_.set(1);
+  host_set_.hosts_[4]->stats().rq_active_.set(1);
+  stats_.upstream_rq_active_.set(2);
+  LoadBalancerPtr lb = lb_->factory()->create();
+  const std::vector<uint32_t> expected_assignments{0, 0, 0, 1, 5, 0, 3};
+  for (uint32_t i = 0; i < expected_assignments.size(); ++i) {
+    TestLoadBalancerContext context(i);
+    EXPECT_EQ(host_set_.hosts_[expected_assignments[i]], lb->chooseHost(&context));
+  }
+
+  // Entries past the end of the table wrap around.
+  host_set_.hosts_[3]->stats().rq_active_.set(1);
+  stats_.upstream_rq_active_.set(3);
+  {
+    TestLoadBalancerContext context(6);
+    EXPECT_EQ(host_set_.hosts_[0], lb->chooseHost(&context));
+  }
+
+  // If every host has the same load, requests go to the host their hash maps to.
+  for (const auto& host : host_set_.hosts_) {
+    host->stats().rq_active_.set(1);
+  }
+  stats_.upstream_rq_active_.set(6);
+  {
+    TestLoadBalancerContext context(1);
+    EXPECT_EQ(host_set_.hosts_[4], lb->chooseHost(&context));
+  }
+}
+
 // Weighted sanity test.
 TEST_F(MaglevLoadBalancerTest, Weighted) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", 1),
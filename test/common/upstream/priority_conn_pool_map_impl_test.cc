@@ -70,6 +70,17 @@ TEST_F(PriorityConnPoolMapImplTest, HighPriorityProxiedThrough) {
   EXPECT_CALL(host_->cluster_, resourceManager(ResourcePriority::Default)).Times(AtLeast(1));
 }
 
+// Show that pools are only found at the priority they were created for.
+TEST_F(PriorityConnPoolMapImplTest, TestFindPoolForPriority) {
+  TestMapPtr test_map = makeTestMap();
+
+  auto pool = test_map->getPool(ResourcePriority::High, 0, getBasicFactory());
+  EXPECT_EQ(&(pool.value().get()),
+            &(test_map->findPool(ResourcePriority::High, 0).value().get()));
+  EXPECT_FALSE(test_map->findPool(ResourcePriority::Default, 0).has_value());
+  EXPECT_EQ(test_map->size(), 1);
+}
+
 TEST_F(PriorityConnPoolMapImplTest, TestSizeForSinglePriority) {
   TestMapPtr test_map = makeTestMap();
 
@@ -157,6 +157,51 @@ TEST_P(RingHashLoadBalancerTest, Basic) {
   EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
 }
 
+// With bounded loads, requests for overloaded hosts go to the host of the next ring entry that is
+// not overloaded.
+TEST_P(RingHashLoadBalancerTest, BoundedLoad) {
+  hostSet().hosts_ = {
+      makeTestHost(info_, "tcp://127.0.0.1:90"), makeTestHost(info_, "tcp://127.0.0.1:91"),
+      makeTestHost(info_, "tcp://127.0.0.1:92"), makeTestHost(info_, "tcp://127.0.0.1:93"),
+      makeTestHost(info_, "tcp://127.0.0.1:94"), makeTestHost(info_, "tcp://127.0.0.1:95")};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::api::v2::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(12);
+  common_config_.mutable_hash_balance_factor()->set_value(125);
+  init();
+
+  // Same ring as in the Basic test. With 4 active requests in the cluster, including the one being
+  // balanced, each host may have up to ceil(4 / 6 * 1.25) = 1 of them.
+  hostSet().hosts_[4]->stats().rq_active_.set(2);
+  hostSet().hosts_[2]->stats().rq_active_.set(1);
+  stats_.upstream_rq_active_.set(3);
+  LoadBalancerPtr lb = lb_->factory()->create();
+  {
+    // :94, :92 and :90 follow each other on the ring.
+    TestLoadBalancerContext context(0);
+    EXPECT_EQ(hostSet().hosts_[0], lb->chooseHost(&context));
+  }
+  {
+    // Past the last entry, the ring wraps around to :94.
+    TestLoadBalancerContext context(std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(hostSet().hosts_[0], lb->chooseHost(&context));
+  }
+  {
+    TestLoadBalancerContext context(3551244743356806947);
+    EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(&context));
+  }
+
+  // Once there are more active requests, :92 is below its bound again.
+  hostSet().hosts_[1]->stats().rq_active_.set(2);
+  stats_.upstream_rq_active_.set(5);
+  {
+    TestLoadBalancerContext context(0);
+    EXPECT_EQ(hostSet().hosts_[2], lb->chooseHost(&context));
+  }
+}
+
 // Ensure if all the hosts with priority 0 unhealthy, the next priority hosts are used.
 TEST_P(RingHashFailoverTest, BasicFailover) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80")};
@@ -625,6 +670,64 @@ TEST_P(RingHashLoadBalancerTest, LopsidedWeightSmallScale) {
   }
 }
 
+// Rebuilding the ring after hosts are added, removed or reweighted reuses the entries of the
+// previous ring. Expect the same ring as a build from scratch.
+TEST_P(RingHashLoadBalancerTest, IncrementalRebuild) {
+  for (uint32_t i = 0; i < 10; ++i) {
+    hostSet().hosts_.push_back(makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i)));
+  }
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::api::v2::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(1024);
+  init();
+
+  // Remove a host, add two hosts and double the weight of another one.
+  const HostVector removed{hostSet().hosts_[0]};
+  const HostVector added{makeTestHost(info_, "tcp://127.0.0.1:100"),
+                         makeTestHost(info_, "tcp://127.0.0.1:101")};
+  hostSet().hosts_.erase(hostSet().hosts_.begin());
+  hostSet().hosts_.insert(hostSet().hosts_.end(), added.begin(), added.end());
+  hostSet().hosts_[0]->weight(2);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks(added, removed);
+  LoadBalancerPtr lb = lb_->factory()->create();
+
+  RingHashLoadBalancer full_build(priority_set_, stats_, stats_store_, runtime_, random_, config_,
+                                  common_config_);
+  full_build.initialize();
+  LoadBalancerPtr full_build_lb = full_build.factory()->create();
+  for (uint64_t i = 0; i < 65536; ++i) {
+    TestLoadBalancerContext context(i * (std::numeric_limits<uint64_t>::max() / 65536));
+    EXPECT_EQ(full_build_lb->chooseHost(&context), lb->chooseHost(&context));
+  }
+}
+
+// Updating the hosts of one priority does not rebuild the rings of the others.
+TEST_P(RingHashFailoverTest, UnchangedPriorityNotRebuilt) {
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                      makeTestHost(info_, "tcp://127.0.0.1:81")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  for (uint32_t i = 0; i < 5; ++i) {
+    failover_host_set_.hosts_.push_back(
+        makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i)));
+  }
+  failover_host_set_.healthy_hosts_ = failover_host_set_.hosts_;
+
+  config_ = envoy::api::v2::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(12);
+  init();
+  // The ring of P=1 is built last and has 3 hashes for each of its 5 hosts.
+  EXPECT_EQ(15, lb_->stats().size_.value());
+
+  host_set_.hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82"));
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({host_set_.hosts_.back()}, {});
+  // Only the ring of P=0 is built again.
+  EXPECT_EQ(12, lb_->stats().size_.value());
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
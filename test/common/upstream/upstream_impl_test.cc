@@ -1935,6 +1935,38 @@ TEST_F(ClusterInfoImplTest, EdsServiceNamePopulation) {
                             "eds_cluster_config set in a non-EDS cluster");
 }
 
+// Peak EWMA load balancing is configured, and is not supported with subsets.
+TEST_F(ClusterInfoImplTest, PeakEwma) {
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: PEAK_EWMA
+    peak_ewma_lb_config:
+      decay_time: 5s
+      choice_count: 3
+    hosts: [{ socket_address: { address: foo.bar.com, port_value: 443 }}]
+  )EOF";
+  auto cluster = makeCluster(yaml);
+  EXPECT_EQ(LoadBalancerType::PeakEwma, cluster->info()->lbType());
+  EXPECT_EQ(5, cluster->info()->lbPeakEwmaConfig()->decay_time().seconds());
+  EXPECT_EQ(3, cluster->info()->lbPeakEwmaConfig()->choice_count().value());
+
+  const std::string subset_yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: PEAK_EWMA
+    lb_subset_config:
+      subset_selectors:
+        - keys: [ "foo" ]
+    hosts: [{ socket_address: { address: foo.bar.com, port_value: 443 }}]
+  )EOF";
+  EXPECT_THROW_WITH_MESSAGE(
+      makeCluster(subset_yaml), EnvoyException,
+      "cluster: LB policy PEAK_EWMA cannot be combined with lb_subset_config");
+}
+
 // Typed metadata loading throws exception.
 TEST_F(ClusterInfoImplTest, BrokenTypedMetadata) {
   const std::string yaml = R"EOF(
@@ -74,6 +74,24 @@ TEST_F(QuicIoHandleWrapperTest, DelegateIoHandleCalls) {
   }));
   wrapper_->recvmsg(&slice, 1, /*self_port=*/12345, output);
 
+  Network::IoHandle::RecvMmsgOutput mmsg_output(1, nullptr);
+  EXPECT_CALL(os_sys_calls_, recvmmsg(fd, _, 1, MSG_WAITFORONE, nullptr))
+      .WillOnce(Invoke([](int, struct mmsghdr* msgvec, unsigned int, int, struct timespec*) {
+        sockaddr_storage ss;
+        auto ipv6_addr = reinterpret_cast<sockaddr_in6*>(&ss);
+        memset(ipv6_addr, 0, sizeof(sockaddr_in6));
+        ipv6_addr->sin6_family = AF_INET6;
+        ipv6_addr->sin6_addr = in6addr_loopback;
+        ipv6_addr->sin6_port = htons(54321);
+        *reinterpret_cast<sockaddr_in6*>(msgvec[0].msg_hdr.msg_name) = *ipv6_addr;
+        msgvec[0].msg_hdr.msg_namelen = sizeof(sockaddr_in6);
+        msgvec[0].msg_hdr.msg_controllen = 0;
+        msgvec[0].msg_len = 5;
+        return Api::SysCallIntResult{1, 0};
+      }));
+  wrapper_->recvmmsg(&slice, 1, /*self_port=*/12345, mmsg_output);
+  EXPECT_EQ(5u, mmsg_output.packets_[0].msg_len_);
+
   EXPECT_TRUE(wrapper_->close().ok());
 
   // Following calls shouldn't be delegated.
@@ -82,6 +100,7 @@ TEST_F(QuicIoHandleWrapperTest, DelegateIoHandleCalls) {
   wrapper_->sendto(slice, 0, *addr);
   wrapper_->sendmsg(&slice, 1, 0, /*self_ip=*/nullptr, *addr);
   wrapper_->recvmsg(&slice, 1, /*self_port=*/12345, output);
+  wrapper_->recvmmsg(&slice, 1, /*self_port=*/12345, mmsg_output);
 }
 
 } // namespace Quic
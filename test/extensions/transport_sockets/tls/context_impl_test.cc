@@ -724,6 +724,27 @@ TEST_F(ClientContextConfigImplTest, MultipleTlsCertificates) {
       "Multiple TLS certificates are not supported for client contexts");
 }
 
+// Kernel TLS offload cannot be combined with renegotiation, which needs BoringSSL to write records.
+TEST_F(ClientContextConfigImplTest, KernelTlsTxOffloadWithRenegotiation) {
+  envoy::api::v2::auth::UpstreamTlsContext tls_context;
+  tls_context.mutable_common_tls_context()->set_kernel_tls_tx_offload(true);
+  tls_context.set_allow_renegotiation(true);
+  EXPECT_THROW_WITH_MESSAGE(
+      ClientContextConfigImpl client_context_config(tls_context, factory_context_), EnvoyException,
+      "kernel_tls_tx_offload cannot be used with allow_renegotiation");
+}
+
+#if !defined(__linux__)
+// Kernel TLS offload is rejected where the platform has no kernel TLS.
+TEST_F(ClientContextConfigImplTest, KernelTlsTxOffloadUnsupportedPlatform) {
+  envoy::api::v2::auth::UpstreamTlsContext tls_context;
+  tls_context.mutable_common_tls_context()->set_kernel_tls_tx_offload(true);
+  EXPECT_THROW_WITH_MESSAGE(
+      ClientContextConfigImpl client_context_config(tls_context, factory_context_), EnvoyException,
+      "kernel_tls_tx_offload is not supported on this platform");
+}
+#endif
+
 // Validate context config does not support handling both static TLS certificate and dynamic TLS
 // certificate.
 TEST_F(ClientContextConfigImplTest, TlsCertificatesAndSdsConfig) {
@@ -2,6 +2,15 @@
 #include <memory>
 #include <string>
 
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
 #include "envoy/network/transport_socket.h"
 
 #include "common/buffer/buffer_impl.h"
@@ -36,6 +45,7 @@
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
 #include "test/test_common/registry.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_replace.h"
@@ -3880,6 +3890,12 @@ protected:
     listener_ = dispatcher_->createListener(socket_, listener_callbacks_, true, false);
 
     TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml_), upstream_tls_context_);
+    if (client_kernel_tls_tx_offload_) {
+      auto* common_tls_context = upstream_tls_context_.mutable_common_tls_context();
+      common_tls_context->set_kernel_tls_tx_offload(true);
+      common_tls_context->mutable_tls_params()->set_tls_maximum_protocol_version(
+          envoy::api::v2::auth::TlsParameters::TLSv1_2);
+    }
     auto client_cfg =
         std::make_unique<ClientContextConfigImpl>(upstream_tls_context_, factory_context_);
 
@@ -4070,6 +4086,7 @@ protected:
   std::shared_ptr<Network::MockReadFilter> read_filter_;
   StrictMock<Network::MockConnectionCallbacks> client_callbacks_;
   Network::Address::InstanceConstSharedPtr source_address_;
+  bool client_kernel_tls_tx_offload_{};
 };
 
 INSTANTIATE_TEST_SUITE_P(IpVersions, SslReadBufferLimitTest,
@@ -4090,6 +4107,54 @@ TEST_P(SslReadBufferLimitTest, SomeLimit) {
   readBufferLimitTest(32 * 1024, 32 * 1024, 256 * 1024, 1, false);
 }
 
+#if defined(__linux__)
+// Forwards to the real system calls, records whether the kernel took the transmit keys, and can
+// fail attaching the tls ULP as if the kernel module was missing.
+class KernelTlsOsSysCalls : public Api::OsSysCallsImpl {
+public:
+  Api::SysCallIntResult setsockopt(int sockfd, int level, int optname, const void* optval,
+                                   socklen_t optlen) override {
+    if (level == SOL_TCP && optname == TCP_ULP && fail_ulp_) {
+      return {-1, ENOENT};
+    }
+    const Api::SysCallIntResult result =
+        Api::OsSysCallsImpl::setsockopt(sockfd, level, optname, optval, optlen);
+    if (level == SOL_TLS && optname == TLS_TX && result.rc_ == 0) {
+      ++tx_keys_set_;
+    }
+    return result;
+  }
+
+  bool fail_ulp_{};
+  uint32_t tx_keys_set_{};
+};
+
+// The client writes through kernel TLS if the kernel takes the keys and through BoringSSL
+// otherwise. Either way the server must see the same plaintext and a clean close.
+TEST_P(SslReadBufferLimitTest, KernelTlsTxOffload) {
+  KernelTlsOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  client_kernel_tls_tx_offload_ = true;
+  readBufferLimitTest(0, 256 * 1024, 256 * 1024, 1, false);
+  ASSERT_LE(os_sys_calls.tx_keys_set_, 1);
+  const bool offloaded = os_sys_calls.tx_keys_set_ == 1;
+  EXPECT_EQ(offloaded ? 1UL : 0UL, client_stats_store_.counter("ssl.ktls_tx_offloaded").value());
+  EXPECT_EQ(offloaded ? 0UL : 1UL, client_stats_store_.counter("ssl.ktls_tx_unsupported").value());
+}
+
+// Without the kernel tls module, the client falls back to writing through BoringSSL.
+TEST_P(SslReadBufferLimitTest, KernelTlsTxOffloadUnavailable) {
+  KernelTlsOsSysCalls os_sys_calls;
+  os_sys_calls.fail_ulp_ = true;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  client_kernel_tls_tx_offload_ = true;
+  readBufferLimitTest(0, 256 * 1024, 256 * 1024, 1, false);
+  EXPECT_EQ(0, os_sys_calls.tx_keys_set_);
+  EXPECT_EQ(0UL, client_stats_store_.counter("ssl.ktls_tx_offloaded").value());
+  EXPECT_EQ(1UL, client_stats_store_.counter("ssl.ktls_tx_unsupported").value());
+}
+#endif
+
 TEST_P(SslReadBufferLimitTest, WritesSmallerThanBufferLimit) { singleWriteTest(5 * 1024, 1024); }
 
 TEST_P(SslReadBufferLimitTest, WritesLargerThanBufferLimit) { singleWriteTest(1024, 5 * 1024); }
@@ -24,6 +24,7 @@
 #include "common/common/thread.h"
 #include "common/grpc/codec.h"
 #include "common/grpc/common.h"
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/filter_impl.h"
 #include "common/network/listen_socket_impl.h"
 #include "common/stats/isolated_store_impl.h"
@@ -595,6 +596,7 @@ private:
     Network::FilterChainFactory& filterChainFactory() override { return parent_; }
     Network::Socket& socket() override { return *parent_.socket_; }
     const Network::Socket& socket() const override { return *parent_.socket_; }
+    Network::Socket& listenSocket(uint32_t) override { return *parent_.socket_; }
     bool bindToPort() override { return true; }
     bool handOffRestoredDestinationConnections() const override { return false; }
     uint32_t perConnectionBufferLimitBytes() const override { return 0; }
@@ -608,10 +610,12 @@ private:
     Network::ActiveUdpListenerFactory* udpListenerFactory() override {
       return udp_listener_factory_.get();
     }
+    Network::ConnectionBalancer& connectionBalancer() override { return connection_balancer_; }
 
     FakeUpstream& parent_;
     Network::ActiveUdpListenerFactoryPtr udp_listener_factory_;
     std::string name_;
+    Network::NopConnectionBalancerImpl connection_balancer_;
   };
 
   void threadRoutine();
@@ -70,6 +70,9 @@ public:
   MOCK_METHOD6(sendto, SysCallSizeResult(int sockfd, const void* buffer, size_t length, int flags,
                                          const struct sockaddr* addr, socklen_t addrlen));
   MOCK_METHOD3(recvmsg, SysCallSizeResult(int socket, struct msghdr* msg, int flags));
+  MOCK_METHOD5(recvmmsg, SysCallIntResult(int socket, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags, struct timespec* timeout));
+  MOCK_CONST_METHOD0(supportsMmsg, bool());
   MOCK_METHOD2(ftruncate, SysCallIntResult(int fd, off_t length));
   MOCK_METHOD6(mmap, SysCallPtrResult(void* addr, size_t length, int prot, int flags, int fd,
                                       off_t offset));
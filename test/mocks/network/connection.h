@@ -69,6 +69,9 @@ public:
   MOCK_CONST_METHOD0(remoteAddress, const Address::InstanceConstSharedPtr&());
   MOCK_CONST_METHOD0(unixSocketPeerCredentials,
                      absl::optional<Connection::UnixDomainSocketPeerCredentials>());
+  MOCK_CONST_METHOD0(ioHandle, const IoHandle&());
+  MOCK_METHOD3(takeOverSocketEvents, void(SocketEventCb cb, Buffer::Instance& read_data,
+                                          Buffer::Instance& write_data));
   MOCK_CONST_METHOD0(localAddress, const Address::InstanceConstSharedPtr&());
   MOCK_METHOD1(setConnectionStats, void(const ConnectionStats& stats));
   MOCK_CONST_METHOD0(ssl, Ssl::ConnectionInfoConstSharedPtr());
@@ -115,6 +118,9 @@ public:
   MOCK_CONST_METHOD0(remoteAddress, const Address::InstanceConstSharedPtr&());
   MOCK_CONST_METHOD0(unixSocketPeerCredentials,
                      absl::optional<Connection::UnixDomainSocketPeerCredentials>());
+  MOCK_CONST_METHOD0(ioHandle, const IoHandle&());
+  MOCK_METHOD3(takeOverSocketEvents, void(SocketEventCb cb, Buffer::Instance& read_data,
+                                          Buffer::Instance& write_data));
   MOCK_CONST_METHOD0(localAddress, const Address::InstanceConstSharedPtr&());
   MOCK_METHOD1(setConnectionStats, void(const ConnectionStats& stats));
   MOCK_CONST_METHOD0(ssl, Ssl::ConnectionInfoConstSharedPtr());
@@ -164,6 +170,9 @@ public:
   MOCK_CONST_METHOD0(remoteAddress, const Address::InstanceConstSharedPtr&());
   MOCK_CONST_METHOD0(unixSocketPeerCredentials,
                      absl::optional<Connection::UnixDomainSocketPeerCredentials>());
+  MOCK_CONST_METHOD0(ioHandle, const IoHandle&());
+  MOCK_METHOD3(takeOverSocketEvents, void(SocketEventCb cb, Buffer::Instance& read_data,
+                                          Buffer::Instance& write_data));
   MOCK_CONST_METHOD0(localAddress, const Address::InstanceConstSharedPtr&());
   MOCK_METHOD1(setConnectionStats, void(const ConnectionStats& stats));
   MOCK_CONST_METHOD0(ssl, Ssl::ConnectionInfoConstSharedPtr());
@@ -27,11 +27,16 @@ namespace Network {
 MockListenerConfig::MockListenerConfig() {
   ON_CALL(*this, filterChainFactory()).WillByDefault(ReturnRef(filter_chain_factory_));
   ON_CALL(*this, socket()).WillByDefault(ReturnRef(socket_));
+  ON_CALL(*this, listenSocket(_)).WillByDefault(ReturnRef(socket_));
   ON_CALL(*this, listenerScope()).WillByDefault(ReturnRef(scope_));
   ON_CALL(*this, name()).WillByDefault(ReturnRef(name_));
+  ON_CALL(*this, connectionBalancer()).WillByDefault(ReturnRef(connection_balancer_));
 }
 MockListenerConfig::~MockListenerConfig() = default;
 
+MockBalancedConnectionHandler::MockBalancedConnectionHandler() = default;
+MockBalancedConnectionHandler::~MockBalancedConnectionHandler() = default;
+
 MockActiveDnsQuery::MockActiveDnsQuery() = default;
 MockActiveDnsQuery::~MockActiveDnsQuery() = default;
 
@@ -7,12 +7,14 @@
 
 #include "envoy/api/v2/core/address.pb.h"
 #include "envoy/network/connection.h"
+#include "envoy/network/connection_balancer.h"
 #include "envoy/network/drain_decision.h"
 #include "envoy/network/filter.h"
 #include "envoy/network/resolver.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/stats/scope.h"
 
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/filter_manager_impl.h"
 #include "common/stats/isolated_store_impl.h"
 
@@ -303,6 +305,7 @@ public:
   MOCK_METHOD0(filterChainFactory, FilterChainFactory&());
   MOCK_METHOD0(socket, Socket&());
   MOCK_CONST_METHOD0(socket, const Socket&());
+  MOCK_METHOD1(listenSocket, Socket&(uint32_t worker_index));
   MOCK_METHOD0(bindToPort, bool());
   MOCK_CONST_METHOD0(handOffRestoredDestinationConnections, bool());
   MOCK_CONST_METHOD0(perConnectionBufferLimitBytes, uint32_t());
@@ -312,11 +315,25 @@ public:
   MOCK_CONST_METHOD0(listenerTag, uint64_t());
   MOCK_CONST_METHOD0(name, const std::string&());
   MOCK_METHOD0(udpListenerFactory, const Network::ActiveUdpListenerFactory*());
+  MOCK_METHOD0(connectionBalancer, ConnectionBalancer&());
 
   testing::NiceMock<MockFilterChainFactory> filter_chain_factory_;
   testing::NiceMock<MockListenSocket> socket_;
   Stats::IsolatedStoreImpl scope_;
   std::string name_;
+  NopConnectionBalancerImpl connection_balancer_;
+};
+
+class MockBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  MockBalancedConnectionHandler();
+  ~MockBalancedConnectionHandler() override;
+
+  void post(ConnectionSocketPtr&& socket) override { post_(socket); }
+
+  MOCK_CONST_METHOD0(numConnections, uint64_t());
+  MOCK_METHOD0(incNumConnections, void());
+  MOCK_METHOD1(post_, void(ConnectionSocketPtr& socket));
 };
 
 class MockListener : public Listener {
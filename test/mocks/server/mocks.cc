@@ -100,6 +100,16 @@ MockListenerComponentFactory::MockListenerComponentFactory()
             }
             return socket_;
           }));
+  ON_CALL(*this, createWorkerListenSocket(_, _, _))
+      .WillByDefault(Invoke([&](Network::Address::InstanceConstSharedPtr,
+                                const Network::Socket::OptionsSharedPtr& options,
+                                uint32_t) -> Network::SocketSharedPtr {
+        if (!Network::Socket::applyOptions(options, *socket_,
+                                           envoy::api::v2::core::SocketOption::STATE_PREBIND)) {
+          throw EnvoyException("MockListenerComponentFactory: Setting socket options failed");
+        }
+        return socket_;
+      }));
 }
 MockListenerComponentFactory::~MockListenerComponentFactory() = default;
 
@@ -86,6 +86,9 @@ public:
   MOCK_CONST_METHOD0(mutexTracingEnabled, bool());
   MOCK_CONST_METHOD0(libeventBufferEnabled, bool());
   MOCK_CONST_METHOD0(fakeSymbolTableEnabled, bool());
+  MOCK_CONST_METHOD0(statsCounterShards, uint32_t());
+  MOCK_CONST_METHOD0(statsSymbolTableShards, uint32_t());
+  MOCK_CONST_METHOD0(statsLockFreeHistograms, bool());
   MOCK_CONST_METHOD0(cpusetThreadsEnabled, bool());
   MOCK_CONST_METHOD0(toCommandLineOptions, Server::CommandLineOptionsPtr());
 
@@ -160,6 +163,7 @@ public:
   MOCK_CONST_METHOD0(getRequestHeaders, Http::HeaderMap&());
   MOCK_CONST_METHOD0(getDecoderFilterCallbacks,
                      NiceMock<Http::MockStreamDecoderFilterCallbacks>&());
+  MOCK_CONST_METHOD0(canStreamResponse, bool());
 };
 
 class MockDrainManager : public DrainManager {
@@ -207,7 +211,8 @@ public:
 
   // Server::HotRestart
   MOCK_METHOD0(drainParentListeners, void());
-  MOCK_METHOD1(duplicateParentListenSocket, int(const std::string& address));
+  MOCK_METHOD2(duplicateParentListenSocket,
+               int(const std::string& address, uint32_t worker_index));
   MOCK_METHOD0(getParentStats, std::unique_ptr<envoy::HotRestartMessage>());
   MOCK_METHOD2(initialize, void(Event::Dispatcher& dispatcher, Server::Instance& server));
   MOCK_METHOD1(sendParentAdminShutdownRequest, void(time_t& original_start_time));
@@ -256,6 +261,10 @@ public:
                                         Network::Address::SocketType socket_type,
                                         const Network::Socket::OptionsSharedPtr& options,
                                         bool bind_to_port));
+  MOCK_METHOD3(createWorkerListenSocket,
+               Network::SocketSharedPtr(Network::Address::InstanceConstSharedPtr address,
+                                        const Network::Socket::OptionsSharedPtr& options,
+                                        uint32_t worker_index));
   MOCK_METHOD1(createDrainManager_, DrainManager*(envoy::api::v2::Listener::DrainType drain_type));
   MOCK_METHOD0(nextListenerTag, uint64_t());
 
@@ -294,7 +303,7 @@ public:
   ~MockWorkerFactory() override;
 
   // Server::WorkerFactory
-  WorkerPtr createWorker(OverloadManager&, const std::string&) override {
+  WorkerPtr createWorker(uint32_t, OverloadManager&, const std::string&) override {
     return WorkerPtr{createWorker_()};
   }
 
@@ -434,6 +443,7 @@ public:
   MOCK_METHOD0(httpTracer, Tracing::HttpTracer&());
   MOCK_METHOD0(statsSinks, std::list<Stats::SinkPtr>&());
   MOCK_CONST_METHOD0(statsFlushInterval, std::chrono::milliseconds());
+  MOCK_CONST_METHOD0(statsFlushChangedOnly, bool());
   MOCK_CONST_METHOD0(wdMissTimeout, std::chrono::milliseconds());
   MOCK_CONST_METHOD0(wdMegaMissTimeout, std::chrono::milliseconds());
   MOCK_CONST_METHOD0(wdKillTimeout, std::chrono::milliseconds());
@@ -80,6 +80,7 @@ public:
   MOCK_CONST_METHOD0(certificateValidationContext, const CertificateValidationContextConfig*());
   MOCK_CONST_METHOD0(minProtocolVersion, unsigned());
   MOCK_CONST_METHOD0(maxProtocolVersion, unsigned());
+  MOCK_CONST_METHOD0(kernelTlsTxOffload, bool());
   MOCK_CONST_METHOD0(isReady, bool());
   MOCK_METHOD1(setSecretUpdateCallback, void(std::function<void()> callback));
 
@@ -102,6 +103,7 @@ public:
   MOCK_CONST_METHOD0(certificateValidationContext, const CertificateValidationContextConfig*());
   MOCK_CONST_METHOD0(minProtocolVersion, unsigned());
   MOCK_CONST_METHOD0(maxProtocolVersion, unsigned());
+  MOCK_CONST_METHOD0(kernelTlsTxOffload, bool());
   MOCK_CONST_METHOD0(isReady, bool());
   MOCK_METHOD1(setSecretUpdateCallback, void(std::function<void()> callback));
 
@@ -73,6 +73,7 @@ public:
   MOCK_CONST_METHOD0(addedViaApi, bool());
   MOCK_CONST_METHOD0(connectTimeout, std::chrono::milliseconds());
   MOCK_CONST_METHOD0(idleTimeout, const absl::optional<std::chrono::milliseconds>());
+  MOCK_CONST_METHOD0(maxHttp2ConnectionsPerHost, const absl::optional<uint32_t>());
   MOCK_CONST_METHOD0(perConnectionBufferLimitBytes, uint32_t());
   MOCK_CONST_METHOD0(features, uint64_t());
   MOCK_CONST_METHOD0(http2Settings, const Http::Http2Settings&());
@@ -89,11 +90,15 @@ public:
                      const absl::optional<envoy::api::v2::Cluster::LeastRequestLbConfig>&());
   MOCK_CONST_METHOD0(lbOriginalDstConfig,
                      const absl::optional<envoy::api::v2::Cluster::OriginalDstLbConfig>&());
+  MOCK_CONST_METHOD0(lbPeakEwmaConfig,
+                     const absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig>&());
   MOCK_CONST_METHOD0(maintenanceMode, bool());
   MOCK_CONST_METHOD0(maxRequestsPerConnection, uint64_t());
   MOCK_CONST_METHOD0(name, const std::string&());
   MOCK_CONST_METHOD1(resourceManager, ResourceManager&(ResourcePriority priority));
   MOCK_CONST_METHOD0(transportSocketFactory, Network::TransportSocketFactory&());
+  MOCK_CONST_METHOD0(spareConnectionsPerHost, uint32_t());
+  MOCK_CONST_METHOD0(poolWarming, envoy::api::v2::Cluster::PoolWarming());
   MOCK_CONST_METHOD0(stats, ClusterStats&());
   MOCK_CONST_METHOD0(statsScope, Stats::Scope&());
   MOCK_CONST_METHOD0(loadReportStats, ClusterLoadReportStats&());
@@ -127,6 +132,7 @@ public:
   NiceMock<MockLoadBalancerSubsetInfo> lb_subset_;
   absl::optional<envoy::api::v2::Cluster::RingHashLbConfig> lb_ring_hash_config_;
   absl::optional<envoy::api::v2::Cluster::OriginalDstLbConfig> lb_original_dst_config_;
+  absl::optional<envoy::api::v2::Cluster::PeakEwmaLbConfig> lb_peak_ewma_config_;
   Network::ConnectionSocket::OptionsSharedPtr cluster_socket_options_;
   envoy::api::v2::Cluster::CommonLbConfig lb_config_;
   envoy::api::v2::core::Metadata metadata_;
@@ -30,6 +30,9 @@ MockDetector::~MockDetector() = default;
 MockHealthCheckHostMonitor::MockHealthCheckHostMonitor() = default;
 MockHealthCheckHostMonitor::~MockHealthCheckHostMonitor() = default;
 
+MockLatencyHostMonitor::MockLatencyHostMonitor() = default;
+MockLatencyHostMonitor::~MockLatencyHostMonitor() = default;
+
 MockHostDescription::MockHostDescription()
     : address_(Network::Utility::resolveUrl("tcp://10.0.0.1:443")) {
   ON_CALL(*this, hostname()).WillByDefault(ReturnRef(hostname_));
@@ -38,6 +41,7 @@ MockHostDescription::MockHostDescription()
   ON_CALL(*this, stats()).WillByDefault(ReturnRef(stats_));
   ON_CALL(*this, cluster()).WillByDefault(ReturnRef(cluster_));
   ON_CALL(*this, healthChecker()).WillByDefault(ReturnRef(health_checker_));
+  ON_CALL(*this, latencyMonitor()).WillByDefault(ReturnRef(latency_monitor_));
 }
 
 MockHostDescription::~MockHostDescription() = default;
@@ -45,6 +49,7 @@ MockHostDescription::~MockHostDescription() = default;
 MockHost::MockHost() {
   ON_CALL(*this, cluster()).WillByDefault(ReturnRef(cluster_));
   ON_CALL(*this, outlierDetector()).WillByDefault(ReturnRef(outlier_detector_));
+  ON_CALL(*this, latencyMonitor()).WillByDefault(ReturnRef(latency_monitor_));
   ON_CALL(*this, stats()).WillByDefault(ReturnRef(stats_));
   ON_CALL(*this, warmed()).WillByDefault(Return(true));
 }
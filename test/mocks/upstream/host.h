@@ -75,6 +75,16 @@ public:
   MOCK_METHOD0(setUnhealthy, void());
 };
 
+class MockLatencyHostMonitor : public LatencyHostMonitor {
+public:
+  MockLatencyHostMonitor();
+  ~MockLatencyHostMonitor() override;
+
+  MOCK_METHOD2(putResponseTime, void(std::chrono::microseconds response_time, MonotonicTime now));
+  MOCK_METHOD2(putFailure, void(std::chrono::microseconds elapsed, MonotonicTime now));
+  MOCK_METHOD1(latencyEstimate, double(MonotonicTime now));
+};
+
 class MockHostDescription : public HostDescription {
 public:
   MockHostDescription();
@@ -89,6 +99,7 @@ public:
   MOCK_CONST_METHOD0(cluster, const ClusterInfo&());
   MOCK_CONST_METHOD0(outlierDetector, Outlier::DetectorHostMonitor&());
   MOCK_CONST_METHOD0(healthChecker, HealthCheckHostMonitor&());
+  MOCK_CONST_METHOD0(latencyMonitor, LatencyHostMonitor&());
   MOCK_CONST_METHOD0(hostname, const std::string&());
   MOCK_CONST_METHOD0(stats, HostStats&());
   MOCK_CONST_METHOD0(locality, const envoy::api::v2::core::Locality&());
@@ -105,6 +116,7 @@ public:
   Network::Address::InstanceConstSharedPtr address_;
   testing::NiceMock<Outlier::MockDetectorHostMonitor> outlier_detector_;
   testing::NiceMock<MockHealthCheckHostMonitor> health_checker_;
+  testing::NiceMock<MockLatencyHostMonitor> latency_monitor_;
   testing::NiceMock<MockClusterInfo> cluster_;
   testing::NiceMock<Stats::MockIsolatedStatsStore> stats_store_;
   HostStats stats_{ALL_HOST_STATS(POOL_COUNTER(stats_store_), POOL_GAUGE(stats_store_))};
@@ -169,6 +181,7 @@ public:
   MOCK_METHOD1(setActiveHealthFailureType, void(ActiveHealthFailureType type));
   MOCK_CONST_METHOD0(health, Host::Health());
   MOCK_CONST_METHOD0(hostname, const std::string&());
+  MOCK_CONST_METHOD0(latencyMonitor, LatencyHostMonitor&());
   MOCK_CONST_METHOD0(outlierDetector, Outlier::DetectorHostMonitor&());
   MOCK_METHOD1(setHealthChecker_, void(HealthCheckHostMonitorPtr& health_checker));
   MOCK_METHOD1(setOutlierDetector_, void(Outlier::DetectorHostMonitorPtr& outlier_detector));
@@ -184,6 +197,7 @@ public:
 
   testing::NiceMock<MockClusterInfo> cluster_;
   testing::NiceMock<Outlier::MockDetectorHostMonitor> outlier_detector_;
+  testing::NiceMock<MockLatencyHostMonitor> latency_monitor_;
   NiceMock<Stats::MockIsolatedStatsStore> stats_store_;
   HostStats stats_{ALL_HOST_STATS(POOL_COUNTER(stats_store_), POOL_GAUGE(stats_store_))};
   mutable Stats::TestSymbolTable symbol_table_;
@@ -72,12 +72,14 @@ TEST_F(ConfigurationImplTest, DefaultStatsFlushInterval) {
   config.initialize(bootstrap, server_, cluster_manager_factory_);
 
   EXPECT_EQ(std::chrono::milliseconds(5000), config.statsFlushInterval());
+  EXPECT_FALSE(config.statsFlushChangedOnly());
 }
 
 TEST_F(ConfigurationImplTest, CustomStatsFlushInterval) {
   std::string json = R"EOF(
   {
     "stats_flush_interval": "0.500s",
+    "stats_flush_changed_only": true,
 
     "admin": {
       "access_log_path": "/dev/null",
@@ -97,6 +99,7 @@ TEST_F(ConfigurationImplTest, CustomStatsFlushInterval) {
   config.initialize(bootstrap, server_, cluster_manager_factory_);
 
   EXPECT_EQ(std::chrono::milliseconds(500), config.statsFlushInterval());
+  EXPECT_TRUE(config.statsFlushChangedOnly());
 }
 
 TEST_F(ConfigurationImplTest, SetUpstreamClusterPerConnectionBufferLimit) {
@@ -3,6 +3,7 @@
 
 #include "common/common/utility.h"
 #include "common/network/address_impl.h"
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/io_socket_handle_impl.h"
 #include "common/network/raw_buffer_socket.h"
 #include "common/network/utility.h"
@@ -23,6 +24,7 @@ using testing::HasSubstr;
 using testing::InSequence;
 using testing::Invoke;
 using testing::NiceMock;
+using testing::Ref;
 using testing::Return;
 using testing::ReturnRef;
 
@@ -32,7 +34,7 @@ namespace {
 class ConnectionHandlerTest : public testing::Test, protected Logger::Loggable<Logger::Id::main> {
 public:
   ConnectionHandlerTest()
-      : handler_(new ConnectionHandlerImpl(dispatcher_, "test")),
+      : handler_(new ConnectionHandlerImpl(dispatcher_, "test", 0)),
         filter_chain_(Network::Test::createEmptyFilterChainWithRawBufferSockets()) {}
 
   class TestListener : public Network::ListenerConfig, public LinkedObject<TestListener> {
@@ -60,6 +62,9 @@ public:
     Network::FilterChainFactory& filterChainFactory() override { return parent_.factory_; }
     Network::Socket& socket() override { return socket_; }
     const Network::Socket& socket() const override { return socket_; }
+    Network::Socket& listenSocket(uint32_t worker_index) override {
+      return worker_index == 0 ? socket_ : worker_socket_;
+    }
     bool bindToPort() override { return bind_to_port_; }
     bool handOffRestoredDestinationConnections() const override {
       return hand_off_restored_destination_connections_;
@@ -77,9 +82,13 @@ public:
     const Network::ActiveUdpListenerFactory* udpListenerFactory() override {
       return udp_listener_factory_.get();
     }
+    Network::ConnectionBalancer& connectionBalancer() override {
+      return *parent_.connection_balancer_;
+    }
 
     ConnectionHandlerTest& parent_;
     Network::MockListenSocket socket_;
+    Network::MockListenSocket worker_socket_;
     uint64_t tag_;
     bool bind_to_port_;
     const bool hand_off_restored_destination_connections_;
@@ -106,6 +115,9 @@ public:
 
   Stats::IsolatedStoreImpl stats_store_;
   NiceMock<Event::MockDispatcher> dispatcher_;
+  // Shared by all test listeners. It must outlive the handlers, which unregister from it.
+  Network::ConnectionBalancerPtr connection_balancer_{
+      std::make_unique<Network::NopConnectionBalancerImpl>()};
   Network::ConnectionHandlerPtr handler_;
   NiceMock<Network::MockFilterChainManager> manager_;
   NiceMock<Network::MockFilterChainFactory> factory_;
@@ -151,6 +163,79 @@ TEST_F(ConnectionHandlerTest, RemoveListener) {
   handler_->removeListeners(0);
 }
 
+TEST_F(ConnectionHandlerTest, ListenOnWorkerSocket) {
+  InSequence s;
+
+  ConnectionHandlerImpl worker_handler(dispatcher_, "worker_1", 1);
+  Network::MockListener* listener = new NiceMock<Network::MockListener>();
+  TestListener* test_listener = addListener(1, true, false, "test_listener");
+  EXPECT_CALL(dispatcher_, createListener_(Ref(test_listener->worker_socket_), _, true, false))
+      .WillOnce(Return(listener));
+  EXPECT_CALL(test_listener->socket_, localAddress());
+  worker_handler.addListener(*test_listener);
+
+  EXPECT_CALL(*listener, onDestroy());
+}
+
+// With exact connection balancing, a socket accepted by a worker that owns more connections than
+// another worker is posted to the least loaded one.
+TEST_F(ConnectionHandlerTest, ExactBalancePostsToLeastLoadedWorker) {
+  connection_balancer_ = std::make_unique<Network::ExactConnectionBalancerImpl>();
+  NiceMock<Event::MockDispatcher> worker_dispatcher;
+  ConnectionHandlerImpl worker_handler(worker_dispatcher, "worker_1", 1);
+
+  Network::MockListener* listener = new NiceMock<Network::MockListener>();
+  Network::ListenerCallbacks* listener_callbacks;
+  TestListener* test_listener = addListener(1, true, false, "test_listener");
+  EXPECT_CALL(dispatcher_, createListener_(_, _, _, _))
+      .WillOnce(Invoke(
+          [&](Network::Socket&, Network::ListenerCallbacks& cb, bool, bool) -> Network::Listener* {
+            listener_callbacks = &cb;
+            return listener;
+          }));
+  EXPECT_CALL(test_listener->socket_, localAddress());
+  handler_->addListener(*test_listener);
+
+  Network::MockListener* worker_listener = new NiceMock<Network::MockListener>();
+  EXPECT_CALL(test_listener->socket_, socketType())
+      .WillOnce(Return(Network::Address::SocketType::Stream))
+      .RetiresOnSaturation();
+  EXPECT_CALL(worker_dispatcher, createListener_(_, _, _, _)).WillOnce(Return(worker_listener));
+  EXPECT_CALL(test_listener->socket_, localAddress());
+  worker_handler.addListener(*test_listener);
+
+  // The first worker already owns a long lived connection.
+  listener_callbacks->onNewConnection(
+      Network::ConnectionPtr{new NiceMock<Network::MockConnection>()});
+  EXPECT_EQ(1UL, handler_->numConnections());
+
+  // The next socket it accepts is handed over to the idle worker.
+  EXPECT_CALL(dispatcher_, post(_)).Times(0);
+  EXPECT_CALL(worker_dispatcher, post(_));
+  EXPECT_CALL(manager_, findFilterChain(_)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(worker_dispatcher, createServerConnection_(_, _))
+      .WillOnce(Return(new NiceMock<Network::MockConnection>()));
+  EXPECT_CALL(factory_, createNetworkFilterChain(_, _)).WillOnce(Return(true));
+  listener_callbacks->onAccept(
+      Network::ConnectionSocketPtr{new NiceMock<Network::MockConnectionSocket>()}, true);
+  EXPECT_EQ(1UL, handler_->numConnections());
+  EXPECT_EQ(1UL, worker_handler.numConnections());
+
+  // Once the load is even the accepting worker keeps the socket.
+  EXPECT_CALL(worker_dispatcher, post(_)).Times(0);
+  EXPECT_CALL(manager_, findFilterChain(_)).WillOnce(Return(filter_chain_.get()));
+  EXPECT_CALL(dispatcher_, createServerConnection_(_, _))
+      .WillOnce(Return(new NiceMock<Network::MockConnection>()));
+  EXPECT_CALL(factory_, createNetworkFilterChain(_, _)).WillOnce(Return(true));
+  listener_callbacks->onAccept(
+      Network::ConnectionSocketPtr{new NiceMock<Network::MockConnectionSocket>()}, true);
+  EXPECT_EQ(2UL, handler_->numConnections());
+  EXPECT_EQ(1UL, worker_handler.numConnections());
+
+  EXPECT_CALL(*worker_listener, onDestroy());
+  EXPECT_CALL(*listener, onDestroy());
+}
+
 TEST_F(ConnectionHandlerTest, DisableListener) {
   InSequence s;
 
@@ -1,11 +1,16 @@
 #include <memory>
 
+#include "common/network/io_socket_handle_impl.h"
+#include "common/network/utility.h"
+
 #include "server/hot_restarting_parent.h"
 
+#include "test/mocks/network/mocks.h"
 #include "test/mocks/server/mocks.h"
 
 #include "gtest/gtest.h"
 
+using testing::NiceMock;
 using testing::Return;
 using testing::ReturnRef;
 
@@ -40,6 +45,39 @@ TEST_F(HotRestartingParentTest, getListenSocketsForChildNotFound) {
   EXPECT_EQ(-1, message.reply().pass_listen_socket().fd());
 }
 
+TEST_F(HotRestartingParentTest, getListenSocketsForChildUnknownWorker) {
+  server_.options_.concurrency_ = 2;
+  EXPECT_CALL(server_, listenerManager()).Times(0);
+
+  HotRestartMessage::Request request;
+  request.mutable_pass_listen_socket()->set_address("tcp://127.0.0.1:80");
+  request.mutable_pass_listen_socket()->set_worker_index(2);
+  HotRestartMessage message = hot_restarting_parent_.getListenSocketsForChild(request);
+  EXPECT_EQ(-1, message.reply().pass_listen_socket().fd());
+}
+
+TEST_F(HotRestartingParentTest, getListenSocketsForChildWorkerSocket) {
+  server_.options_.concurrency_ = 2;
+  MockListenerManager listener_manager;
+  NiceMock<Network::MockListenerConfig> listener_config;
+  NiceMock<Network::MockListenSocket> worker_socket;
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> listeners;
+  listeners.push_back(listener_config);
+  EXPECT_CALL(server_, listenerManager()).WillOnce(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, listeners()).WillOnce(Return(listeners));
+  listener_config.socket_.local_address_ =
+      Network::Utility::parseInternetAddressAndPort("127.0.0.1:80");
+  worker_socket.io_handle_ =
+      std::make_unique<Network::IoSocketHandleImpl>(::socket(AF_INET, SOCK_STREAM, 0));
+  EXPECT_CALL(listener_config, listenSocket(1)).WillOnce(ReturnRef(worker_socket));
+
+  HotRestartMessage::Request request;
+  request.mutable_pass_listen_socket()->set_address("tcp://127.0.0.1:80");
+  request.mutable_pass_listen_socket()->set_worker_index(1);
+  HotRestartMessage message = hot_restarting_parent_.getListenSocketsForChild(request);
+  EXPECT_EQ(worker_socket.io_handle_->fd(), message.reply().pass_listen_socket().fd());
+}
+
 TEST_F(HotRestartingParentTest, exportStatsToChild) {
   Stats::IsolatedStoreImpl store;
   MockListenerManager listener_manager;
@@ -31,6 +31,7 @@
 #include "test/test_common/utility.h"
 
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -592,6 +593,120 @@ TEST_P(AdminFilterTest, Trailers) {
   EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_.decodeTrailers(request_headers_));
 }
 
+class AdminFilterStreamingTest : public AdminFilterTest {
+public:
+  AdminFilterStreamingTest() {
+    ON_CALL(callbacks_.dispatcher_, post(_)).WillByDefault(Invoke([this](Event::PostCb cb) {
+      posted_.push_back(cb);
+    }));
+    ON_CALL(callbacks_, encodeData(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool end_stream) {
+          body_ += data.toString();
+          end_stream_ = end_stream;
+        }));
+  }
+
+  void addCounters(uint32_t num_counters) {
+    for (uint32_t i = 0; i < num_counters; ++i) {
+      server_.stats_store_.counter(absl::StrCat("streamed.c", i)).inc();
+    }
+  }
+
+  void runPosted() {
+    std::vector<Event::PostCb> posted;
+    posted.swap(posted_);
+    for (const Event::PostCb& cb : posted) {
+      cb();
+    }
+  }
+
+  std::vector<Event::PostCb> posted_;
+  std::string body_;
+  bool end_stream_{};
+};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, AdminFilterStreamingTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+TEST_P(AdminFilterStreamingTest, PrometheusStats) {
+  // More metrics than fit in one chunk of the response.
+  addCounters(2500);
+  Http::TestHeaderMapImpl request_headers{{":path", "/stats/prometheus?filter=streamed"}};
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, false));
+  filter_.decodeHeaders(request_headers, true);
+
+  // The first chunk is sent with the headers, and the rest from the dispatcher.
+  EXPECT_FALSE(end_stream_);
+  EXPECT_EQ(1, posted_.size());
+  EXPECT_EQ(1, callbacks_.callbacks_.size());
+  uint32_t chunks = 1;
+  while (!posted_.empty()) {
+    runPosted();
+    ++chunks;
+  }
+  EXPECT_EQ(3, chunks);
+  EXPECT_TRUE(end_stream_);
+  EXPECT_TRUE(callbacks_.callbacks_.empty());
+
+  // A TYPE line and a value line for each counter.
+  EXPECT_EQ(5000, std::count(body_.begin(), body_.end(), '\n'));
+  EXPECT_THAT(body_, HasSubstr("# TYPE envoy_streamed_c0 counter\nenvoy_streamed_c0{} 1\n"));
+  EXPECT_THAT(body_, HasSubstr("envoy_streamed_c2499{} 1\n"));
+}
+
+TEST_P(AdminFilterStreamingTest, PrometheusStatsSmallResponse) {
+  addCounters(10);
+  Http::TestHeaderMapImpl request_headers{{":path", "/stats/prometheus?filter=streamed.c1$"}};
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, false));
+  EXPECT_CALL(callbacks_, encodeData(_, true));
+  filter_.decodeHeaders(request_headers, true);
+
+  // A response that fits in one chunk is not streamed.
+  EXPECT_TRUE(posted_.empty());
+  EXPECT_TRUE(callbacks_.callbacks_.empty());
+  EXPECT_EQ("# TYPE envoy_streamed_c1 counter\nenvoy_streamed_c1{} 1\n", body_);
+}
+
+TEST_P(AdminFilterStreamingTest, PrometheusStatsFlowControlAndReset) {
+  addCounters(2500);
+  Http::TestHeaderMapImpl request_headers{{":path", "/stats?format=prometheus"}};
+  filter_.decodeHeaders(request_headers, true);
+  ASSERT_EQ(1, posted_.size());
+  ASSERT_EQ(1, callbacks_.callbacks_.size());
+  Http::DownstreamWatermarkCallbacks& watermark_callbacks = *callbacks_.callbacks_.front();
+
+  // The chunk already scheduled is sent, but no more are scheduled while the downstream
+  // connection is above its high watermark.
+  watermark_callbacks.onAboveWriteBufferHighWatermark();
+  EXPECT_CALL(callbacks_, encodeData(_, false));
+  runPosted();
+  EXPECT_TRUE(posted_.empty());
+
+  watermark_callbacks.onBelowWriteBufferLowWatermark();
+  EXPECT_EQ(1, posted_.size());
+
+  // Nothing is sent once the stream has been reset.
+  filter_.onDestroy();
+  EXPECT_CALL(callbacks_, encodeData(_, _)).Times(0);
+  runPosted();
+  EXPECT_TRUE(posted_.empty());
+  EXPECT_FALSE(end_stream_);
+}
+
+// Admin::request() has no stream to stream the response on, so it gets all of it at once.
+TEST_P(AdminFilterStreamingTest, PrometheusStatsWithoutStream) {
+  addCounters(2500);
+  Http::HeaderMapImpl response_headers;
+  std::string body;
+  EXPECT_EQ(Http::Code::OK,
+            admin_.request("/stats/prometheus?filter=streamed", "GET", response_headers, body));
+  EXPECT_TRUE(posted_.empty());
+  EXPECT_EQ(5000, std::count(body.begin(), body.end(), '\n'));
+  EXPECT_THAT(body, HasSubstr("# TYPE envoy_streamed_c0 counter\nenvoy_streamed_c0{} 1\n"));
+  EXPECT_THAT(body, HasSubstr("envoy_streamed_c2499{} 1\n"));
+}
+
 class AdminInstanceTest : public testing::TestWithParam<Network::Address::IpVersion> {
 public:
   AdminInstanceTest()
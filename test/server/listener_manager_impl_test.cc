@@ -12,6 +12,7 @@
 #include "common/api/os_sys_calls_impl.h"
 #include "common/config/metadata.h"
 #include "common/network/address_impl.h"
+#include "common/network/connection_balancer_impl.h"
 #include "common/network/io_socket_handle_impl.h"
 #include "common/network/utility.h"
 #include "common/protobuf/protobuf.h"
@@ -456,6 +457,114 @@ drain_type: modify_only
   EXPECT_CALL(*listener_foo, onDestroy());
 }
 
+TEST_F(ListenerManagerImplTest, ReusePortListenerCreatesWorkerSockets) {
+  InSequence s;
+  server_.options_.concurrency_ = 3;
+
+  const std::string listener_foo_yaml = R"EOF(
+name: foo
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 0
+filter_chains:
+- filters: []
+reuse_port: true
+  )EOF";
+
+  // The worker sockets must be bound to the port resolved by the socket of the first worker.
+  Network::Address::InstanceConstSharedPtr resolved_address =
+      Network::Utility::parseInternetAddress("127.0.0.1", 1234);
+  ON_CALL(*listener_factory_.socket_, localAddress()).WillByDefault(ReturnRef(resolved_address));
+  auto worker_socket_1 = std::make_shared<NiceMock<Network::MockListenSocket>>();
+  auto worker_socket_2 = std::make_shared<NiceMock<Network::MockListenSocket>>();
+
+  ListenerHandle* listener_foo = expectListenerCreate(false, true);
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, true));
+  EXPECT_CALL(listener_factory_, createWorkerListenSocket(_, _, 1))
+      .WillOnce(Invoke([&](Network::Address::InstanceConstSharedPtr address,
+                           const Network::Socket::OptionsSharedPtr& options,
+                           uint32_t) -> Network::SocketSharedPtr {
+        EXPECT_EQ("127.0.0.1:1234", address->asString());
+        EXPECT_NE(nullptr, options);
+        return worker_socket_1;
+      }));
+  EXPECT_CALL(listener_factory_, createWorkerListenSocket(_, _, 2))
+      .WillOnce(Return(worker_socket_2));
+  EXPECT_TRUE(manager_->addOrUpdateListener(parseListenerFromV2Yaml(listener_foo_yaml), "", true));
+  checkStats(1, 0, 0, 0, 1, 0);
+
+  Network::ListenerConfig& listener = manager_->listeners().back().get();
+  EXPECT_EQ(listener_factory_.socket_.get(), &listener.listenSocket(0));
+  EXPECT_EQ(worker_socket_1.get(), &listener.listenSocket(1));
+  EXPECT_EQ(worker_socket_2.get(), &listener.listenSocket(2));
+
+  // Updating the listener hands the worker sockets over to the new listener.
+  const std::string listener_foo_update_yaml = R"EOF(
+name: foo
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 0
+filter_chains:
+- filters: []
+reuse_port: true
+per_connection_buffer_limit_bytes: 10
+  )EOF";
+
+  ListenerHandle* listener_foo_update = expectListenerCreate(false, true);
+  EXPECT_CALL(listener_factory_, createWorkerListenSocket(_, _, _)).Times(0);
+  EXPECT_CALL(*listener_foo, onDestroy());
+  EXPECT_TRUE(
+      manager_->addOrUpdateListener(parseListenerFromV2Yaml(listener_foo_update_yaml), "", true));
+  checkStats(1, 1, 0, 0, 1, 0);
+
+  Network::ListenerConfig& updated_listener = manager_->listeners().back().get();
+  EXPECT_EQ(worker_socket_1.get(), &updated_listener.listenSocket(1));
+  EXPECT_EQ(worker_socket_2.get(), &updated_listener.listenSocket(2));
+
+  EXPECT_CALL(*listener_foo_update, onDestroy());
+}
+
+TEST_F(ListenerManagerImplTest, ReusePortCannotBeChangedOnUpdate) {
+  InSequence s;
+
+  const std::string listener_foo_yaml = R"EOF(
+name: foo
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 1234
+filter_chains:
+- filters: []
+  )EOF";
+
+  ListenerHandle* listener_foo = expectListenerCreate(false, true);
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, true));
+  EXPECT_TRUE(manager_->addOrUpdateListener(parseListenerFromV2Yaml(listener_foo_yaml), "", true));
+
+  const std::string listener_foo_reuse_port_yaml = R"EOF(
+name: foo
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 1234
+filter_chains:
+- filters: []
+reuse_port: true
+  )EOF";
+
+  ListenerHandle* listener_foo_reuse_port = expectListenerCreate(false, true);
+  EXPECT_CALL(*listener_foo_reuse_port, onDestroy());
+  EXPECT_THROW_WITH_MESSAGE(
+      manager_->addOrUpdateListener(parseListenerFromV2Yaml(listener_foo_reuse_port_yaml), "",
+                                    true),
+      EnvoyException,
+      "error updating listener: 'foo' has a different reuse_port value from existing listener");
+
+  EXPECT_CALL(*listener_foo, onDestroy());
+}
+
 // Make sure that a listener creation does not fail on IPv4 only setups when FilterChainMatch is not
 // specified and we try to create default CidrRange. See makeCidrListEntry function for
 // more details.
@@ -2777,6 +2886,96 @@ TEST_F(ListenerManagerImplWithRealFiltersTest, LiteralSockoptListenerEnabled) {
   EXPECT_EQ(1U, manager_->listeners().size());
 }
 
+// Validate that when reuse_port is set in the Listener, we see the socket option
+// propagated to setsockopt().
+TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortListenerEnabled) {
+  auto listener = createIPv4Listener("ReusePortListener");
+  listener.set_reuse_port(true);
+
+  testSocketOption(listener, envoy::api::v2::core::SocketOption::STATE_PREBIND,
+                   ENVOY_SOCKET_SO_REUSEPORT, /* expected_value */ 1);
+}
+
+TEST_F(ListenerManagerImplWithRealFiltersTest, ReusePortUdpListener) {
+  const std::string yaml = R"EOF(
+address:
+  socket_address:
+    address: 127.0.0.1
+    protocol: UDP
+    port_value: 1234
+filter_chains:
+- filters: []
+reuse_port: true
+  )EOF";
+
+  EXPECT_CALL(server_.random_, uuid());
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _)).Times(0);
+  EXPECT_THROW_WITH_MESSAGE(
+      manager_->addOrUpdateListener(parseListenerFromV2Yaml(yaml), "", true), EnvoyException,
+      "error adding listener '127.0.0.1:1234': reuse_port is only supported for TCP listeners");
+  EXPECT_EQ(0U, manager_->listeners().size());
+}
+
+TEST_F(ListenerManagerImplWithRealFiltersTest, ConnectionBalanceConfig) {
+  const std::string yaml = R"EOF(
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 1234
+filter_chains:
+- filters: []
+connection_balance_config:
+  exact_balance: {}
+  )EOF";
+
+  EXPECT_CALL(server_.random_, uuid());
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, true));
+  manager_->addOrUpdateListener(parseListenerFromV2Yaml(yaml), "", true);
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_NE(nullptr, dynamic_cast<Network::ExactConnectionBalancerImpl*>(
+                         &manager_->listeners().front().get().connectionBalancer()));
+}
+
+TEST_F(ListenerManagerImplWithRealFiltersTest, NoConnectionBalanceConfig) {
+  const std::string yaml = R"EOF(
+address:
+  socket_address:
+    address: 127.0.0.1
+    port_value: 1234
+filter_chains:
+- filters: []
+  )EOF";
+
+  EXPECT_CALL(server_.random_, uuid());
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, true));
+  manager_->addOrUpdateListener(parseListenerFromV2Yaml(yaml), "", true);
+  EXPECT_EQ(1U, manager_->listeners().size());
+  EXPECT_NE(nullptr, dynamic_cast<Network::NopConnectionBalancerImpl*>(
+                         &manager_->listeners().front().get().connectionBalancer()));
+}
+
+TEST_F(ListenerManagerImplWithRealFiltersTest, ConnectionBalanceConfigUdpListener) {
+  const std::string yaml = R"EOF(
+address:
+  socket_address:
+    address: 127.0.0.1
+    protocol: UDP
+    port_value: 1234
+filter_chains:
+- filters: []
+connection_balance_config:
+  exact_balance: {}
+  )EOF";
+
+  EXPECT_CALL(server_.random_, uuid());
+  EXPECT_CALL(listener_factory_, createListenSocket(_, _, _, _)).Times(0);
+  EXPECT_THROW_WITH_MESSAGE(manager_->addOrUpdateListener(parseListenerFromV2Yaml(yaml), "", true),
+                            EnvoyException,
+                            "error adding listener '127.0.0.1:1234': connection balancing is only "
+                            "supported for TCP listeners");
+  EXPECT_EQ(0U, manager_->listeners().size());
+}
+
 // Set the resolver to the default IP resolver. The address resolver logic is unit tested in
 // resolver_impl_test.cc.
 TEST_F(ListenerManagerImplWithRealFiltersTest, AddressResolver) {
@@ -75,7 +75,8 @@ TEST_F(OptionsImplTest, All) {
       "--file-flush-interval-msec 9000 "
       "--drain-time-s 60 --log-format [%v] --parent-shutdown-time-s 90 --log-path /foo/bar "
       "--disable-hot-restart --cpuset-threads --allow-unknown-static-fields "
-      "--reject-unknown-dynamic-fields");
+      "--reject-unknown-dynamic-fields --stats-counter-shards 8 --use-fake-symbol-table false "
+      "--stats-symbol-table-shards 4 --stats-lock-free-histograms");
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ(2U, options->concurrency());
   EXPECT_EQ("hello", options->configPath());
@@ -97,7 +98,10 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_TRUE(options->cpusetThreadsEnabled());
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
-  EXPECT_TRUE(options->fakeSymbolTableEnabled());
+  EXPECT_FALSE(options->fakeSymbolTableEnabled());
+  EXPECT_EQ(8U, options->statsCounterShards());
+  EXPECT_EQ(4U, options->statsSymbolTableShards());
+  EXPECT_TRUE(options->statsLockFreeHistograms());
 
   options = createOptionsImpl("envoy --mode init_only");
   EXPECT_EQ(Server::Mode::InitOnly, options->mode());
@@ -156,6 +160,9 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setAllowUnkownFields(true);
   options->setRejectUnknownFieldsDynamic(true);
   options->setFakeSymbolTableEnabled(!options->fakeSymbolTableEnabled());
+  options->setStatsCounterShards(16);
+  options->setStatsSymbolTableShards(32);
+  options->setStatsLockFreeHistograms(true);
 
   EXPECT_EQ(109876, options->baseId());
   EXPECT_EQ(42U, options->concurrency());
@@ -183,6 +190,9 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_TRUE(options->allowUnknownStaticFields());
   EXPECT_TRUE(options->rejectUnknownDynamicFields());
   EXPECT_EQ(!fake_symbol_table_enabled, options->fakeSymbolTableEnabled());
+  EXPECT_EQ(16U, options->statsCounterShards());
+  EXPECT_EQ(32U, options->statsSymbolTableShards());
+  EXPECT_TRUE(options->statsLockFreeHistograms());
 
   // Validate that CommandLineOptions is constructed correctly.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -210,6 +220,11 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->hotRestartDisabled(), command_line_options->disable_hot_restart());
   EXPECT_EQ(options->mutexTracingEnabled(), command_line_options->enable_mutex_tracing());
   EXPECT_EQ(options->cpusetThreadsEnabled(), command_line_options->cpuset_threads());
+  EXPECT_EQ(options->statsCounterShards(), command_line_options->stats_counter_shards());
+  EXPECT_EQ(options->statsSymbolTableShards(),
+            command_line_options->stats_symbol_table_shards());
+  EXPECT_EQ(options->statsLockFreeHistograms(),
+            command_line_options->stats_lock_free_histograms());
 }
 
 TEST_F(OptionsImplTest, DefaultParams) {
@@ -221,6 +236,9 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(Server::Mode::Serve, options->mode());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_EQ(0U, options->statsCounterShards());
+  EXPECT_EQ(1U, options->statsSymbolTableShards());
+  EXPECT_FALSE(options->statsLockFreeHistograms());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -259,6 +277,15 @@ TEST_F(OptionsImplTest, BadCliOption) {
                           MalformedArgvException, "error: unknown IP address version 'foo'");
 }
 
+TEST_F(OptionsImplTest, SymbolTableShardsWithFakeSymbolTable) {
+  EXPECT_THROW_WITH_REGEX(createOptionsImpl("envoy -c hello --stats-symbol-table-shards 4"),
+                          MalformedArgvException,
+                          "error: --stats-symbol-table-shards requires --use-fake-symbol-table "
+                          "false");
+  EXPECT_EQ(1U, createOptionsImpl("envoy -c hello --stats-symbol-table-shards 1")
+                    ->statsSymbolTableShards());
+}
+
 TEST_F(OptionsImplTest, ParseComponentLogLevels) {
   std::unique_ptr<OptionsImpl> options = createOptionsImpl("envoy --mode init_only");
   options->parseComponentLogLevels("upstream:debug,connection:trace");
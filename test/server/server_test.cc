@@ -5,6 +5,7 @@
 #include "common/network/address_impl.h"
 #include "common/network/listen_socket_impl.h"
 #include "common/network/socket_option_impl.h"
+#include "common/stats/histogram_impl.h"
 #include "common/thread_local/thread_local_impl.h"
 
 #include "server/process_context_impl.h"
@@ -27,6 +28,7 @@ using testing::InSequence;
 using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::Return;
+using testing::ReturnRef;
 using testing::SaveArg;
 using testing::StrictMock;
 
@@ -76,6 +78,77 @@ TEST(ServerInstanceUtil, flushHelper) {
   InstanceUtil::flushMetricsToSinks(sinks, mock_store);
 }
 
+TEST(ServerInstanceUtil, FlushChangedOnly) {
+  InSequence s;
+
+  Stats::IsolatedStoreImpl store;
+  Stats::Counter& c = store.counter("hello");
+  c.inc();
+  Stats::Gauge& g = store.gauge("world", Stats::Gauge::ImportMode::Accumulate);
+  g.set(5);
+  store.counter("idle");
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+
+  // The first flush includes all gauges, but only the counters that changed.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "hello");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "world");
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, true);
+
+  // Nothing changed, but all counters are still latched.
+  c.inc();
+  EXPECT_EQ(1, c.latch());
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, true);
+  EXPECT_EQ(0, c.latch());
+
+  // A gauge that is set to the same value has not changed.
+  g.set(5);
+  store.gauge("new", Stats::Gauge::ImportMode::Accumulate);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "new");
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, true);
+
+  g.set(6);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 6);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, true);
+
+  // Only histograms with values in the interval are flushed.
+  NiceMock<Stats::MockStore> mock_store;
+  auto* idle_histogram = new NiceMock<Stats::MockParentHistogram>();
+  auto* active_histogram = new NiceMock<Stats::MockParentHistogram>();
+  std::vector<Stats::ParentHistogramSharedPtr> parent_histograms = {
+      Stats::ParentHistogramSharedPtr(idle_histogram),
+      Stats::ParentHistogramSharedPtr(active_histogram)};
+  ON_CALL(mock_store, histograms).WillByDefault(Return(parent_histograms));
+  histogram_t* samples = hist_alloc();
+  hist_insert_intscale(samples, 1, 0, 1);
+  Stats::HistogramStatisticsImpl active_statistics(samples);
+  hist_free(samples);
+  ON_CALL(*active_histogram, intervalStatistics()).WillByDefault(ReturnRef(active_statistics));
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([active_histogram](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.histograms().size(), 1);
+    EXPECT_EQ(&snapshot.histograms()[0].get(), active_histogram);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, mock_store, true);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {